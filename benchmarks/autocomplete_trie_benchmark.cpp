@@ -0,0 +1,40 @@
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  constexpr int kNumQueries = 100'000;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  report("AddBook with autocomplete tries", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      book_store.AddBook(make_book(index));
+    }
+  }), num_books);
+
+  long long num_suggested = 0;
+
+  // посимвольный набор префиксов, как в строке поиска
+  report("SuggestTitles, per keystroke", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      const std::string title = "Title #" + std::to_string(query * 7919 % 1000003);
+      num_suggested += static_cast<long long>(book_store.SuggestTitles(title.substr(0, 7 + query % 4), 10).size());
+    }
+  }), kNumQueries);
+
+  report("SuggestAuthors, per keystroke", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      const std::string full_name = "Author #" + std::to_string(query % 1000);
+      num_suggested += static_cast<long long>(book_store.SuggestAuthors(full_name.substr(0, 8 + query % 3), 10).size());
+    }
+  }), kNumQueries);
+
+  std::cout << "suggested: " << num_suggested << std::endl;
+  return 0;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "author.hpp"
+#include "book.hpp"
+
+namespace bench::utils {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Замер времени выполнения функции.
+ *
+ * @param func - замеряемая функция
+ * @return время выполнения в миллисекундах
+ */
+template <typename Func>
+inline auto measure_ms(Func &&func) -> double {
+  const auto start = Clock::now();
+  func();
+  const auto finish = Clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+/**
+ * Вывод результата замера в формате "name: time ms (ops/s)".
+ *
+ * @param name - название замера
+ * @param time_ms - время выполнения в миллисекундах
+ * @param num_ops - кол-во выполненных операций
+ */
+inline void report(const std::string &name, double time_ms, long long num_ops) {
+  const double ops_per_sec = time_ms > 0 ? num_ops / (time_ms / 1000.0) : 0.0;
+  std::cout << name << ": " << time_ms << " ms (" << static_cast<long long>(ops_per_sec) << " ops/s)" << std::endl;
+}
+
+/**
+ * Генерация синтетической книги с детерминированными полями.
+ *
+ * @param index - порядковый номер книги
+ * @return книга
+ */
+inline auto make_book(int index) -> Book {
+  const auto author = Author("Author #" + std::to_string(index % 1000), Author::kMinAuthorAge + index % 80,
+                             static_cast<Sex>(index % 3));
+
+  return Book("Title #" + std::to_string(index * 7919 % 1000003),
+              "Content of the book #" + std::to_string(index),
+              static_cast<Genre>(index % static_cast<int>(Genre::UNDEFINED)),
+              static_cast<Publisher>(index % static_cast<int>(Publisher::UNDEFINED)),
+              {author});
+}
+
+}  // namespace bench::utils
@@ -0,0 +1,56 @@
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  constexpr int kNumQueries = 1'000'000;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+  book_store.EnablePresenceFilters();
+
+  report("AddBook with bloom filters", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      book_store.AddBook(make_book(index));
+    }
+  }), num_books);
+
+  std::vector<std::string> absent_titles;
+  absent_titles.reserve(kNumQueries);
+  for (int query = 0; query < kNumQueries; query++) {
+    absent_titles.push_back("Missing title #" + std::to_string(query));
+  }
+
+  long long num_found = 0;
+
+  // существующие названия проверяются по индексу после положительного ответа фильтра
+  report("HasTitle, present", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      num_found += book_store.HasTitle(book_store.GetBooks()[query % num_books].GetTitle()) ? 1 : 0;
+    }
+  }), kNumQueries);
+
+  report("HasTitle, absent", measure_ms([&] {
+    for (const auto &title: absent_titles) {
+      num_found += book_store.HasTitle(title) ? 1 : 0;
+    }
+  }), kNumQueries);
+
+  // проверка без фильтра: поиск по индексу названий
+  report("FindBooksByTitleRange, absent", measure_ms([&] {
+    for (const auto &title: absent_titles) {
+      num_found += static_cast<long long>(book_store.FindBooksByTitleRange(title, title + '\0').size());
+    }
+  }), kNumQueries);
+
+  const BloomFilterStats stats = book_store.GetTitleFilterStats();
+
+  std::cout << "found: " << num_found << ", negative rate: " << stats.GetNegativeRate()
+            << ", false positive rate: " << stats.GetFalsePositiveRate() << std::endl;
+  return 0;
+}
@@ -0,0 +1,45 @@
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "book_aggregate.hpp"
+#include "book_store.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  constexpr int kNumReads = 1'000;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  report("AddBook with aggregates", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      book_store.AddBook(make_book(index));
+    }
+  }), num_books);
+
+  long long checksum = 0;
+
+  report("GetCatalogAggregate", measure_ms([&] {
+    for (int read = 0; read < kNumReads; read++) {
+      checksum += book_store.GetCatalogAggregate().GetCount(Genre::HORROR);
+    }
+  }), kNumReads);
+
+  // пересчет без инкрементальных агрегатов: полный проход по хранилищу
+  report("full rescan", measure_ms([&] {
+    for (int read = 0; read < kNumReads / 100; read++) {
+      CatalogAggregate aggregate;
+
+      for (int index = 0; index < book_store.GetNumSlots(); index++) {
+        aggregate.Add(book_store.GetBooks()[index]);
+      }
+
+      checksum += aggregate.GetCount(Genre::HORROR);
+    }
+  }), kNumReads / 100);
+
+  std::cout << "checksum: " << checksum << std::endl;
+  return 0;
+}
@@ -0,0 +1,46 @@
+#include <sstream>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "columnar_format.hpp"
+#include "write_ahead_log.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    book_store.AddBook(make_book(index));
+  }
+
+  std::stringstream stream;
+
+  report("export_columnar", measure_ms([&] {
+    export_columnar(book_store, stream);
+  }), num_books);
+
+  std::cout << "columnar bytes: " << stream.str().size() << std::endl;
+
+  auto restored = BookStore("Benchmark");
+
+  report("import_columnar", measure_ms([&] {
+    import_columnar(stream, restored);
+  }), num_books);
+
+  // построчная альтернатива: двоичные записи журнала предзаписи
+  std::string rows;
+
+  report("encode_book (row-wise)", measure_ms([&] {
+    for (int index = 0; index < book_store.GetNumSlots(); index++) {
+      encode_book(book_store.GetBooks()[index], rows);
+    }
+  }), num_books);
+
+  std::cout << "row-wise bytes: " << rows.size() << ", restored: " << restored.GetSize() << std::endl;
+  return 0;
+}
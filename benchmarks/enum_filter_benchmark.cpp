@@ -0,0 +1,71 @@
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_query.hpp"
+#include "book_store.hpp"
+#include "enum_filter.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  constexpr int kNumRepeats = 20;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    book_store.AddBook(make_book(index));
+  }
+
+  using Kernel = EnumFilterKernel<enum_mask_v<Genre::HORROR, Genre::THRILLER, Genre::FANTASY>,
+                                  enum_mask_v<Publisher::USA, Publisher::ENG>>;
+
+  long long num_found = 0;
+
+  report("EnumFilterKernel::Count", measure_ms([&] {
+    for (int repeat = 0; repeat < kNumRepeats; repeat++) {
+      num_found += Kernel::Count(book_store);
+    }
+  }), static_cast<long long>(kNumRepeats) * num_books);
+
+  report("EnumFilterKernel::Collect", measure_ms([&] {
+    for (int repeat = 0; repeat < kNumRepeats; repeat++) {
+      num_found += static_cast<long long>(Kernel::Collect(book_store).size());
+    }
+  }), static_cast<long long>(kNumRepeats) * num_books);
+
+  report("BookQuery (runtime masks)", measure_ms([&] {
+    for (int repeat = 0; repeat < kNumRepeats; repeat++) {
+      num_found += BookQuery(book_store)
+          .WhereGenreIn({Genre::HORROR, Genre::THRILLER, Genre::FANTASY})
+          .WherePublisherIn({Publisher::USA, Publisher::ENG})
+          .Count();
+    }
+  }), static_cast<long long>(kNumRepeats) * num_books);
+
+  report("BookQuery (interpreted predicates)", measure_ms([&] {
+    const std::vector<std::function<bool(const Book &)>> predicates = {
+        [](const Book &book) {
+          return book.GetGenre() == Genre::HORROR || book.GetGenre() == Genre::THRILLER
+              || book.GetGenre() == Genre::FANTASY;
+        },
+        [](const Book &book) {
+          return book.GetPublisher() == Publisher::USA || book.GetPublisher() == Publisher::ENG;
+        }};
+
+    for (int repeat = 0; repeat < kNumRepeats; repeat++) {
+      auto query = BookQuery(book_store);
+      for (const auto &predicate: predicates) {
+        query.Where(predicate, PredicateCost::CHEAP);
+      }
+      num_found += query.Count();
+    }
+  }), static_cast<long long>(kNumRepeats) * num_books);
+
+  std::cout << "found: " << num_found << std::endl;
+
+  return 0;
+}
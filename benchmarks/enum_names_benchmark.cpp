@@ -0,0 +1,83 @@
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "enum_names.hpp"
+
+using namespace bench::utils;
+
+namespace {
+
+// имя жанра в случайном регистре (детерминированно по номеру)
+std::string make_name(int index) {
+  std::string name(format_enum(static_cast<Genre>(index % (static_cast<int>(Genre::UNDEFINED) + 1))));
+
+  for (std::size_t position = 0; position < name.size(); position++) {
+    if ((index >> (position % 16)) & 1) {
+      name[position] = static_cast<char>(std::tolower(static_cast<unsigned char>(name[position])));
+    }
+  }
+  return name;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int num_queries = argc > 1 ? std::stoi(argv[1]) : 10'000'000;
+  constexpr int kNumDistinct = 4096;
+
+  std::vector<std::string> names;
+  for (int index = 0; index < kNumDistinct; index++) {
+    names.push_back(make_name(index));
+  }
+
+  // альтернатива: хэш-таблицы с нормализацией регистра запроса
+  std::unordered_map<std::string, Genre> genres;
+  std::unordered_map<Genre, std::string> genre_names;
+
+  for (int index = 0; index <= static_cast<int>(Genre::UNDEFINED); index++) {
+    const auto genre = static_cast<Genre>(index);
+    genres.emplace(std::string(format_enum(genre)), genre);
+    genre_names.emplace(genre, std::string(format_enum(genre)));
+  }
+
+  long long checksum = 0;
+
+  report("parse_enum<Genre>", measure_ms([&] {
+    for (int query = 0; query < num_queries; query++) {
+      auto genre = Genre::UNDEFINED;
+      checksum += parse_enum(names[query % kNumDistinct], genre) ? static_cast<int>(genre) : -1;
+    }
+  }), num_queries);
+
+  report("std::unordered_map<std::string, Genre>", measure_ms([&] {
+    for (int query = 0; query < num_queries; query++) {
+      std::string key = names[query % kNumDistinct];
+      std::transform(key.begin(), key.end(), key.begin(), [](unsigned char symbol) {
+        return static_cast<char>(std::toupper(symbol));
+      });
+
+      const auto it = genres.find(key);
+      checksum += it != genres.end() ? static_cast<int>(it->second) : -1;
+    }
+  }), num_queries);
+
+  report("format_enum<Genre>", measure_ms([&] {
+    for (int query = 0; query < num_queries; query++) {
+      checksum += static_cast<long long>(format_enum(static_cast<Genre>(query % 13)).size());
+    }
+  }), num_queries);
+
+  report("std::unordered_map<Genre, std::string>", measure_ms([&] {
+    for (int query = 0; query < num_queries; query++) {
+      checksum += static_cast<long long>(genre_names.find(static_cast<Genre>(query % 13))->second.size());
+    }
+  }), num_queries);
+
+  std::cout << "checksum: " << checksum << std::endl;
+  return 0;
+}
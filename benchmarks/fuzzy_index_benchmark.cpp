@@ -0,0 +1,84 @@
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+
+using namespace bench::utils;
+
+namespace {
+
+// псевдослово из слогов (детерминированно по номеру)
+std::string make_word(int index) {
+  static const char *const kSyllables[] = {"ka", "lo", "mi", "ne", "ru", "sa", "te", "vi", "do", "pe", "an", "or"};
+  constexpr int kNumSyllables = sizeof(kSyllables) / sizeof(kSyllables[0]);
+
+  std::string word;
+  for (int syllable = 0; syllable < 2 + index % 3; syllable++) {
+    word += kSyllables[index % kNumSyllables];
+    index = index / kNumSyllables + syllable * 7;
+  }
+  return word;
+}
+
+// название из трех-четырех псевдослов
+std::string make_title(int index) {
+  const long long seed = index;
+
+  std::string title = make_word(static_cast<int>(seed * 7919 % 5003));
+  title += " " + make_word(static_cast<int>(seed * 104729 % 4999));
+  title += " " + make_word(static_cast<int>(seed * 1299709 % 4993));
+  if (index % 2 == 0) title += " " + make_word(index % 4987);
+  return title;
+}
+
+// опечатки: перестановка двух соседних символов и замена символа
+std::string misspell(std::string text, int seed) {
+  const std::size_t position = static_cast<std::size_t>(seed) % (text.size() - 1);
+  std::swap(text[position], text[position + 1]);
+  text[(position + 5) % text.size()] = 'x';
+  return text;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  constexpr int kNumQueries = 200;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  report("AddBook with fuzzy dictionaries", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      Book book = make_book(index);
+      book.SetTitle(make_title(index));
+      book_store.AddBook(book);
+    }
+  }), num_books);
+
+  std::vector<std::string> queries;
+  for (int query = 0; query < kNumQueries; query++) {
+    queries.push_back(misspell(make_title(static_cast<int>(query * 4999LL % num_books)), query));
+  }
+
+  long long num_found = 0;
+
+  for (int max_distance = 1; max_distance <= 3; max_distance++) {
+    report("FindBooksByFuzzyTitle, distance " + std::to_string(max_distance), measure_ms([&] {
+      for (const auto &query: queries) {
+        num_found += static_cast<long long>(book_store.FindBooksByFuzzyTitle(query, max_distance, 10).size());
+      }
+    }), kNumQueries);
+  }
+
+  report("FindAuthorsByFuzzyName, distance 2", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      num_found += static_cast<long long>(
+          book_store.FindAuthorsByFuzzyName(misspell("Author #" + std::to_string(query * 7 % 1000), query), 2, 10).size());
+    }
+  }), kNumQueries);
+
+  std::cout << "found: " << num_found << std::endl;
+  return 0;
+}
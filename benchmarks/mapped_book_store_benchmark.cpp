@@ -0,0 +1,69 @@
+#include <algorithm>  // min
+#include <cstdio>     // remove
+#include <filesystem>
+#include <string>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "mapped_book_store.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  const auto path = (std::filesystem::temp_directory_path() / "mapped_book_store_benchmark.db").string();
+
+  std::remove(path.c_str());
+  std::remove((path + ".heap").c_str());
+
+  // хранилище в куче без резерва растет на kCapacityCoefficient ячеек и копирует книги при каждом росте
+  const int num_heap_books = std::min(num_books, 10'000);
+
+  auto book_store = BookStore("Benchmark");
+
+  report("BookStore::AddBook, no reserve", measure_ms([&] {
+    for (int index = 0; index < num_heap_books; index++) {
+      book_store.AddBook(make_book(index));
+    }
+  }), num_heap_books);
+
+  auto mapped_store = MappedBookStore();
+
+  if (mapped_store.Open(path) != MappedStatus::SUCCESS) {
+    std::cerr << "cannot open " << path << std::endl;
+    return 1;
+  }
+
+  report("MappedBookStore::AddBook", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      mapped_store.AddBook(make_book(index));
+    }
+  }), num_books);
+
+  long long total_length = 0;
+
+  report("MappedBookStore::GetTitle, sequential", measure_ms([&] {
+    for (int index = 0; index < mapped_store.GetSize(); index++) {
+      total_length += static_cast<long long>(mapped_store.GetTitle(index).size());
+    }
+  }), num_books);
+
+  report("MappedBookStore::GetBook, sequential", measure_ms([&] {
+    Book book;
+    for (int index = 0; index < mapped_store.GetSize(); index++) {
+      mapped_store.GetBook(index, book);
+      total_length += static_cast<long long>(book.GetContent().size());
+    }
+  }), num_books);
+
+  report("MappedBookStore::Sync", measure_ms([&] {
+    mapped_store.Sync();
+  }), 1);
+
+  std::cout << "total length: " << total_length << ", heap: " << mapped_store.GetHeapSize() << " bytes" << std::endl;
+
+  mapped_store.Close();
+  std::remove(path.c_str());
+  std::remove((path + ".heap").c_str());
+  return 0;
+}
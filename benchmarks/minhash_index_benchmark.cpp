@@ -0,0 +1,100 @@
+#include <algorithm>  // min
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "minhash_index.hpp"
+
+using namespace bench::utils;
+
+namespace {
+
+// тексты по 200 слов из словаря; каждый десятый текст - копия предыдущего с опечаткой
+std::vector<std::string> make_texts(int num_texts) {
+  constexpr int kNumWords = 200;
+  constexpr int kVocabularySize = 50'000;
+
+  auto engine = std::mt19937{42};
+  std::vector<std::string> texts;
+  texts.reserve(num_texts);
+
+  for (int index = 0; index < num_texts; index++) {
+    if (index % 10 == 9) {
+      texts.push_back(texts.back() + " typo");
+      continue;
+    }
+
+    std::string text;
+    for (int word = 0; word < kNumWords; word++) {
+      text += "w" + std::to_string(engine() % kVocabularySize) + ' ';
+    }
+    texts.push_back(std::move(text));
+  }
+
+  return texts;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int num_texts = argc > 1 ? std::stoi(argv[1]) : 100'000;
+  constexpr int kNumPairwiseTexts = 2'000;
+  constexpr double kMinSimilarity = 0.8;
+
+  const std::vector<std::string> texts = make_texts(num_texts);
+
+  auto index = MinHashIndex();
+
+  report("MinHashIndex::Insert (200 words)", measure_ms([&] {
+    for (int id = 0; id < num_texts; id++) {
+      index.Insert(texts[id], id);
+    }
+  }), num_texts);
+
+  std::size_t num_clusters = 0;
+
+  report("FindClusters (LSH banding)", measure_ms([&] {
+    num_clusters = index.FindClusters(kMinSimilarity).size();
+  }), num_texts);
+
+  // попарное сравнение подписей: O(N^2) даже без сравнения самих текстов
+  const int num_pairwise = std::min(num_texts, kNumPairwiseTexts);
+  long long num_similar = 0;
+
+  report("pairwise EstimateSimilarity, first " + std::to_string(num_pairwise) + " texts", measure_ms([&] {
+    for (int lhs = 0; lhs < num_pairwise; lhs++) {
+      for (int rhs = lhs + 1; rhs < num_pairwise; rhs++) {
+        num_similar += index.EstimateSimilarity(lhs, rhs) >= kMinSimilarity ? 1 : 0;
+      }
+    }
+  }), static_cast<long long>(num_pairwise) * (num_pairwise - 1) / 2);
+
+  // стоимость подписей при добавлении книг (поиск дубликатов включается явно)
+  auto plain_store = BookStore("Benchmark");
+  auto book_store = BookStore("Benchmark");
+  plain_store.Reserve(num_texts);
+  book_store.Reserve(num_texts);
+  book_store.EnableNearDuplicates();
+
+  const auto add_books = [&texts, num_texts](BookStore &store) {
+    for (int id = 0; id < num_texts; id++) {
+      store.AddBook(Book("Title #" + std::to_string(id), texts[id], Genre::DRAMA, Publisher::RUS,
+                         {Author("Author", 30, Sex::MALE)}));
+    }
+  };
+
+  report("AddBook", measure_ms([&] { add_books(plain_store); }), num_texts);
+  report("AddBook with content signatures", measure_ms([&] { add_books(book_store); }), num_texts);
+
+  std::size_t num_store_clusters = 0;
+
+  report("FindNearDuplicates", measure_ms([&] {
+    num_store_clusters = book_store.FindNearDuplicates(kMinSimilarity).size();
+  }), num_texts);
+
+  std::cout << "clusters: " << num_clusters << " (expected " << num_texts / 10 << "), store clusters: "
+            << num_store_clusters << ", similar pairs among first " << num_pairwise << ": " << num_similar << std::endl;
+  return 0;
+}
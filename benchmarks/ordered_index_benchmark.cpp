@@ -0,0 +1,53 @@
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+
+  std::vector<Book> books;
+  books.reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    books.push_back(make_book(index));
+  }
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  report("AddBook (indexed)", measure_ms([&] {
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+  }), num_books);
+
+  constexpr int kNumQueries = 1000;
+  long long num_found = 0;
+
+  report("FindBooksByTitleRange", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      const std::string from = "Title #" + std::to_string(query);
+      num_found += static_cast<long long>(book_store.FindBooksByTitleRange(from, from + "1").size());
+    }
+  }), kNumQueries);
+
+  report("FindBooksByTitlePrefix (page of 50)", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      num_found += static_cast<long long>(book_store.FindBooksByTitlePrefix("Title #" + std::to_string(query % 10), 0, 50).size());
+    }
+  }), kNumQueries);
+
+  report("FindBooksByAuthorAge", measure_ms([&] {
+    for (int query = 0; query < kNumQueries / 100; query++) {
+      num_found += static_cast<long long>(book_store.FindBooksByAuthorAge(30 + query, 31 + query).size());
+    }
+  }), kNumQueries / 100);
+
+  std::cout << "found: " << num_found << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,57 @@
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_query.hpp"
+#include "book_store.hpp"
+#include "query_cache.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 200'000;
+  constexpr int kNumQueries = 10'000;
+  constexpr int kNumBursts = 10;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books + kNumBursts);
+
+  for (int index = 0; index < num_books; index++) {
+    book_store.AddBook(make_book(index));
+  }
+
+  QueryCache &cache = book_store.RegisterAggregate<QueryCache>();
+
+  // небольшой набор повторяющихся запросов: жанр + издательство и поиск по автору
+  std::vector<BookQuery> queries;
+  for (int genre = 0; genre < static_cast<int>(Genre::UNDEFINED); genre++) {
+    queries.push_back(BookQuery(book_store).WhereGenre(static_cast<Genre>(genre)).WherePublisher(Publisher::USA));
+  }
+  queries.push_back(BookQuery(book_store).WhereAuthor("Author #7"));
+  queries.push_back(BookQuery(book_store).WhereTitleContains("Title #99"));
+
+  long long num_found = 0;
+
+  report("BookQuery::Count, no cache", measure_ms([&] {
+    for (int query = 0; query < kNumQueries / 100; query++) {
+      num_found += queries[query % queries.size()].Count();
+    }
+  }), kNumQueries / 100);
+
+  // между запросами добавляются книги одного жанра - сбрасываются только подходящие записи
+  report("QueryCache::Count with AddBook bursts", measure_ms([&] {
+    for (int query = 0; query < kNumQueries; query++) {
+      if (query % (kNumQueries / kNumBursts) == 0) {
+        book_store.AddBook(Book("New title", "Content", Genre::HORROR, Publisher::USA,
+                                {Author("New author", 30, Sex::FEMALE)}));
+      }
+      num_found += cache.Count(queries[query % queries.size()]);
+    }
+  }), kNumQueries);
+
+  const QueryCacheStats stats = cache.GetStats();
+
+  std::cout << "found: " << num_found << ", hit rate: " << stats.GetHitRate()
+            << ", invalidations: " << stats.num_invalidations << std::endl;
+  return 0;
+}
@@ -0,0 +1,85 @@
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "sharded_book_store.hpp"
+
+using namespace bench::utils;
+
+namespace {
+
+// параллельное добавление книг: каждый поток добавляет свою часть набора
+template <typename AddFunc>
+double parallel_add(const std::vector<Book> &books, int num_threads, AddFunc &&add) {
+  return measure_ms([&] {
+    std::vector<std::thread> threads;
+
+    for (int thread_index = 0; thread_index < num_threads; thread_index++) {
+      threads.emplace_back([&, thread_index] {
+        for (std::size_t index = thread_index; index < books.size(); index += num_threads) {
+          add(books[index]);
+        }
+      });
+    }
+
+    for (auto &thread: threads) {
+      thread.join();
+    }
+  });
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 1'000'000;
+  const int max_threads = argc > 2 ? std::stoi(argv[2]) : static_cast<int>(std::thread::hardware_concurrency());
+
+  std::vector<Book> books;
+  books.reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    books.push_back(make_book(index));
+  }
+
+  // кривые пропускной способности: один магазин под общей блокировкой против шардированного
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    auto single_store = BookStore("Single");
+    single_store.Reserve(num_books);
+    std::mutex single_mutex;
+
+    const double single_ms = parallel_add(books, num_threads, [&](const Book &book) {
+      std::lock_guard lock(single_mutex);
+      single_store.AddBook(book);
+    });
+
+    auto sharded_store = ShardedBookStore("Sharded", num_threads * 4, num_threads);
+    sharded_store.Reserve(num_books);
+
+    const double sharded_ms = parallel_add(books, num_threads, [&](const Book &book) {
+      sharded_store.AddBook(book);
+    });
+
+    const std::string suffix = " x" + std::to_string(num_threads) + " threads";
+    report("AddBook single store" + suffix, single_ms, num_books);
+    report("AddBook sharded store" + suffix, sharded_ms, num_books);
+
+    constexpr int kNumQueries = 100;
+
+    report("FindBooksByAuthor single store" + suffix, measure_ms([&] {
+      for (int query = 0; query < kNumQueries; query++) {
+        single_store.FindBooksByAuthor("Author #" + std::to_string(query));
+      }
+    }), kNumQueries);
+
+    report("FindBooksByAuthor sharded store" + suffix, measure_ms([&] {
+      for (int query = 0; query < kNumQueries; query++) {
+        sharded_store.FindBooksByAuthor("Author #" + std::to_string(query));
+      }
+    }), kNumQueries);
+  }
+
+  return 0;
+}
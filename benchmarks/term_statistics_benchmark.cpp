@@ -0,0 +1,73 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "term_statistics.hpp"
+#include "tokenizer.hpp"
+
+using namespace bench::utils;
+
+namespace {
+
+// синтетическое содержание: слова из словаря в 5000 слов, разделенные пробелами и знаками препинания
+std::string make_content(int index, int num_words) {
+  std::string content;
+
+  for (int word = 0; word < num_words; word++) {
+    content += "word" + std::to_string((index * 31 + word * 7919) % 5000);
+    content += word % 10 == 9 ? ". " : " ";
+  }
+
+  return content;
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 2'000;
+  const int num_words = argc > 2 ? std::stoi(argv[2]) : 10'000;
+
+  auto book_store = BookStore("Benchmark");
+  book_store.Reserve(num_books);
+
+  long long num_bytes = 0;
+
+  for (int index = 0; index < num_books; index++) {
+    Book book = make_book(index);
+    book.SetContent(make_content(index, num_words));
+    num_bytes += static_cast<long long>(book.GetContent().size());
+    book_store.AddBook(book);
+  }
+
+  std::cout << "content: " << num_bytes / (1024 * 1024) << " MB" << std::endl;
+
+  long long num_tokens = 0;
+
+  report("std::istringstream tokenization (bytes)", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      std::istringstream ss(book_store.GetBooks()[index].GetContent());
+      for (std::string word; ss >> word; /* ... */) {
+        num_tokens += 1;
+      }
+    }
+  }), num_bytes);
+
+  report("for_each_token (bytes)", measure_ms([&] {
+    for (int index = 0; index < num_books; index++) {
+      for_each_token(book_store.GetBooks()[index].GetContent(), [&](std::string_view) { num_tokens += 1; });
+    }
+  }), num_bytes);
+
+  const int max_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    report("build_term_statistics, " + std::to_string(num_threads) + " threads (bytes)", measure_ms([&] {
+      num_tokens += build_term_statistics(book_store, num_threads).num_tokens;
+    }), num_bytes);
+  }
+
+  std::cout << "tokens: " << num_tokens << std::endl;
+  return 0;
+}
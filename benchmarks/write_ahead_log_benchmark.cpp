@@ -0,0 +1,71 @@
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "benchmark_utils.hpp"
+#include "book_store.hpp"
+#include "write_ahead_log.hpp"
+
+using namespace bench::utils;
+
+int main(int argc, char **argv) {
+  const int num_books = argc > 1 ? std::stoi(argv[1]) : 100'000;
+  const auto path = (std::filesystem::temp_directory_path() / "write_ahead_log_benchmark.log").string();
+
+  std::vector<Book> books;
+  books.reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    books.push_back(make_book(index));
+  }
+
+  {
+    auto book_store = BookStore("Benchmark");
+    book_store.Reserve(num_books);
+
+    report("AddBook without log", measure_ms([&] {
+      for (const auto &book: books) {
+        book_store.AddBook(book);
+      }
+    }), num_books);
+  }
+
+  // одна синхронизация на книгу дорога, поэтому для batch_size = 1 берется меньше книг
+  for (const int batch_size: {1, 64, 1024, 16384}) {
+    std::filesystem::remove(path);
+
+    const int num_logged = batch_size == 1 ? std::min(num_books, 1000) : num_books;
+
+    auto log = WriteAheadLog();
+    log.Open(path, batch_size, std::chrono::milliseconds{1000});
+
+    auto book_store = BookStore("Benchmark");
+    book_store.Reserve(num_books);
+    book_store.AttachLog(&log);
+
+    const double time_ms = measure_ms([&] {
+      for (int index = 0; index < num_logged; index++) {
+        book_store.AddBook(books[index]);
+      }
+      log.Sync();
+    });
+
+    report("AddBook with log, batch of " + std::to_string(batch_size), time_ms, num_logged);
+    std::cout << "  syncs: " << log.GetNumSyncs() << std::endl;
+
+    book_store.AttachLog(nullptr);
+  }
+
+  {
+    auto book_store = BookStore("Benchmark");
+    book_store.Reserve(num_books);
+    int num_replayed = 0;
+
+    const double time_ms = measure_ms([&] { WriteAheadLog::Replay(path, book_store, &num_replayed); });
+    report("Replay", time_ms, num_replayed);
+  }
+
+  std::filesystem::remove(path);
+
+  return 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "book.hpp"
+#include "book_store.hpp"
+#include "thread_pool.hpp"
+
+// структура: источник книги - сырая запись без содержания и путь к файлу содержания
+struct BookSource {
+  BookRecord record;         // поля книги (содержание будет прочитано из файла)
+  std::string content_path;  // путь к файлу содержания
+};
+
+/**
+ * Асинхронная загрузка содержания книг.
+ *
+ * Чтение файлов выполняется в отдельном пуле потоков ввода-вывода, размер которого
+ * может превышать кол-во ядер: потоки большую часть времени ждут диск.
+ * Разбор и валидация (Book::TryCreate) в пуле ввода-вывода не выполняются, чтобы не занимать
+ * его потоки работой процессора: вызывающий поток создает книги и добавляет их в магазин,
+ * пока следующие файлы еще читаются.
+ */
+struct AsyncContentLoader {
+ public:
+  /**
+   * Создает загрузчик.
+   *
+   * @param num_io_threads - кол-во потоков ввода-вывода (= максимальное кол-во одновременных чтений)
+   */
+  explicit AsyncContentLoader(int num_io_threads);
+
+  /**
+   * Асинхронное чтение файла содержания.
+   *
+   * @param path - путь к файлу
+   * @return future с содержимым файла (пустая строка, если файл не удалось прочитать)
+   */
+  std::future<std::string> LoadContent(const std::string &path);
+
+  /**
+   * Асинхронное создание книги: содержание читается в пуле ввода-вывода, а валидация
+   * через Book::TryCreate откладывается (std::launch::deferred) и выполняется в потоке,
+   * вызвавшем get() у возвращенного future.
+   * Непрочитанный файл дает пустое содержание и статус ValidationStatus::EMPTY_CONTENT.
+   *
+   * @param source - источник книги
+   * @return future с результатом создания книги
+   */
+  std::future<Result<Book>> LoadBook(BookSource source);
+
+  /**
+   * Загрузка книг в магазин с ограниченным кол-вом одновременных чтений.
+   * Книги добавляются в порядке следования источников, пока остальные файлы еще читаются.
+   *
+   * @param store - книжный магазин (заполняется в вызывающем потоке)
+   * @param sources - источники книг
+   * @param max_in_flight - максимальное кол-во одновременно загружаемых книг
+   * @return отчет о добавлении (номера отклоненных записей соответствуют индексам sources)
+   */
+  BulkAddReport LoadBooksInto(BookStore &store, const std::vector<BookSource> &sources, int max_in_flight);
+
+  int GetNumIoThreads() const;
+
+ private:
+  ThreadPool io_pool_;  // пул потоков ввода-вывода
+};
+
+/**
+ * Синхронное чтение файла целиком.
+ *
+ * @param path - путь к файлу
+ * @return содержимое файла (пустая строка, если файл не удалось прочитать)
+ */
+std::string read_content_file(const std::string &path);
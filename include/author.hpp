@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include "validation.hpp"  // ValidationStatus, Result
+
 // перечисление: биологический пол автора
 enum class Sex {
   MALE,
@@ -9,6 +11,13 @@ enum class Sex {
   UNDEFINED  // Т - толерантность
 };
 
+// структура: сырые (непроверенные) поля автора из внешнего источника
+struct AuthorRecord {
+  std::string full_name;    // полное имя
+  int age{0};               // возраст
+  Sex sex{Sex::UNDEFINED};  // биологический пол
+};
+
 // структура: автор книг
 struct Author {
  public:
@@ -22,11 +31,48 @@ struct Author {
    */
   Author(const std::string &full_name, int age, Sex sex);
 
+  /**
+   * Создает объект автора книги без выбрасывания исключений.
+   * Предназначен для массовой загрузки данных, где некорректные записи - обычное дело.
+   *
+   * @param full_name - полное имя автора книги
+   * @param age - возраст автора
+   * @param sex - биологический пол автора
+   * @return статус валидации и (при успехе) созданный автор
+   */
+  static Result<Author> TryCreate(const std::string &full_name, int age, Sex sex);
+  static Result<Author> TryCreate(const AuthorRecord &record);
+
+  /**
+   * Восстанавливает сохраненного автора (журнал, колоночный формат) без выбрасывания исключений.
+   * В отличие от TryCreate, некорректные поля не отклоняют автора, а остаются по умолчанию
+   * (пустое имя, нулевой возраст): магазин может хранить и авторов, созданных по умолчанию.
+   *
+   * @param full_name - полное имя автора книги
+   * @param age - возраст автора
+   * @param sex - биологический пол автора
+   * @return восстановленный автор
+   */
+  static Author Restore(const std::string &full_name, int age, Sex sex);
+
+  /**
+   * Проверка полей автора без создания объекта.
+   *
+   * @param full_name - полное имя автора книги
+   * @param age - возраст автора
+   * @return статус валидации
+   */
+  static ValidationStatus Validate(const std::string &full_name, int age);
+
   // setters
   void SetAge(int age);
   void SetSex(Sex sex);
   void SetFullName(const std::string &full_name);
 
+  // setters без исключений (поле не изменяется, если валидация не пройдена)
+  ValidationStatus TrySetAge(int age);
+  ValidationStatus TrySetFullName(const std::string &full_name);
+
   // getters
   int GetAge() const;
   Sex GetSex() const;
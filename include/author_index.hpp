@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Обратный индекс: полное имя автора -> отсортированный список позиций его книг в хранилище.
+ * Имя является идентификатором автора (см. Book::AddAuthor, где дубликаты отсеиваются по имени).
+ */
+struct AuthorIndex {
+ public:
+  /**
+   * Добавление книги в список книг автора.
+   * Позиции, добавляемые по возрастанию, дописываются в конец списка за O(1).
+   *
+   * @param full_name - полное имя автора
+   * @param position - позиция книги в хранилище
+   */
+  void Insert(const std::string &full_name, int position);
+
+  /**
+   * Поиск книг автора за O(1) + O(кол-во книг автора).
+   *
+   * @param full_name - полное имя автора
+   * @return отсортированный список позиций книг (пустой, если автор не найден)
+   */
+  const std::vector<int> &Find(const std::string &full_name) const;
+
+  /**
+   * Поиск книг, написанных всеми перечисленными авторами (соавторами).
+   * Выполняется как пересечение списков позиций, начиная с самого короткого.
+   *
+   * @param full_names - полные имена соавторов
+   * @return отсортированный список позиций книг
+   */
+  std::vector<int> FindAll(const std::vector<std::string> &full_names) const;
+
+  // getters
+  int GetNumAuthors() const;
+  const std::unordered_map<std::string, std::vector<int>> &GetPostings() const;
+
+  // высвобождение памяти, занимаемой индексом
+  void Clear();
+
+ private:
+  std::unordered_map<std::string, std::vector<int>> postings_;  // имя автора -> позиции книг
+};
+
+/**
+ * Пересечение двух отсортированных списков позиций.
+ * Для списков сильно различающейся длины используется экспоненциальный (galloping) поиск.
+ *
+ * @param lhs - отсортированный список позиций
+ * @param rhs - отсортированный список позиций
+ * @return отсортированный список общих позиций
+ */
+std::vector<int> intersect_postings(const std::vector<int> &lhs, const std::vector<int> &rhs);
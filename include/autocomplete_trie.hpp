@@ -0,0 +1,107 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Префиксное дерево со сжатыми ребрами (radix trie) для подсказок при наборе текста.
+ *
+ * Каждая строка имеет вес - кол-во ее добавлений (например, кол-во книг с таким названием).
+ * Каждый узел хранит kMaxCompletions лучших строк своего поддерева (по убыванию веса,
+ * при равенстве - лексикографически), поэтому подсказка по префиксу стоит O(|prefix| + limit)
+ * независимо от размера поддерева. Веса только растут, и кэши узлов на пути от корня
+ * к добавленной строке обновляются за O(длина пути * kMaxCompletions). Если нужно больше строк,
+ * чем хранит кэш (например, вызывающий код отфильтровывает часть строк), остальные строки
+ * выдаются обходом поддерева в том же порядке.
+ * Регистр латинских букв не учитывается, для строк, отличающихся лишь регистром,
+ * подсказывается первое добавленное написание.
+ */
+struct AutocompleteTrie {
+ public:
+  /**
+   * Добавление строки (повторное добавление увеличивает ее вес).
+   *
+   * @param text - строка
+   */
+  void Insert(const std::string &text);
+
+  /**
+   * Подсказки для префикса.
+   *
+   * @param prefix - префикс (регистр латинских букв не важен)
+   * @param visit - функция вида bool(const std::string &text, int weight);
+   *                обход прекращается, когда функция вернет false (или строки закончатся)
+   */
+  template <typename Visitor>
+  void Complete(std::string_view prefix, Visitor &&visit) const {
+    const int node = find_node(prefix);
+
+    if (node < 0) return;
+
+    const auto &top = nodes_[node].top;
+
+    for (int term: top) {
+      if (!visit(terms_[term], weights_[term])) return;
+    }
+
+    // кэш заполнен - в поддереве могут быть строки, не попавшие в него
+    if (static_cast<int>(top.size()) == kMaxCompletions) {
+      walk_subtree(node, kMaxCompletions, [&](int term) { return visit(terms_[term], weights_[term]); });
+    }
+  }
+
+  /**
+   * Подсказки для префикса (см. Complete).
+   *
+   * @param prefix - префикс (регистр латинских букв не важен)
+   * @param limit - максимальное кол-во подсказок (сверх kMaxCompletions - обходом поддерева)
+   * @return строки по убыванию веса
+   */
+  std::vector<std::string> Complete(std::string_view prefix, int limit) const;
+
+  // кол-во различных строк
+  int GetSize() const;
+
+  // высвобождение памяти, занимаемой деревом
+  void Clear();
+
+ public:
+  // кол-во лучших строк, хранящихся в каждом узле
+  static constexpr int kMaxCompletions = 10;
+
+ private:
+  // узел дерева
+  struct Node {
+    std::string label;          // метка входящего ребра (в нижнем регистре)
+    std::vector<int> children;  // дочерние узлы (по возрастанию первого символа метки)
+    std::vector<int> top;       // лучшие строки поддерева
+    int term{-1};               // строка, заканчивающаяся в узле (-1 - нет)
+  };
+
+  std::vector<Node> nodes_;          // узлы (нулевой - корень)
+  std::vector<std::string> terms_;   // идентификатор -> строка
+  std::vector<int> weights_;         // идентификатор -> вес строки
+
+  // поиск узла, поддерево которого содержит все строки с префиксом (-1 - таких строк нет)
+  int find_node(std::string_view prefix) const;
+
+  // поиск дочернего узла, метка которого начинается с символа (-1 - не найден)
+  int find_child(int node, char symbol) const;
+
+  // добавление дочернего узла с сохранением порядка дочерних узлов
+  int add_child(int parent, std::string label);
+
+  // обход строк поддерева по убыванию веса (лучшие по ключу узлы раскрываются первыми),
+  // первые num_skipped строк пропускаются (уже выданы из кэша)
+  void walk_subtree(int node, int num_skipped, const std::function<bool(int term)> &visit) const;
+
+  // обновление кэша лучших строк узла после увеличения веса строки
+  void update_top(int node, int term);
+
+  // сравнение строк по убыванию веса, затем лексикографически
+  bool is_better(int lhs, int rhs) const;
+};
+
+static_assert(AutocompleteTrie::kMaxCompletions >= 1);
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// структура: статистика проверок наличия через фильтр Блума
+struct BloomFilterStats {
+  long long num_queries{0};          // кол-во проверок
+  long long num_negatives{0};        // кол-во проверок, отсеченных фильтром (без обращения к индексам)
+  long long num_false_positives{0};  // кол-во ложноположительных ответов фильтра
+
+  // доля проверок, отсеченных фильтром
+  double GetNegativeRate() const;
+
+  // доля ложноположительных ответов среди проверок отсутствующих ключей
+  double GetFalsePositiveRate() const;
+};
+
+/**
+ * Блочный фильтр Блума для быстрых отрицательных ответов на проверку наличия строки.
+ *
+ * Все биты ключа лежат в одном блоке размером с кэш-линию (8 машинных слов по 64 бита),
+ * по одному биту в каждом слове блока (split block фильтр), поэтому проверка стоит одного
+ * промаха кэша, а маска блока вычисляется и сравнивается без ветвлений (векторизуется компилятором).
+ * Кол-во блоков подбирается по ожидаемому кол-ву ключей и вероятности ложного срабатывания.
+ * Удаление ключей не поддерживается: фильтр перестраивается владельцем.
+ */
+struct BloomFilter {
+ public:
+  // пустой фильтр (не содержит ни одного ключа)
+  BloomFilter() = default;
+
+  /**
+   * Создает фильтр под заданное кол-во ключей.
+   *
+   * @param capacity - ожидаемое кол-во различных ключей
+   * @param false_positive_rate - вероятность ложного срабатывания при capacity ключах, из (0, 1)
+   */
+  BloomFilter(int capacity, double false_positive_rate);
+
+  /**
+   * Добавление ключа в фильтр.
+   *
+   * @param key - ключ
+   * @return true - ключ добавлен, false - все биты ключа уже были установлены
+   */
+  bool Insert(std::string_view key);
+
+  /**
+   * Проверка наличия ключа за O(|key|).
+   *
+   * @param key - ключ
+   * @return false - ключ точно не добавлялся, true - ключ, вероятно, добавлялся
+   */
+  bool MightContain(std::string_view key) const;
+
+  // getters
+  int GetSize() const;      // кол-во добавленных ключей (без повторов, с точностью до ложных срабатываний)
+  int GetCapacity() const;  // ожидаемое кол-во ключей
+  double GetFalsePositiveRate() const;
+
+  // высвобождение памяти, занимаемой фильтром
+  void Clear();
+
+ public:
+  static constexpr int kWordsPerBlock = 8;  // кол-во 64-битных слов в блоке (блок - кэш-линия)
+
+ private:
+  struct alignas(64) Block {
+    std::array<std::uint64_t, kWordsPerBlock> words{};
+  };
+
+  std::vector<Block> blocks_;
+  int size_{0};
+  int capacity_{0};
+  double false_positive_rate_{0.0};
+
+  // маска битов ключа в блоке
+  Block make_mask(std::uint32_t hash) const;
+
+  // номер блока ключа
+  std::size_t block_index(std::uint64_t hash) const;
+};
+
+static_assert(BloomFilter::kWordsPerBlock * sizeof(std::uint64_t) == 64);
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <memory>  // shared_ptr
 #include <string>
 #include <vector>
 
-#include "author.hpp"  // Author
+#include "author.hpp"        // Author, AuthorRecord
+#include "memory_usage.hpp"  // MemoryBreakdown
+#include "small_vector.hpp"  // SmallVector
+#include "validation.hpp"    // ValidationStatus, Result
 
 // перечисление: жанр книги
 enum class Genre {
@@ -31,6 +35,21 @@ enum class Publisher {
   UNDEFINED
 };
 
+// кол-во авторов, хранящихся внутри книги без выделения памяти (у большинства книг 1-3 автора)
+inline constexpr int kInlineAuthors = 3;
+
+// список авторов книги: до kInlineAuthors авторов внутри книги, остальные - в куче
+using AuthorList = SmallVector<Author, kInlineAuthors>;
+
+// структура: сырые (непроверенные) поля книги из внешнего источника
+struct BookRecord {
+  std::string title;                          // название
+  std::string content;                        // содержание
+  Genre genre{Genre::UNDEFINED};              // жанр
+  Publisher publisher{Publisher::UNDEFINED};  // издательство
+  std::vector<AuthorRecord> authors;          // список авторов
+};
+
 // структура: книга
 struct Book {
  public:
@@ -50,6 +69,50 @@ struct Book {
        Publisher publisher,
        const std::vector<Author> &authors);
 
+  /**
+   * Создает объект книги без выбрасывания исключений.
+   * Предназначен для массовой загрузки данных, где некорректные записи - обычное дело.
+   *
+   * @param title - название книги
+   * @param content - содержание
+   * @param genre - жанр
+   * @param publisher - издательство
+   * @param authors - список авторов
+   * @return статус валидации и (при успехе) созданная книга
+   */
+  static Result<Book> TryCreate(const std::string &title,
+                                const std::string &content,
+                                Genre genre,
+                                Publisher publisher,
+                                const std::vector<Author> &authors);
+
+  /**
+   * Создает объект книги из сырой записи без выбрасывания исключений.
+   * Авторы записи проверяются с помощью Author::TryCreate.
+   *
+   * @param record - сырая запись книги
+   * @return статус валидации первого некорректного поля и (при успехе) созданная книга
+   */
+  static Result<Book> TryCreate(const BookRecord &record);
+
+  /**
+   * Восстанавливает сохраненную книгу (журнал, колоночный формат) без выбрасывания исключений.
+   * Корректная книга создается как в TryCreate, у некорректной поля, не прошедшие валидацию,
+   * остаются по умолчанию: магазин может хранить и книги с пустыми полями (например, Book{}).
+   *
+   * @param title - название книги
+   * @param content - содержание
+   * @param genre - жанр
+   * @param publisher - издательство
+   * @param authors - список авторов (см. Author::Restore)
+   * @return восстановленная книга
+   */
+  static Book Restore(const std::string &title,
+                      const std::string &content,
+                      Genre genre,
+                      Publisher publisher,
+                      const std::vector<Author> &authors);
+
   /**
    * Добавление автора к списку авторов.
    * Автор с уже существующим в списке авторов имененем игнорируется.
@@ -64,7 +127,7 @@ struct Book {
   const std::string &GetContent() const;
   Genre GetGenre() const;
   Publisher GetPublisher() const;
-  const std::vector<Author> &GetAuthors() const;
+  const AuthorList &GetAuthors() const;
 
   // setters
   void SetTitle(const std::string &title);
@@ -72,6 +135,24 @@ struct Book {
   void SetGenre(Genre genre);
   void SetPublisher(Publisher publisher);
 
+  // setters без исключений (поле не изменяется, если валидация не пройдена)
+  ValidationStatus TrySetTitle(const std::string &title);
+  ValidationStatus TrySetContent(const std::string &content);
+
+  /**
+   * Учет памяти, занимаемой данными книги вне ее объекта:
+   * разделяемые буферы строк, имена авторов и не уместившийся в книге список авторов.
+   *
+   * @param usage - разбивка памяти, к которой добавляется книга
+   */
+  void AccountMemory(MemoryBreakdown &usage) const;
+
+  // копии разделяют строки (copy-on-write), список авторов типичной книги копируется без выделения памяти
+  Book(const Book &) = default;
+  Book(Book &&) noexcept = default;
+  Book &operator=(const Book &) = default;
+  Book &operator=(Book &&) noexcept = default;
+
   // === необходимо для тестов ===
   Book() = default;
   virtual ~Book() = default;
@@ -80,10 +161,13 @@ struct Book {
 
  private:
   // поля структуры
-  std::string title_;                          // название
-  std::string content_;                        // содержание
+  // Строки хранятся в разделяемых буферах со счетчиком ссылок:
+  // копия книги лишь увеличивает счетчики, а изменение поля копирует буфер,
+  // только если он используется несколькими книгами. nullptr соответствует пустому полю.
+  std::shared_ptr<std::string> title_;          // название
+  std::shared_ptr<std::string> content_;        // содержание
 
-  std::vector<Author> authors_;                // список авторов
+  AuthorList authors_;  // список авторов (встроенный буфер на kInlineAuthors авторов)
 
   Genre genre_{Genre::UNDEFINED};              // жанр
   Publisher publisher_{Publisher::UNDEFINED};  // издательсво
@@ -92,11 +176,12 @@ struct Book {
 // === необходимо для тестов ===
 
 inline bool operator==(const Book &lhs, const Book &rhs) {
-  if (lhs.title_ != rhs.title_) return false;
-  if (lhs.content_ != rhs.content_) return false;
-  if (lhs.authors_ != rhs.authors_) return false;
   if (lhs.genre_ != rhs.genre_) return false;
   if (lhs.publisher_ != rhs.publisher_) return false;
+  // общие буферы заведомо равны, сравнение содержимого не требуется
+  if (lhs.title_ != rhs.title_ && lhs.GetTitle() != rhs.GetTitle()) return false;
+  if (lhs.authors_ != rhs.authors_) return false;
+  if (lhs.content_ != rhs.content_ && lhs.GetContent() != rhs.GetContent()) return false;
   return true;
 }
 
@@ -107,3 +192,4 @@ inline bool operator!=(const Book &lhs, const Book &rhs) {
 // внутренние проверки на этапе компиляции (не обращайте внимания)
 static_assert(static_cast<int>(Genre::UNDEFINED) == 12);
 static_assert(static_cast<int>(Publisher::UNDEFINED) == 4);
+static_assert(kInlineAuthors >= 1);
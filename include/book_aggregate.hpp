@@ -0,0 +1,206 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <type_traits>  // has_virtual_destructor_v
+#include <vector>
+
+#include "author.hpp"
+#include "bloom_filter.hpp"  // BloomFilter
+#include "book.hpp"
+#include "space_saving.hpp"  // SpaceSaving
+
+// структура: кол-во книг автора (результат top-K запросов)
+struct AuthorBookCount {
+  std::string full_name;  // полное имя автора
+  int count{0};           // кол-во книг (для приближенных запросов - оценка сверху)
+};
+
+// структура: кол-во книг с заданной парой жанр-издательство (результат top-K запросов)
+struct GenrePublisherCount {
+  Genre genre{Genre::UNDEFINED};              // жанр
+  Publisher publisher{Publisher::UNDEFINED};  // издательство
+  int count{0};                               // кол-во книг
+};
+
+/**
+ * Инкрементальный агрегат по живым книгам магазина (см. BookStore::RegisterAggregate).
+ *
+ * Магазин вызывает Add при добавлении книги и Remove при ее удалении;
+ * изменение книги (например, добавление автора) передается как Remove старой версии
+ * и Add новой. Оба метода должны работать за O(1) от размера магазина,
+ * а Remove - отменять действие Add для той же книги. Уплотнение хранилища не меняет
+ * набор книг и сообщается отдельно (OnRelocated). Агрегат, который не умеет точно отменять Add
+ * или переполнился, запрашивает пересчет (NeedsRebuild): магазин сбрасывает его (Reset)
+ * и заново учитывает все живые книги.
+ */
+struct BookAggregate {
+ public:
+  virtual ~BookAggregate() = default;
+
+  // учет добавленной книги
+  virtual void Add(const Book &book) = 0;
+
+  // отмена учета удаленной книги
+  virtual void Remove(const Book &book) = 0;
+
+  // книги сменили позиции в хранилище (уплотнение); нужно только агрегатам, хранящим позиции
+  virtual void OnRelocated() {}
+
+  // нужен ли пересчет по живым книгам (проверяется магазином после каждого изменения)
+  virtual bool NeedsRebuild() const {
+    return false;
+  }
+
+  // сброс перед пересчетом (см. NeedsRebuild)
+  virtual void Reset() {}
+};
+
+/**
+ * Встроенные агрегаты каталога для панелей мониторинга: кол-во книг по жанрам и издательствам,
+ * кол-во авторов по полу (автор учитывается в каждой своей книге) и суммарный размер содержания.
+ */
+struct CatalogAggregate : BookAggregate {
+ public:
+  static constexpr int kNumGenres = static_cast<int>(Genre::UNDEFINED) + 1;
+  static constexpr int kNumPublishers = static_cast<int>(Publisher::UNDEFINED) + 1;
+  static constexpr int kNumSexes = static_cast<int>(Sex::UNDEFINED) + 1;
+
+  int num_books{0};                                    // кол-во книг
+  long long content_bytes{0};                          // суммарный размер содержания (в байтах)
+  std::array<int, kNumGenres> genre_counts{};          // жанр -> кол-во книг
+  std::array<int, kNumPublishers> publisher_counts{};  // издательство -> кол-во книг
+  std::array<int, kNumSexes> author_sex_counts{};      // пол -> кол-во пар книга-автор
+
+  void Add(const Book &book) override;
+  void Remove(const Book &book) override;
+
+  // getters
+  int GetCount(Genre genre) const;
+  int GetCount(Publisher publisher) const;
+  int GetCount(Sex sex) const;
+
+ private:
+  // учет книги с заданным знаком (+1 - добавление, -1 - удаление)
+  void apply(const Book &book, int sign);
+};
+
+/**
+ * Счетчики книг по парам жанр-издательство для top-K запросов (см. Top).
+ * Регистрируется по требованию (см. BookStore::RegisterAggregate).
+ */
+struct GenrePublisherAggregate : BookAggregate {
+ public:
+  static constexpr int kNumPairs = CatalogAggregate::kNumGenres * CatalogAggregate::kNumPublishers;
+
+  void Add(const Book &book) override;
+  void Remove(const Book &book) override;
+
+  /**
+   * Поиск k самых частых пар жанр-издательство за O(kNumPairs log k).
+   *
+   * @param k - максимальное кол-во пар
+   * @return пары жанр-издательство и кол-во книг (по убыванию кол-ва книг)
+   */
+  std::vector<GenrePublisherCount> Top(int k) const;
+
+  // кол-во книг с парой жанр-издательство
+  int GetCount(Genre genre, Publisher publisher) const;
+
+ private:
+  std::array<int, kNumPairs> counts_{};  // пара (жанр * кол-во издательств + издательство) -> кол-во книг
+};
+
+/**
+ * Приближенная сводка самых плодовитых авторов (Space-Saving, см. SpaceSaving).
+ * Добавление книги стоит O(кол-во авторов * log capacity) и не зависит от размера магазина.
+ * Удаление книги уменьшает счетчики ее отслеживаемых авторов (оценка остается оценкой сверху).
+ * Регистрируется по требованию (см. BookStore::RegisterAggregate).
+ */
+struct AuthorHeavyHittersAggregate : BookAggregate {
+ public:
+  static constexpr int kDefaultCapacity = 256;
+
+  /**
+   * @param capacity - кол-во счетчиков сводки (точность и память растут с ним)
+   */
+  explicit AuthorHeavyHittersAggregate(int capacity = kDefaultCapacity);
+
+  void Add(const Book &book) override;
+  void Remove(const Book &book) override;
+
+  /**
+   * Приближенный поиск k самых плодовитых авторов без обращения к хранилищу.
+   *
+   * @param k - максимальное кол-во авторов (не более capacity)
+   * @return авторы и оценка сверху кол-ва их книг (по убыванию оценки)
+   */
+  std::vector<AuthorBookCount> Top(int k) const;
+
+ private:
+  SpaceSaving<std::string> summary_;
+};
+
+/**
+ * Фильтры Блума по названиям и именам авторов живых книг для быстрых отрицательных проверок
+ * наличия (см. BookStore::EnablePresenceFilters и BookStore::HasTitle).
+ * Фильтры не поддерживают удаление: строки удаленных книг остаются до пересчета, который
+ * запрашивается, когда удаленных книг больше живых (и больше kInitCapacity) или фильтр заполнен
+ * (вместимость каждого фильтра - вдвое больше кол-ва его ключей). Уплотнение хранилища пересчета не вызывает.
+ */
+struct PresenceFilterAggregate : BookAggregate {
+ public:
+  static constexpr int kInitCapacity = 1024;          // изначальная вместимость фильтров (кол-во строк)
+  static constexpr double kFalsePositiveRate = 0.01;  // вероятность ложного срабатывания по умолчанию
+
+  /**
+   * Создает пустые фильтры.
+   * Меньшая вероятность требует больше памяти: 11 бит на строку при 1%, 16 бит при 0.1%.
+   *
+   * @param false_positive_rate - вероятность ложного срабатывания, из (0, 1)
+   * @param capacity - изначальная вместимость фильтров (кол-во строк)
+   * @throw std::invalid_argument - вероятность вне (0, 1)
+   */
+  explicit PresenceFilterAggregate(double false_positive_rate = kFalsePositiveRate, int capacity = kInitCapacity);
+
+  void Add(const Book &book) override;
+  void Remove(const Book &book) override;
+  bool NeedsRebuild() const override;
+  void Reset() override;
+
+  // false - строки точно нет среди живых книг, true - строка, вероятно, есть
+  bool MightContainTitle(std::string_view title) const;
+  bool MightContainAuthor(std::string_view full_name) const;
+
+  // getters
+  int GetCapacity() const;        // вместимость фильтра названий
+  int GetAuthorCapacity() const;  // вместимость фильтра имен авторов
+  double GetFalsePositiveRate() const;
+  int GetNumRebuilds() const;     // кол-во пересчетов фильтров
+
+ private:
+  double false_positive_rate_;
+  BloomFilter title_filter_;   // названия книг
+  BloomFilter author_filter_;  // имена авторов книг
+  int num_books_{0};           // кол-во учтенных живых книг
+  int num_removed_{0};         // кол-во удаленных книг, строки которых остались в фильтрах
+  int num_rebuilds_{0};        // кол-во пересчетов фильтров (см. Reset)
+};
+
+inline bool operator==(const CatalogAggregate &lhs, const CatalogAggregate &rhs) {
+  return lhs.num_books == rhs.num_books && lhs.content_bytes == rhs.content_bytes &&
+         lhs.genre_counts == rhs.genre_counts && lhs.publisher_counts == rhs.publisher_counts &&
+         lhs.author_sex_counts == rhs.author_sex_counts;
+}
+
+inline bool operator!=(const CatalogAggregate &lhs, const CatalogAggregate &rhs) {
+  return !(lhs == rhs);
+}
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(std::has_virtual_destructor_v<BookAggregate>);
+static_assert(std::is_default_constructible_v<CatalogAggregate>);
+static_assert(AuthorHeavyHittersAggregate::kDefaultCapacity >= 1);
+static_assert(PresenceFilterAggregate::kInitCapacity >= 1);
+static_assert(PresenceFilterAggregate::kFalsePositiveRate > 0.0 && PresenceFilterAggregate::kFalsePositiveRate < 1.0);
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <type_traits>  // invoke_result_t, decay_t
+#include <vector>
+
+#include "book.hpp"
+#include "book_store.hpp"
+
+// перечисление: стоимость вычисления предиката запроса
+enum class PredicateCost {
+  CHEAP,     // сравнение полей фиксированного размера
+  MEDIUM,    // обход небольших коллекций (например, авторов)
+  EXPENSIVE  // обход содержания книги
+};
+
+/**
+ * Ленивый запрос к книжному магазину.
+ *
+ * Запрос собирается из предикатов, объединяемых по И, и ограничения на кол-во результатов.
+ * Вычисление происходит только при вызове ForEach/Indices/Select/Count за один проход по хранилищу:
+ * фильтры по жанру и издательству проверяются битовыми масками, остальные предикаты -
+ * в порядке возрастания стоимости, а проход прекращается по достижении ограничения.
+ * Промежуточные коллекции книг не создаются.
+ *
+ * Пример:
+ *   BookQuery(store).WhereGenre(Genre::HORROR).WhereContentContains("clown").Limit(10).Indices();
+ */
+struct BookQuery {
+ public:
+  /**
+   * Создает запрос ко всем книгам магазина.
+   * Магазин должен существовать на протяжении жизни запроса.
+   *
+   * @param store - книжный магазин
+   */
+  explicit BookQuery(const BookStore &store);
+
+  // фильтры по перечислениям (вызов с несколькими значениями задает объединение)
+  BookQuery &WhereGenre(Genre genre);
+  BookQuery &WhereGenreIn(const std::vector<Genre> &genres);
+  BookQuery &WherePublisher(Publisher publisher);
+  BookQuery &WherePublisherIn(const std::vector<Publisher> &publishers);
+
+  // фильтр: хотя бы один автор старше заданного возраста
+  BookQuery &WhereAuthorOlderThan(int age);
+
+  // фильтр: хотя бы один автор с заданным полным именем
+  BookQuery &WhereAuthor(const std::string &full_name);
+
+  // фильтр: содержание книги содержит подстроку
+  BookQuery &WhereContentContains(const std::string &text);
+
+  // фильтр: название книги содержит подстроку
+  BookQuery &WhereTitleContains(const std::string &text);
+
+  /**
+   * Добавление произвольного предиката.
+   *
+   * @param predicate - предикат вида bool(const Book &)
+   * @param cost - стоимость вычисления предиката (определяет порядок проверки)
+   */
+  BookQuery &Where(std::function<bool(const Book &)> predicate, PredicateCost cost = PredicateCost::MEDIUM);
+
+  /**
+   * Ограничение на кол-во результатов (отрицательное значение - без ограничения).
+   *
+   * @param limit - максимальное кол-во результатов
+   */
+  BookQuery &Limit(int limit);
+
+  /**
+   * Обход подходящих книг в порядке их расположения в хранилище (удаленные книги пропускаются).
+   *
+   * @param visit - функция вида void(const Book &book, int index)
+   */
+  template <typename Visitor>
+  void ForEach(Visitor &&visit) const {
+    if (limit_ == 0) return;
+
+    const Book *books = store_.GetBooks();
+    const bool has_removed = store_.GetNumRemoved() > 0;
+    int num_matched = 0;
+
+    for (int index = 0; index < store_.GetNumSlots(); index++) {
+      const Book &book = books[index];
+
+      if (has_removed && store_.IsRemoved(index)) continue;
+      if (!matches(book)) continue;
+
+      visit(book, index);
+
+      if (++num_matched == limit_) return;
+    }
+  }
+
+  // позиции подходящих книг в хранилище
+  std::vector<int> Indices() const;
+
+  // кол-во подходящих книг (с учетом ограничения)
+  int Count() const;
+
+  // проверка книги всеми фильтрами запроса (без учета ограничения)
+  bool Matches(const Book &book) const;
+
+  /**
+   * Нормализованный ключ запроса (для кэширования результатов, см. QueryCache).
+   * Ключ не зависит от порядка вызова фильтров и способа задания масок перечислений,
+   * поэтому равные по смыслу запросы получают один ключ.
+   *
+   * @return ключ (пустая строка - запрос с произвольным предикатом Where не кэшируется)
+   */
+  std::string GetKey() const;
+
+  // getters
+  int GetLimit() const;
+  const BookStore &GetStore() const;
+
+  /**
+   * Проекция подходящих книг (например, только названий) без копирования самих книг.
+   *
+   * @param projection - функция вида T(const Book &)
+   * @return значения проекции подходящих книг
+   */
+  template <typename Projection>
+  auto Select(Projection &&projection) const {
+    using Value = std::decay_t<std::invoke_result_t<Projection, const Book &>>;
+
+    std::vector<Value> values;
+    ForEach([&](const Book &book, int) { values.push_back(projection(book)); });
+
+    return values;
+  }
+
+ public:
+  // маска, пропускающая все значения перечисления
+  static constexpr std::uint32_t kAllValues = ~std::uint32_t{0};
+
+ private:
+  // предикат с указанием стоимости его вычисления
+  struct Predicate {
+    std::function<bool(const Book &)> test;
+    PredicateCost cost;
+  };
+
+  const BookStore &store_;                      // книжный магазин
+  std::uint32_t genre_mask_{kAllValues};        // допустимые жанры
+  std::uint32_t publisher_mask_{kAllValues};    // допустимые издательства
+  std::vector<Predicate> predicates_;           // упорядочены по стоимости
+  int limit_{-1};                               // ограничение на кол-во результатов
+
+  std::vector<std::string> predicate_keys_;     // ключи встроенных предикатов (для GetKey)
+  bool is_cacheable_{true};                     // нет произвольных предикатов
+
+  // приватный метод для добавления предиката без изменения ключа запроса
+  BookQuery &where(std::function<bool(const Book &)> predicate, PredicateCost cost);
+
+  // приватный метод для добавления встроенного предиката с ключом вида "<тег>:<длина>:<значение>"
+  BookQuery &where(std::function<bool(const Book &)> predicate, PredicateCost cost,
+                   const char *tag, const std::string &value);
+
+  // проверка книги: сначала маски перечислений, затем предикаты по возрастанию стоимости
+  bool matches(const Book &book) const {
+    if (((genre_mask_ >> static_cast<int>(book.GetGenre())) & 1u) == 0) return false;
+    if (((publisher_mask_ >> static_cast<int>(book.GetPublisher())) & 1u) == 0) return false;
+
+    for (const auto &predicate: predicates_) {
+      if (!predicate.test(book)) return false;
+    }
+    return true;
+  }
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(static_cast<int>(Genre::UNDEFINED) < 32, "Genre values must fit into a 32-bit mask");
+static_assert(static_cast<int>(Publisher::UNDEFINED) < 32, "Publisher values must fit into a 32-bit mask");
@@ -1,10 +1,25 @@
 #pragma once
 
+#include <atomic>       // atomic
+#include <functional>   // function
+#include <memory>       // unique_ptr, make_unique
 #include <string>
+#include <type_traits>  // is_base_of_v
+#include <utility>      // forward, move
 #include <vector>
 
 #include "author.hpp"
+#include "author_index.hpp"  // AuthorIndex
+#include "autocomplete_trie.hpp"  // AutocompleteTrie
+#include "bloom_filter.hpp"       // BloomFilterStats
 #include "book.hpp"
+#include "book_aggregate.hpp"     // BookAggregate, CatalogAggregate, PresenceFilterAggregate
+#include "fuzzy_index.hpp"    // FuzzyIndex
+#include "memory_usage.hpp"   // MemoryBreakdown
+#include "minhash_index.hpp"  // MinHashIndex
+#include "ordered_index.hpp"  // OrderedIndex
+
+struct WriteAheadLog;
 
 // перечисление: статус изменения размера хранилища книг
 enum class ResizeStorageStatus {
@@ -30,6 +45,38 @@ enum class ResizeStorageStatus {
  */
 ResizeStorageStatus resize_storage(Book *&storage, int size, int new_capacity);
 
+// перечисление: фаза пошагового уплотнения хранилища (см. BookStore::CompactStep)
+enum class CompactionPhase {
+  IDLE,       // уплотнение не выполняется
+  MOVING,     // живые книги сдвигаются на место удаленных
+  SHRINKING,  // книги копируются в хранилище меньшего объема
+  REINDEXING  // вторичные индексы перестраиваются без удаленных книг
+};
+
+// структура: книга, найденная нечетким поиском
+struct FuzzyBookMatch {
+  int position{0};  // позиция книги в хранилище
+  int distance{0};  // расстояние Левенштейна от запроса до названия книги
+};
+
+// структура: автор, найденный нечетким поиском
+struct FuzzyAuthorMatch {
+  std::string full_name;  // полное имя автора
+  int distance{0};        // расстояние Левенштейна от запроса до имени автора
+};
+
+// структура: отклоненная при массовом добавлении запись
+struct RejectedRecord {
+  int row{0};                                          // номер записи во входном пакете
+  ValidationStatus status{ValidationStatus::SUCCESS};  // причина отклонения
+};
+
+// структура: отчет о массовом добавлении книг
+struct BulkAddReport {
+  int num_added{0};                      // кол-во добавленных книг
+  std::vector<RejectedRecord> rejected;  // отклоненные записи
+};
+
 // структура: магазин книг
 struct BookStore {
  public:
@@ -51,27 +98,350 @@ struct BookStore {
 
   /**
    * Добавление книги в хранилище магазина.
-   * При нехватке места в хранилище его объем увеличивается на kCapacityCoefficient.
+   * При нехватке места объем хранилища растет геометрически: в полтора раза,
+   * но не менее чем на kCapacityCoefficient, поэтому копирование книг при росте
+   * стоит амортизированно O(1) на книгу.
    *
    * @param book - книга, которую необходимо добавить в хранилище
+   * @return статус увеличения хранилища (при ошибке книга не добавляется и не журналируется)
+   */
+  ResizeStorageStatus AddBook(const Book &book);
+
+  /**
+   * Массовое добавление книг из сырых записей без выбрасывания исключений.
+   * Записи проверяются с помощью Book::TryCreate, некорректные записи пропускаются
+   * и возвращаются в отчете вместе с причиной отклонения.
+   * Если хранилище не удалось увеличить, добавление прекращается (см. num_added).
+   *
+   * @param records - пакет сырых записей книг
+   * @return отчет о добавлении
+   */
+  BulkAddReport AddBooks(const std::vector<BookRecord> &records);
+
+  /**
+   * Подключение журнала предзаписи: каждая добавляемая книга, удаление книги и новый автор
+   * книги сначала записываются в журнал. Удаления и авторы журналируются только для книг,
+   * добавленных через журнал (или восстановленных из него, см. WriteAheadLog::Replay).
+   * Магазин не владеет журналом, журнал должен существовать на протяжении работы магазина.
+   * При ошибке записи в журнал AddBook, RemoveBook и AddBookAuthor выбрасывают исключение,
+   * и магазин не изменяется.
+   *
+   * @param log - открытый журнал (nullptr - отключение журнала)
+   */
+  void AttachLog(WriteAheadLog *log);
+
+  /**
+   * Резервирование места в хранилище под заданное кол-во книг.
+   * Позволяет избежать многократного увеличения хранилища при массовом добавлении книг.
+   *
+   * @param capacity - требуемый объем хранилища
+   * @return статус изменения размера хранилища (SUCCESS, если объем уже достаточен)
+   */
+  ResizeStorageStatus Reserve(int capacity);
+
+  /**
+   * Добавление автора к книге, уже находящейся в хранилище (см. Book::AddAuthor).
+   * Поддерживает индексы по авторам в актуальном состоянии.
+   *
+   * @param index - позиция книги в хранилище
+   * @param author - добавляемый автор книги
+   * @return true - при успешном добавлении автора, false - в списке авторов обнаружен дубликат
+   */
+  bool AddBookAuthor(int index, const Author &author);
+
+  /**
+   * Удаление книги из магазина за O(1): позиция помечается надгробием,
+   * книга исключается из результатов поиска и обхода, а ее память высвобождается.
+   * Позиции остальных книг не меняются до уплотнения хранилища (см. CompactStep).
+   * Удаление фиксируется в журнале предзаписи (см. AttachLog).
+   *
+   * @param index - позиция книги в хранилище
+   * @return true - книга удалена, false - книга уже была удалена ранее
+   */
+  bool RemoveBook(int index);
+
+  /**
+   * Удаление всех книг, удовлетворяющих предикату (см. RemoveBook).
+   *
+   * @param predicate - предикат вида bool(const Book &)
+   * @return кол-во удаленных книг
+   */
+  int RemoveIf(const std::function<bool(const Book &)> &predicate);
+
+  /**
+   * Шаг уплотнения хранилища, обрабатывающий не более max_slots позиций.
+   * Уплотнение запускается при наличии удаленных книг и проходит фазы:
+   * сдвиг живых книг на место удаленных (с сохранением порядка), копирование в хранилище
+   * меньшего объема (если более половины хранилища пустует) и перестроение вторичных индексов.
+   * Между шагами магазин полностью работоспособен, поэтому большая чистка
+   * разбивается на короткие шаги без длительных пауз.
+   * Позиции книг меняются по мере сдвига, индексы при этом остаются корректными.
+   *
+   * @param max_slots - максимальное кол-во позиций, обрабатываемых за шаг (положительное)
+   * @return true - уплотнение не завершено (требуются еще шаги), false - уплотнение завершено
+   * @throw std::invalid_argument - неположительное max_slots
+   */
+  bool CompactStep(int max_slots);
+
+  /**
+   * Уплотнение хранилища целиком (шаги CompactStep до завершения).
+   */
+  void Compact();
+
+  /**
+   * Проверка, удалена ли книга на заданной позиции хранилища.
+   *
+   * @param index - позиция в хранилище
+   * @return true - на позиции находится надгробие удаленной книги
+   */
+  bool IsRemoved(int index) const;
+
+  /**
+   * Подсчет памяти, занимаемой книгами магазина, за один проход по хранилищу.
+   * Вторичные индексы и статистики не учитываются.
+   *
+   * @return разбивка памяти по категориям
    */
-  void AddBook(const Book &book);
+  MemoryBreakdown MemoryUsage() const;
+
+  /**
+   * Получение разбивки памяти за O(1) по счетчикам, которые обновляются
+   * при добавлении, изменении и удалении книг. Совпадает с результатом MemoryUsage.
+   *
+   * @return разбивка памяти по категориям
+   */
+  MemoryBreakdown GetMemoryUsage() const;
 
   // getters
   const std::string &GetName() const;
-  int GetSize() const;
+  int GetSize() const;      // кол-во живых книг (без надгробий)
+  int GetNumSlots() const;  // кол-во позиций хранилища, включая надгробия (граница обхода GetBooks)
+  int GetNumRemoved() const;
   int GetCapacity() const;
   const Book *GetBooks() const;
+  CompactionPhase GetCompactionPhase() const;
+
+  /**
+   * Поиск книг, название которых лежит в полуинтервале [from, to).
+   * Книги возвращаются в лексикографическом порядке названий.
+   *
+   * @param from - нижняя граница названия (включительно)
+   * @param to - верхняя граница названия (не включительно)
+   * @return позиции найденных книг в хранилище
+   */
+  std::vector<int> FindBooksByTitleRange(const std::string &from, const std::string &to) const;
+
+  /**
+   * Постраничный поиск книг по префиксу названия.
+   * Книги возвращаются в лексикографическом порядке названий.
+   *
+   * @param prefix - префикс названия книги
+   * @param offset - кол-во пропускаемых книг (начало страницы)
+   * @param limit - максимальное кол-во книг на странице
+   * @return позиции найденных книг в хранилище
+   */
+  std::vector<int> FindBooksByTitlePrefix(const std::string &prefix, int offset, int limit) const;
+
+  /**
+   * Поиск книг, у которых есть хотя бы один автор с возрастом из отрезка [min_age, max_age].
+   *
+   * @param min_age - минимальный возраст автора (включительно)
+   * @param max_age - максимальный возраст автора (включительно)
+   * @return позиции найденных книг в хранилище (по возрастанию, без повторов)
+   */
+  std::vector<int> FindBooksByAuthorAge(int min_age, int max_age) const;
+
+  /**
+   * Поиск книг автора по его полному имени за O(кол-во книг автора).
+   *
+   * @param full_name - полное имя автора
+   * @return отсортированный список позиций книг в хранилище
+   */
+  std::vector<int> FindBooksByAuthor(const std::string &full_name) const;
+
+  /**
+   * Поиск книг, написанных всеми перечисленными авторами совместно.
+   *
+   * @param full_names - полные имена соавторов
+   * @return отсортированный список позиций книг в хранилище
+   */
+  std::vector<int> FindBooksByCoAuthors(const std::vector<std::string> &full_names) const;
+
+  /**
+   * Нечеткий поиск книг по названию (с опечатками, без учета регистра латинских букв).
+   *
+   * @param title - название книги (возможно, с опечатками)
+   * @param max_distance - максимальное расстояние Левенштейна до названия
+   * @param limit - максимальное кол-во книг
+   * @return книги по возрастанию расстояния (при равенстве - по названию, затем по позиции)
+   */
+  std::vector<FuzzyBookMatch> FindBooksByFuzzyTitle(const std::string &title, int max_distance, int limit) const;
+
+  /**
+   * Нечеткий поиск авторов по полному имени (с опечатками, без учета регистра латинских букв).
+   *
+   * @param full_name - полное имя автора (возможно, с опечатками)
+   * @param max_distance - максимальное расстояние Левенштейна до имени
+   * @param limit - максимальное кол-во авторов
+   * @return авторы по возрастанию расстояния (при равенстве - по имени)
+   */
+  std::vector<FuzzyAuthorMatch> FindAuthorsByFuzzyName(const std::string &full_name, int max_distance, int limit) const;
+
+  /**
+   * Подсказки названий книг по префиксу при наборе текста за O(|prefix| + limit).
+   * Названия упорядочены по убыванию кол-ва книг с этим названием. Названия удаленных книг
+   * пропускаются, и недостающие подсказки добираются обходом поддерева (см. AutocompleteTrie).
+   *
+   * @param prefix - префикс названия (регистр латинских букв не важен)
+   * @param limit - максимальное кол-во подсказок
+   * @return названия книг
+   */
+  std::vector<std::string> SuggestTitles(const std::string &prefix, int limit) const;
+
+  /**
+   * Подсказки имен авторов по префиксу при наборе текста (см. SuggestTitles).
+   * Имена упорядочены по убыванию кол-ва книг автора.
+   *
+   * @param prefix - префикс полного имени (регистр латинских букв не важен)
+   * @param limit - максимальное кол-во подсказок
+   * @return полные имена авторов
+   */
+  std::vector<std::string> SuggestAuthors(const std::string &prefix, int limit) const;
+
+  /**
+   * Проверка наличия в магазине книги с заданным названием по индексу названий.
+   * С включенными фильтрами Блума (см. EnablePresenceFilters) большинство отрицательных
+   * проверок отсекается за O(|title|) без обращения к индексам.
+   * Одновременные вызовы (без изменения магазина) безопасны: статистика проверок ведется атомарными счетчиками.
+   *
+   * @param title - название книги
+   * @return true - в магазине есть (неудаленная) книга с таким названием
+   */
+  bool HasTitle(const std::string &title) const;
+
+  /**
+   * Проверка наличия в магазине книг автора (см. HasTitle; одновременные вызовы так же безопасны).
+   *
+   * @param full_name - полное имя автора
+   * @return true - в магазине есть (неудаленная) книга автора
+   */
+  bool HasAuthor(const std::string &full_name) const;
+
+  /**
+   * Включение фильтров Блума для HasTitle и HasAuthor (см. PresenceFilterAggregate).
+   * Фильтры выключены по умолчанию, поскольку удорожают добавление книг. Повторный вызов
+   * заменяет фильтры новыми (например, с другой вероятностью ложного срабатывания),
+   * статистика проверок при этом сбрасывается.
+   *
+   * @param false_positive_rate - вероятность ложного срабатывания, из (0, 1)
+   * @return фильтры (ссылка действительна до следующего вызова или до конца жизни магазина)
+   * @throw std::invalid_argument - вероятность вне (0, 1)
+   */
+  const PresenceFilterAggregate &EnablePresenceFilters(
+      double false_positive_rate = PresenceFilterAggregate::kFalsePositiveRate);
+
+  // статистика проверок наличия названий и авторов (см. HasTitle, HasAuthor; без фильтров - только num_queries)
+  BloomFilterStats GetTitleFilterStats() const;
+  BloomFilterStats GetAuthorFilterStats() const;
+
+  /**
+   * Точный поиск k самых плодовитых авторов (по убыванию кол-ва книг).
+   * Использует ограниченную кучу: O(A log k) времени и O(k) дополнительной памяти.
+   *
+   * @param k - максимальное кол-во авторов
+   * @return авторы и кол-во их книг
+   */
+  std::vector<AuthorBookCount> TopAuthorsByBookCount(int k) const;
+
+  /**
+   * Поиск k книг с наибольшим размером содержания (по убыванию размера).
+   *
+   * @param k - максимальное кол-во книг
+   * @return позиции книг в хранилище
+   */
+  std::vector<int> TopBooksByContentSize(int k) const;
+
+  /**
+   * Включение поиска почти совпадающих книг (см. FindNearDuplicates).
+   * Вычисляет MinHash-подписи содержания уже добавленных книг, после чего подписи вычисляются
+   * при добавлении книги. Поиск выключен по умолчанию, поскольку хэширование содержания
+   * удорожает добавление книг. Повторный вызов ничего не делает.
+   */
+  void EnableNearDuplicates();
+
+  // включен ли поиск почти совпадающих книг (см. EnableNearDuplicates)
+  bool IsNearDuplicatesEnabled() const;
+
+  /**
+   * Поиск групп книг с почти совпадающим содержанием (правки опечаток, другое оформление и т. п.).
+   * MinHash-подписи содержания вычислены заранее (см. EnableNearDuplicates), кандидаты отбираются
+   * по корзинам LSH (см. MinHashIndex), поэтому поиск почти линеен по кол-ву книг.
+   * Пары со сходством ниже MinHashIndex::GetThreshold() (~0.5 по умолчанию) становятся
+   * кандидатами редко, поэтому min_similarity имеет смысл выбирать выше этого порога.
+   *
+   * @param min_similarity - минимальная оценка сходства Жаккара шинглов содержания (от 0 до 1)
+   * @return группы позиций книг в хранилище (не менее двух книг в группе, по возрастанию позиций)
+   * @throw std::logic_error - поиск почти совпадающих книг не включен
+   */
+  std::vector<std::vector<int>> FindNearDuplicates(double min_similarity) const;
+
+  /**
+   * Оценка сходства содержания двух книг по их MinHash-подписям (см. FindNearDuplicates).
+   *
+   * @param lhs - позиция первой книги в хранилище
+   * @param rhs - позиция второй книги в хранилище
+   * @return оценка сходства Жаккара шинглов содержания (0 - для книг без слов в содержании)
+   * @throw std::invalid_argument - позиция вне хранилища
+   * @throw std::logic_error - поиск почти совпадающих книг не включен
+   */
+  double EstimateContentSimilarity(int lhs, int rhs) const;
+
+  /**
+   * Встроенные агрегаты каталога (кол-во книг по жанрам, издательствам, авторов по полу,
+   * суммарный размер содержания). Поддерживаются при добавлении, изменении и удалении книг,
+   * поэтому чтение стоит O(1) и не обращается к хранилищу.
+   *
+   * @return агрегаты по живым книгам
+   */
+  const CatalogAggregate &GetCatalogAggregate() const;
+
+  /**
+   * Регистрация пользовательского инкрементального агрегата (см. BookAggregate).
+   * Агрегат создается магазином, учитывает все живые книги на момент регистрации
+   * и далее обновляется при каждом добавлении, изменении и удалении книги.
+   * Необязательные статистики подключаются так же, чтобы не удорожать добавление книг
+   * без необходимости: например, AuthorHeavyHittersAggregate (приближенный top-K авторов)
+   * и GenrePublisherAggregate (top-K пар жанр-издательство).
+   *
+   * @tparam Aggregate - наследник BookAggregate
+   * @param args - аргументы конструктора агрегата
+   * @return агрегат (ссылка действительна на протяжении жизни магазина)
+   */
+  template <typename Aggregate, typename... Args>
+  Aggregate &RegisterAggregate(Args &&...args) {
+    static_assert(std::is_base_of_v<BookAggregate, Aggregate>, "Aggregate must derive from BookAggregate");
+
+    auto aggregate = std::make_unique<Aggregate>(std::forward<Args>(args)...);
+    Aggregate &result = *aggregate;
+
+    register_aggregate(std::move(aggregate));
+    return result;
+  }
 
   // === необходимо для тестов ===
   BookStore() = default;
   friend bool operator==(const BookStore &lhs, const BookStore &rhs);
   friend bool operator!=(const BookStore &lhs, const BookStore &rhs);
 
+  // журнал восстанавливает смещения записей книг (см. restore_log_offset)
+  friend struct WriteAheadLog;
+
  public:
   // константы (при желании, вы можете изменить их значения)
   static constexpr int kCapacityCoefficient = 5;   // коэффициент увеличения размера хранилища книг
   static constexpr int kInitStorageCapacity = 10;  // изначальный объем хранилища книг
+  static constexpr int kRemovedId = -1;              // идентификатор надгробия (удаленной книги)
+  static constexpr long long kNoLogOffset = -1;      // книга добавлена без журнала
 
  private:
   // поля структуры
@@ -79,19 +449,133 @@ struct BookStore {
   int storage_size_{0};      // кол-во книг в хранилище магазина
   int storage_capacity_{0};  // объем хранилища
   Book *storage_{nullptr};   // динамический массив - хранилище
+  WriteAheadLog *log_{nullptr};  // журнал предзаписи (необязательный)
+
+  // вторичные индексы (хранят идентификаторы книг, которые не меняются при уплотнении)
+  struct SecondaryIndexes {
+    OrderedIndex<std::string> titles;  // название -> книга
+    OrderedIndex<int> author_ages;     // возраст автора -> книга
+    AuthorIndex authors;               // имя автора -> книги
+    FuzzyIndex title_dictionary;       // различные названия для нечеткого поиска
+    FuzzyIndex author_dictionary;      // различные имена авторов для нечеткого поиска
+    AutocompleteTrie title_completions;   // подсказки названий
+    AutocompleteTrie author_completions;  // подсказки имен авторов
+    MinHashIndex content_signatures;      // подписи содержания (только при включенном поиске дубликатов)
+
+    void InsertTitle(const std::string &title, int id);
+    void InsertAuthor(const Author &author, int id);
+  };
+
+  // счетчики проверок наличия (атомарные: HasTitle и HasAuthor - константные читатели,
+  // которые могут вызываться параллельно, например из ShardedBookStore)
+  struct FilterCounters {
+    std::atomic<long long> num_queries{0};
+    std::atomic<long long> num_negatives{0};
+    std::atomic<long long> num_false_positives{0};
+
+    BloomFilterStats Load() const;
+    void Reset();
+  };
+
+  // состояние пошагового уплотнения хранилища
+  struct CompactionState {
+    CompactionPhase phase{CompactionPhase::IDLE};
+    int read{0};                        // курсор чтения (следующая обрабатываемая позиция)
+    int write{0};                       // курсор записи (фаза MOVING)
+    Book *shrunk_storage{nullptr};      // хранилище меньшего объема (фаза SHRINKING)
+    int shrunk_capacity{0};             // объем хранилища меньшего объема
+    SecondaryIndexes indexes;           // перестраиваемые индексы (фаза REINDEXING)
+    std::vector<int> book_ids;          // новые идентификаторы книг (совпадают с позициями)
+  };
+
+  SecondaryIndexes indexes_;
+  std::vector<int> book_ids_;      // позиция -> идентификатор книги (kRemovedId - надгробие)
+  std::vector<int> id_positions_;  // идентификатор -> позиция книги (kRemovedId - книга удалена)
+  std::vector<long long> log_offsets_;  // позиция -> смещение записи книги в журнале (kNoLogOffset - нет)
+  int num_removed_{0};             // кол-во надгробий в хранилище
+  MemoryBreakdown book_memory_;    // память данных живых книг (без массива книг)
+  CompactionState compaction_;
+
+  // фильтры Блума для быстрых отрицательных проверок наличия (агрегат из aggregates_, nullptr - выключены)
+  const PresenceFilterAggregate *presence_filters_{nullptr};
+  mutable FilterCounters title_filter_stats_;   // статистика HasTitle
+  mutable FilterCounters author_filter_stats_;  // статистика HasAuthor
+  bool is_near_duplicates_enabled_{false};      // подписи содержания вычисляются (см. EnableNearDuplicates)
+
+  // инкрементальные агрегаты по живым книгам
+  CatalogAggregate catalog_;                                 // встроенные агрегаты
+  std::vector<std::unique_ptr<BookAggregate>> aggregates_;  // пользовательские агрегаты
 
   // приватный метод для увеличения объема хранилища
   ResizeStorageStatus resize_storage_internal(int new_capacity);
+
+  // приватный метод для расчета объема хранилища при его заполнении (геометрический рост)
+  int grown_capacity() const;
+
+  // приватный метод для запоминания смещения записи книги в журнале (восстановление из журнала)
+  void restore_log_offset(int index, long long offset);
+
+  // приватный метод для добавления книги из хранилища во вторичные индексы и статистики
+  void index_book(int index);
+
+  // приватный метод для добавления автора книги из хранилища в индексы по авторам
+  void index_author(int index, const Author &author);
+
+  // приватный метод для регистрации агрегата с учетом всех живых книг
+  void register_aggregate(std::unique_ptr<BookAggregate> aggregate);
+
+  // приватные методы для учета книги во всех агрегатах
+  void aggregate_add(const Book &book);
+  void aggregate_remove(const Book &book);
+  void aggregate_relocated();
+
+  // приватный метод для вычисления недостающей подписи содержания книги (см. EnableNearDuplicates)
+  void sign_content(int index);
+
+  // приватный метод для пересчета агрегатов, запросивших его (см. BookAggregate::NeedsRebuild)
+  void rebuild_aggregates();
+
+  // приватный метод для учета памяти массива книг (включая хранилище меньшего объема при уплотнении)
+  void account_slots(MemoryBreakdown &usage) const;
+
+  // приватный метод для проверки, остались ли в индексах записи удаленных книг
+  bool has_removed_ids() const;
+
+  // приватные методы для проверки наличия живых книг с названием (автором)
+  bool has_books_with_title(const std::string &title) const;
+  bool has_books_by_author(const std::string &full_name) const;
+
+  // приватный метод для перевода идентификаторов книг в позиции (удаленные книги пропускаются)
+  std::vector<int> to_positions(const std::vector<int> &ids) const;
+
+  // приватные методы для смены фаз уплотнения
+  void finish_moving();
+  void finish_shrinking();
+  void finish_reindexing();
+
+  // приватный метод для отмены фазы SHRINKING (хранилище меньшего объема переполнено)
+  void cancel_shrinking();
+
+  // приватный метод для переноса изменения книги в хранилище меньшего объема
+  void sync_shrunk_slot(int index);
 };
 
 // === необходимо для тестов ===
 
 inline bool operator==(const BookStore &lhs, const BookStore &rhs) {
   if (lhs.name_ != rhs.name_) return false;
-  if (lhs.storage_size_ != rhs.storage_size_) return false;
+  if (lhs.storage_size_ - lhs.num_removed_ != rhs.storage_size_ - rhs.num_removed_) return false;
+
+  // сравниваются только живые книги (в порядке расположения в хранилище)
+  int lhs_index = 0;
+  int rhs_index = 0;
+
+  while (true) {
+    while (lhs_index < lhs.storage_size_ && lhs.book_ids_[lhs_index] == BookStore::kRemovedId) lhs_index++;
+    while (rhs_index < rhs.storage_size_ && rhs.book_ids_[rhs_index] == BookStore::kRemovedId) rhs_index++;
 
-  for (int index = 0; index < lhs.storage_size_; index++) {
-    if (lhs.storage_[index] != rhs.storage_[index]) return false;
+    if (lhs_index == lhs.storage_size_ || rhs_index == rhs.storage_size_) break;
+    if (lhs.storage_[lhs_index++] != rhs.storage_[rhs_index++]) return false;
   }
   return true;
 }
@@ -103,4 +587,6 @@ inline bool operator!=(const BookStore &lhs, const BookStore &rhs) {
 // внутренние проверки на этапе компиляции (не обращайте внимания)
 static_assert(BookStore::kInitStorageCapacity >= 1);
 static_assert(BookStore::kCapacityCoefficient >= 1);
+static_assert(BookStore::kRemovedId < 0);
+static_assert(BookStore::kNoLogOffset < 0);
 static_assert(static_cast<int>(ResizeStorageStatus::NEGATIVE_SIZE) == 3);
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>  // move
+
+/**
+ * Потокобезопасная очередь ограниченного размера для конвейеров производитель/потребитель.
+ * Производители блокируются при заполнении очереди, потребители - при ее опустошении.
+ * После закрытия очереди новые элементы не принимаются, а оставшиеся можно дочитать.
+ *
+ * @tparam T - тип элемента очереди
+ */
+template <typename T>
+struct BoundedQueue {
+ public:
+  /**
+   * Создает пустую очередь.
+   *
+   * @param capacity - максимальное кол-во элементов в очереди
+   */
+  explicit BoundedQueue(int capacity) : capacity_{capacity > 0 ? capacity : 1} {}
+
+  /**
+   * Добавление элемента в очередь (с ожиданием свободного места).
+   *
+   * @param value - добавляемый элемент
+   * @return true - элемент добавлен, false - очередь закрыта
+   */
+  bool Push(T value) {
+    std::unique_lock lock(mutex_);
+    not_full_.wait(lock, [this] { return closed_ || static_cast<int>(items_.size()) < capacity_; });
+
+    if (closed_) {
+      return false;
+    }
+
+    items_.push_back(std::move(value));
+    lock.unlock();
+    not_empty_.notify_one();
+
+    return true;
+  }
+
+  /**
+   * Извлечение элемента из очереди (с ожиданием появления элемента).
+   *
+   * @param value - извлеченный элемент
+   * @return true - элемент извлечен, false - очередь закрыта и пуста
+   */
+  bool Pop(T &value) {
+    std::unique_lock lock(mutex_);
+    not_empty_.wait(lock, [this] { return closed_ || !items_.empty(); });
+
+    if (items_.empty()) {
+      return false;
+    }
+
+    value = std::move(items_.front());
+    items_.pop_front();
+    lock.unlock();
+    not_full_.notify_one();
+
+    return true;
+  }
+
+  // закрытие очереди: пробуждает всех ожидающих производителей и потребителей
+  void Close() {
+    {
+      std::lock_guard lock(mutex_);
+      closed_ = true;
+    }
+    not_full_.notify_all();
+    not_empty_.notify_all();
+  }
+
+  int GetCapacity() const {
+    return capacity_;
+  }
+
+ private:
+  const int capacity_;                 // максимальное кол-во элементов
+  std::deque<T> items_;                // элементы очереди
+  bool closed_{false};                 // признак закрытия очереди
+  std::mutex mutex_;                   // защищает items_ и closed_
+  std::condition_variable not_full_;   // ожидание свободного места
+  std::condition_variable not_empty_;  // ожидание элементов
+};
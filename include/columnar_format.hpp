@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "book.hpp"
+
+struct BookStore;
+
+// перечисление: статус колоночного экспорта или импорта
+enum class ColumnarStatus {
+  SUCCESS,          // операция прошла успешно
+  WRITE_FAILED,     // не удалось записать данные в поток
+  READ_FAILED,      // поток оборвался или не является колоночным представлением
+  CORRUPTED_BATCH,  // буферы пакета несогласованы (смещения вне данных, неизвестные значения перечислений)
+  STORE_FAILED      // магазин не принял книгу (не удалось увеличить хранилище, см. BookStore::AddBook)
+};
+
+/**
+ * Пакет книг в колоночном представлении (по образцу Apache Arrow).
+ *
+ * Перечисления хранятся байтовыми столбцами, строки - буфером смещений (num_rows + 1 значений)
+ * и буфером данных, список авторов - столбцом смещений в дочерние столбцы авторов.
+ * Поля i-й книги: title_data[title_offsets[i], title_offsets[i + 1]), авторы -
+ * [author_offsets[i], author_offsets[i + 1]) в столбцах author_*.
+ */
+struct RecordBatch {
+ public:
+  int num_rows{0};
+
+  std::vector<std::uint8_t> genres;       // жанры
+  std::vector<std::uint8_t> publishers;   // издательства
+  std::vector<std::int32_t> title_offsets{0};
+  std::string title_data;
+  std::vector<std::int32_t> content_offsets{0};
+  std::string content_data;
+
+  // столбец-список авторов и дочерние столбцы
+  std::vector<std::int32_t> author_offsets{0};
+  std::vector<std::int32_t> author_name_offsets{0};
+  std::string author_name_data;
+  std::vector<std::int32_t> author_ages;
+  std::vector<std::uint8_t> author_sexes;
+
+  /**
+   * Добавление книги в конец пакета.
+   *
+   * @param book - книга
+   */
+  void Append(const Book &book);
+
+  /**
+   * Проверка согласованности буферов (размеры столбцов, монотонность смещений, значения перечислений).
+   *
+   * @return true - пакет корректен
+   */
+  bool Validate() const;
+
+  /**
+   * Сборка книги из строки пакета (пакет должен быть корректен, см. Validate).
+   *
+   * @param row - номер строки
+   * @return книга (некорректные поля остаются по умолчанию, как в decode_book)
+   */
+  Book MakeBook(int row) const;
+
+  // поля строки пакета без копирования
+  std::string_view GetTitle(int row) const;
+  std::string_view GetContent(int row) const;
+  std::string_view GetAuthorName(int author) const;
+
+  // очистка пакета с сохранением выделенной памяти буферов (для повторного использования)
+  void Clear();
+};
+
+/**
+ * Потоковый экспорт магазина в колоночное представление.
+ * Книги выгружаются пакетами по batch_rows строк через один переиспользуемый пакет,
+ * поэтому дополнительная память ограничена размером пакета. Удаленные книги пропускаются.
+ *
+ * Формат потока: сигнатура, затем пакеты [кол-во строк][буферы столбцов с длинами в байтах],
+ * завершающий пакет из нуля строк. Числа записываются в порядке байтов платформы.
+ *
+ * @param store - книжный магазин
+ * @param out - поток вывода (двоичный)
+ * @param batch_rows - кол-во книг в пакете
+ * @return статус операции
+ */
+ColumnarStatus export_columnar(const BookStore &store, std::ostream &out, int batch_rows = 4096);
+
+/**
+ * Импорт книг из колоночного представления в магазин (см. export_columnar).
+ * Буферы пакета читаются целиком, книги собираются из срезов буферов без разбора полей.
+ * При ошибке книги из предыдущих корректных пакетов (и уже добавленные книги текущего пакета)
+ * остаются в магазине.
+ *
+ * @param in - поток ввода (двоичный)
+ * @param store - книжный магазин, в который добавляются книги
+ * @param num_imported - кол-во добавленных книг, в том числе при ошибке (может быть nullptr)
+ * @return статус операции
+ */
+ColumnarStatus import_columnar(std::istream &in, BookStore &store, int *num_imported = nullptr);
+
+/**
+ * Запись пакета в поток (сигнатура потока записывается перед первым пакетом отдельно, см. write_columnar_header).
+ *
+ * @param batch - пакет
+ * @param out - поток вывода
+ * @return статус операции
+ */
+ColumnarStatus write_record_batch(const RecordBatch &batch, std::ostream &out);
+
+/**
+ * Чтение очередного пакета из потока. Пакет из нуля строк означает конец потока.
+ *
+ * @param in - поток ввода
+ * @param batch - пакет (буферы переиспользуются)
+ * @return статус операции
+ */
+ColumnarStatus read_record_batch(std::istream &in, RecordBatch &batch);
+
+// запись и проверка сигнатуры колоночного потока
+ColumnarStatus write_columnar_header(std::ostream &out);
+ColumnarStatus read_columnar_header(std::istream &in);
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>  // remove_if
+#include <cstdint>
+#include <vector>
+
+#include "book.hpp"
+#include "book_store.hpp"
+
+/**
+ * Битовая маска множества значений перечисления, вычисляемая на этапе компиляции.
+ *
+ * Пример: enum_mask_v<Genre::HORROR, Genre::THRILLER>
+ */
+template <auto... Values>
+inline constexpr std::uint32_t enum_mask_v = ((std::uint32_t{1} << static_cast<unsigned>(Values)) | ... | 0u);
+
+// маска, пропускающая все значения перечисления
+inline constexpr std::uint32_t kAnyEnumValue = ~std::uint32_t{0};
+
+/**
+ * Специализированное ядро фильтрации книг по жанру и издательству.
+ *
+ * Маски известны на этапе компиляции, поэтому для каждой комбинации фильтров
+ * инстанцируется свой цикл без ветвлений: проверка сводится к сдвигу и логическому И
+ * с константой, а позиция подходящей книги записывается безусловно.
+ * Фильтр, пропускающий все значения, исключается из цикла полностью.
+ *
+ * @tparam GenreMask - маска допустимых жанров (см. enum_mask_v)
+ * @tparam PublisherMask - маска допустимых издательств (см. enum_mask_v)
+ */
+template <std::uint32_t GenreMask, std::uint32_t PublisherMask = kAnyEnumValue>
+struct EnumFilterKernel {
+ public:
+  // проверка одной книги (без ветвлений)
+  static constexpr std::uint32_t Matches(Genre genre, Publisher publisher) {
+    std::uint32_t match = 1u;
+
+    if constexpr (GenreMask != kAnyEnumValue) {
+      match &= GenreMask >> static_cast<unsigned>(genre);
+    }
+    if constexpr (PublisherMask != kAnyEnumValue) {
+      match &= PublisherMask >> static_cast<unsigned>(publisher);
+    }
+
+    return match & 1u;
+  }
+
+  /**
+   * Подсчет подходящих книг.
+   *
+   * @param store - книжный магазин
+   * @return кол-во подходящих книг
+   */
+  static int Count(const BookStore &store) {
+    const Book *books = store.GetBooks();
+    const int size = store.GetNumSlots();
+
+    int count = 0;
+
+    for (int index = 0; index < size; index++) {
+      count += static_cast<int>(Matches(books[index].GetGenre(), books[index].GetPublisher()));
+    }
+
+    // надгробия редки, поэтому они вычитаются отдельным проходом, а основной цикл остается без ветвлений
+    if (store.GetNumRemoved() > 0) {
+      for (int index = 0; index < size; index++) {
+        if (store.IsRemoved(index)) {
+          count -= static_cast<int>(Matches(books[index].GetGenre(), books[index].GetPublisher()));
+        }
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * Сбор позиций подходящих книг.
+   *
+   * @param store - книжный магазин
+   * @return позиции подходящих книг в хранилище
+   */
+  static std::vector<int> Collect(const BookStore &store) {
+    const Book *books = store.GetBooks();
+    const int size = store.GetNumSlots();
+
+    // запись без ветвлений: позиция пишется всегда, а счетчик сдвигается только при совпадении
+    std::vector<int> indices(static_cast<std::size_t>(size) + 1);
+    int count = 0;
+
+    for (int index = 0; index < size; index++) {
+      indices[count] = index;
+      count += static_cast<int>(Matches(books[index].GetGenre(), books[index].GetPublisher()));
+    }
+
+    indices.resize(count);
+
+    if (store.GetNumRemoved() > 0) {
+      indices.erase(std::remove_if(indices.begin(), indices.end(), [&store](int index) { return store.IsRemoved(index); }),
+                    indices.end());
+    }
+
+    return indices;
+  }
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(enum_mask_v<Genre::ACTION_AND_ADVENTURE, Genre::CLASSIC> == 0b11u);
+static_assert(enum_mask_v<Publisher::UNDEFINED> == 1u << static_cast<int>(Publisher::UNDEFINED));
+static_assert(EnumFilterKernel<enum_mask_v<Genre::HORROR>>::Matches(Genre::HORROR, Publisher::USA) == 1u);
+static_assert(EnumFilterKernel<enum_mask_v<Genre::HORROR>>::Matches(Genre::DRAMA, Publisher::USA) == 0u);
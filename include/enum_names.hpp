@@ -0,0 +1,169 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "author.hpp"  // Sex
+#include "book.hpp"    // Genre, Publisher
+
+/**
+ * Текстовые имена значений перечисления (совпадают с именами перечислителей).
+ * Порядок имен совпадает с порядком значений перечисления.
+ *
+ * @tparam Enum - перечисление
+ */
+template <typename Enum>
+struct EnumNames;
+
+template <>
+struct EnumNames<Genre> {
+  static constexpr std::array<std::string_view, static_cast<int>(Genre::UNDEFINED) + 1> kNames = {
+      "ACTION_AND_ADVENTURE", "CLASSIC", "DRAMA", "FANTASY", "SCI_FI", "HORROR", "ROMANCE",
+      "ADULT", "THRILLER", "BIOGRAPHY", "HISTORY", "POETRY", "UNDEFINED"};
+};
+
+template <>
+struct EnumNames<Publisher> {
+  static constexpr std::array<std::string_view, static_cast<int>(Publisher::UNDEFINED) + 1> kNames = {
+      "USA", "RUS", "ENG", "AUS", "UNDEFINED"};
+};
+
+template <>
+struct EnumNames<Sex> {
+  static constexpr std::array<std::string_view, static_cast<int>(Sex::UNDEFINED) + 1> kNames = {
+      "MALE", "FEMALE", "UNDEFINED"};
+};
+
+namespace enum_names::detail {
+
+constexpr char to_lower(char symbol) {
+  return symbol >= 'A' && symbol <= 'Z' ? static_cast<char>(symbol | 0x20) : symbol;
+}
+
+// хэш FNV-1a строки в нижнем регистре с затравкой
+constexpr std::uint32_t hash(std::string_view text, std::uint32_t seed) {
+  std::uint32_t value = 2166136261u ^ seed;
+
+  for (char symbol: text) {
+    value = (value ^ static_cast<unsigned char>(to_lower(symbol))) * 16777619u;
+  }
+
+  return value;
+}
+
+constexpr bool equals_ignore_case(std::string_view lhs, std::string_view rhs) {
+  if (lhs.size() != rhs.size()) return false;
+
+  for (std::size_t index = 0; index < lhs.size(); index++) {
+    if (to_lower(lhs[index]) != to_lower(rhs[index])) return false;
+  }
+
+  return true;
+}
+
+// наименьшая степень двойки, не меньшая value
+constexpr std::size_t ceil_pow2(std::size_t value) {
+  std::size_t result = 1;
+  while (result < value) result *= 2;
+  return result;
+}
+
+/**
+ * Совершенная хэш-таблица имен перечисления, построенная на этапе компиляции.
+ * Затравка хэша подбирается перебором так, чтобы имена попали в различные ячейки
+ * таблицы вдвое большего размера, поэтому поиск - один хэш и одно сравнение строк.
+ *
+ * @tparam Enum - перечисление (см. EnumNames)
+ */
+template <typename Enum>
+struct PerfectHashTable {
+  static constexpr auto &kNames = EnumNames<Enum>::kNames;
+  static constexpr std::size_t kNumSlots = ceil_pow2(2 * kNames.size());
+  static constexpr std::uint32_t kMaxSeed = 1u << 16;
+  static constexpr std::int8_t kEmptySlot = -1;
+
+  // подбор затравки без коллизий (kMaxSeed - затравка не найдена)
+  static constexpr std::uint32_t find_seed() {
+    for (std::uint32_t seed = 0; seed < kMaxSeed; seed++) {
+      std::array<bool, kNumSlots> is_used{};
+      bool is_perfect = true;
+
+      for (std::size_t index = 0; index < kNames.size() && is_perfect; index++) {
+        const std::size_t slot = hash(kNames[index], seed) & (kNumSlots - 1);
+        is_perfect = !is_used[slot];
+        is_used[slot] = true;
+      }
+
+      if (is_perfect) return seed;
+    }
+
+    return kMaxSeed;
+  }
+
+  // ячейка -> значение перечисления (kEmptySlot - пустая ячейка)
+  static constexpr std::array<std::int8_t, kNumSlots> build_slots() {
+    std::array<std::int8_t, kNumSlots> slots{};
+
+    for (auto &slot: slots) slot = kEmptySlot;
+
+    for (std::size_t index = 0; index < kNames.size(); index++) {
+      slots[hash(kNames[index], kSeed) & (kNumSlots - 1)] = static_cast<std::int8_t>(index);
+    }
+
+    return slots;
+  }
+
+  static constexpr std::uint32_t kSeed = find_seed();
+  static constexpr std::array<std::int8_t, kNumSlots> kSlots = build_slots();
+
+  static_assert(kSeed < kMaxSeed, "Perfect hash seed for the enumeration names is not found");
+  static_assert(kNames.size() < 128, "Enumeration values must fit into std::int8_t");
+};
+
+}  // namespace enum_names::detail
+
+/**
+ * Преобразование значения перечисления в текст без выделения памяти.
+ *
+ * @param value - значение перечисления (Genre, Publisher, Sex)
+ * @return имя значения (пустая строка для значений вне перечисления)
+ */
+template <typename Enum>
+constexpr std::string_view format_enum(Enum value) {
+  constexpr auto &kNames = EnumNames<Enum>::kNames;
+
+  const auto index = static_cast<std::size_t>(value);
+  return index < kNames.size() ? kNames[index] : std::string_view{};
+}
+
+/**
+ * Преобразование текста в значение перечисления без учета регистра латинских букв
+ * и без выделения памяти: O(|text|) по совершенной хэш-таблице, построенной при компиляции.
+ *
+ * @param text - имя значения (например, "sci_fi" или "Horror")
+ * @param value - значение перечисления (не меняется, если имя не распознано)
+ * @return true - имя распознано, false - неизвестное имя
+ */
+template <typename Enum>
+constexpr bool parse_enum(std::string_view text, Enum &value) {
+  using Table = enum_names::detail::PerfectHashTable<Enum>;
+
+  const std::int8_t index = Table::kSlots[enum_names::detail::hash(text, Table::kSeed) & (Table::kNumSlots - 1)];
+
+  if (index == Table::kEmptySlot || !enum_names::detail::equals_ignore_case(text, Table::kNames[index])) {
+    return false;
+  }
+
+  value = static_cast<Enum>(index);
+  return true;
+}
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(EnumNames<Genre>::kNames.size() == static_cast<int>(Genre::UNDEFINED) + 1);
+static_assert(EnumNames<Publisher>::kNames.size() == static_cast<int>(Publisher::UNDEFINED) + 1);
+static_assert(EnumNames<Sex>::kNames.size() == static_cast<int>(Sex::UNDEFINED) + 1);
+static_assert(format_enum(Genre::SCI_FI) == "SCI_FI" && format_enum(Publisher::UNDEFINED) == "UNDEFINED");
+static_assert([] { auto genre = Genre::UNDEFINED; return parse_enum("sci_fi", genre) && genre == Genre::SCI_FI; }());
+static_assert([] { auto sex = Sex::UNDEFINED; return parse_enum("Female", sex) && sex == Sex::FEMALE; }());
+static_assert([] { auto publisher = Publisher::UNDEFINED; return !parse_enum("Mars", publisher); }());
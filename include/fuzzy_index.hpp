@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Расстояние Левенштейна между строками без учета регистра латинских букв.
+ * Для строк до 64 символов используется бит-параллельный алгоритм Майерса (O(n) машинных слов),
+ * для более длинных - динамическое программирование. Вычисление прекращается досрочно,
+ * как только расстояние заведомо превышает max_distance.
+ *
+ * @param lhs - первая строка
+ * @param rhs - вторая строка
+ * @param max_distance - максимальное интересующее расстояние
+ * @return расстояние или max_distance + 1, если расстояние больше max_distance
+ */
+int edit_distance(std::string_view lhs, std::string_view rhs, int max_distance);
+
+// структура: строка словаря, найденная нечетким поиском
+struct FuzzyMatch {
+  const std::string *text{nullptr};  // строка словаря
+  int distance{0};                   // расстояние Левенштейна до запроса
+};
+
+/**
+ * Словарь строк для нечеткого поиска (названия книг, имена авторов).
+ *
+ * Кандидаты отбираются по индексу триграмм: строка на расстоянии не более k
+ * содержит хотя бы T - 3k различных триграмм запроса (T - кол-во различных триграмм запроса),
+ * поскольку каждая правка разрушает не более трех триграмм. Кандидаты проверяются
+ * вычислением расстояния (см. edit_distance). Если порог отбора не положителен
+ * (короткий запрос или большое k), проверяются все строки подходящей длины.
+ */
+struct FuzzyIndex {
+ public:
+  FuzzyIndex() = default;
+
+  // список строк ссылается на ключи хеш-таблицы, поэтому словарь только перемещается
+  FuzzyIndex(const FuzzyIndex &) = delete;
+  FuzzyIndex(FuzzyIndex &&) noexcept = default;
+  FuzzyIndex &operator=(const FuzzyIndex &) = delete;
+  FuzzyIndex &operator=(FuzzyIndex &&) noexcept = default;
+
+  /**
+   * Добавление строки в словарь (повторное добавление игнорируется).
+   *
+   * @param text - строка
+   */
+  void Insert(const std::string &text);
+
+  /**
+   * Поиск строк словаря на расстоянии не более max_distance от запроса.
+   *
+   * @param query - запрос
+   * @param max_distance - максимальное расстояние Левенштейна
+   * @return найденные строки по возрастанию расстояния (при равенстве - лексикографически)
+   */
+  std::vector<FuzzyMatch> Search(std::string_view query, int max_distance) const;
+
+  // кол-во строк в словаре
+  int GetSize() const;
+
+  // высвобождение памяти, занимаемой словарем
+  void Clear();
+
+ private:
+  std::unordered_map<std::string, int> term_ids_;                  // строка -> идентификатор
+  std::vector<const std::string *> terms_;                         // идентификатор -> строка (ключ словаря)
+  std::unordered_map<std::uint32_t, std::vector<int>> trigrams_;   // триграмма -> идентификаторы строк (по возрастанию)
+};
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "book.hpp"
+
+// перечисление: статус операции с отображаемым в память хранилищем
+enum class MappedStatus {
+  SUCCESS,         // операция прошла успешно
+  NOT_OPEN,        // хранилище не открыто
+  OPEN_FAILED,     // не удалось открыть или создать файл
+  RESIZE_FAILED,   // не удалось увеличить файл или его отображение (ftruncate, mmap, mremap)
+  SYNC_FAILED,     // не удалось сбросить данные на диск (msync)
+  CORRUPTED_FILE   // файл не является хранилищем книг или поврежден
+};
+
+/**
+ * Файл, целиком отображенный в память (mmap) для чтения и записи.
+ *
+ * Файл растет через ftruncate (разреженно - новые страницы не занимают место на диске до записи),
+ * а отображение - через mremap: страницы не копируются, меняются только таблицы страниц.
+ * Какие страницы находятся в памяти, решает страничный кэш ОС, поэтому файл может быть
+ * больше физической памяти. Указатели на данные становятся недействительными после Grow.
+ */
+struct MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  // снимает отображение и закрывает файл
+  ~MappedFile();
+
+  /**
+   * Открытие (или создание) файла и отображение его содержимого в память.
+   *
+   * @param path - путь к файлу
+   * @return статус операции
+   */
+  MappedStatus Open(const std::string &path);
+
+  /**
+   * Увеличение файла и его отображения до заданного размера (уменьшение не выполняется).
+   *
+   * @param size - новый размер в байтах
+   * @return статус операции
+   */
+  MappedStatus Grow(std::size_t size);
+
+  // синхронная запись измененных страниц на диск (msync)
+  MappedStatus Sync();
+
+  // снятие отображения и закрытие файла
+  void Close();
+
+  // getters
+  bool IsOpen() const;
+  char *GetData();
+  const char *GetData() const;
+  std::size_t GetSize() const;
+
+ private:
+  int fd_{-1};               // файловый дескриптор
+  char *data_{nullptr};      // начало отображения (nullptr для пустого файла)
+  std::size_t size_{0};      // размер файла и отображения в байтах
+};
+
+/**
+ * Хранилище книг в файлах, отображенных в память, для каталогов больше оперативной памяти.
+ *
+ * Книги кодируются (см. encode_book) в кучу строк - файл <path>.heap, а в файле <path>
+ * после заголовка хранится таблица записей фиксированного размера (смещение и размер книги в куче),
+ * поэтому доступ к книге по номеру - O(1). Оба файла растут геометрически без копирования данных
+ * (см. MappedFile), а сами данные в куче процесса не хранятся - только буфер кодирования одной книги.
+ * Книги хранятся в порядке добавления; удаление и вторичные индексы не поддерживаются
+ * (для них предназначен BookStore).
+ */
+struct MappedBookStore {
+ public:
+  MappedBookStore() = default;
+  MappedBookStore(const MappedBookStore &) = delete;
+  MappedBookStore &operator=(const MappedBookStore &) = delete;
+
+  // сбрасывает заголовок и закрывает файлы (без msync - данные остаются в страничном кэше ОС)
+  ~MappedBookStore();
+
+  /**
+   * Открытие существующего хранилища или создание нового.
+   *
+   * @param path - путь к файлу таблицы записей (куча строк - в файле path + ".heap")
+   * @return статус операции
+   */
+  MappedStatus Open(const std::string &path);
+
+  /**
+   * Добавление книги в конец хранилища.
+   *
+   * @param book - добавляемая книга
+   * @return статус операции
+   */
+  MappedStatus AddBook(const Book &book);
+
+  /**
+   * Чтение книги по номеру (книга декодируется из отображения).
+   *
+   * @param index - номер книги
+   * @param book - прочитанная книга
+   * @return статус операции (CORRUPTED_FILE - запись книги повреждена)
+   */
+  MappedStatus GetBook(int index, Book &book) const;
+
+  /**
+   * Название книги без декодирования и копирования.
+   * Строка указывает в отображение и действительна до следующего AddBook или Close.
+   *
+   * @param index - номер книги
+   * @return название книги
+   */
+  std::string_view GetTitle(int index) const;
+
+  // синхронная запись таблицы записей и кучи на диск
+  MappedStatus Sync();
+
+  // закрытие файлов хранилища
+  void Close();
+
+  // getters
+  bool IsOpen() const;
+  int GetSize() const;
+  int GetCapacity() const;
+  std::size_t GetHeapSize() const;
+  std::size_t GetHeapCapacity() const;
+
+ public:
+  static constexpr int kInitCapacity = 1024;                   // изначальная вместимость таблицы записей
+  static constexpr std::size_t kInitHeapCapacity = 1u << 20;  // изначальный объем кучи строк (в байтах)
+
+ private:
+  // заголовок файла таблицы записей
+  struct Header {
+    char magic[8];             // сигнатура хранилища
+    std::uint64_t num_books;   // кол-во книг
+    std::uint64_t heap_size;   // занятый объем кучи строк
+    std::uint64_t reserved;
+  };
+
+  // запись о книге в таблице
+  struct Slot {
+    std::uint64_t offset;      // смещение представления книги в куче
+    std::uint32_t size;        // размер представления
+    std::uint32_t title_size;  // длина названия (название - первое поле представления)
+  };
+
+  MappedFile slots_;   // заголовок и таблица записей
+  MappedFile heap_;    // куча строк (закодированные книги)
+
+  int num_books_{0};         // кол-во книг
+  std::size_t heap_size_{0};  // занятый объем кучи строк
+
+  std::string buffer_;  // буфер кодирования книги (переиспользуется)
+
+  // приватные методы доступа к отображению таблицы
+  Header &header();
+  const Slot &slot(int index) const;
+
+  // приватный метод для создания пустого хранилища
+  MappedStatus initialize();
+
+  // приватный метод для проверки заголовка и записей существующего хранилища
+  bool validate();
+
+  // приватный метод для геометрического роста файла до требуемого размера
+  static MappedStatus reserve(MappedFile &file, std::size_t size);
+
+  // приватный метод для проверки номера книги
+  void check_index(int index) const;
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(MappedBookStore::kInitCapacity > 0);
+static_assert(MappedBookStore::kInitHeapCapacity > 0);
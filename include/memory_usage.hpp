@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>  // size_t
+#include <string>
+
+/**
+ * Разбивка памяти, занимаемой книгами, по категориям (в байтах).
+ *
+ * Короткие строки хранятся внутри объекта std::string (SSO) и не требуют памяти в куче,
+ * поэтому их символы учитываются отдельно и не входят в GetTotal (они уже входят в размер объекта).
+ * Буферы, разделяемые копиями книг (copy-on-write), учитываются в каждой книге, ссылающейся на них.
+ */
+struct MemoryBreakdown {
+  std::size_t slot_bytes{0};           // занятые позиции массива книг
+  std::size_t string_inline_bytes{0};  // символы коротких строк внутри объектов (SSO)
+  std::size_t string_heap_bytes{0};    // символы длинных строк в куче (с завершающим нулем)
+  std::size_t author_vector_bytes{0};  // элементы списков авторов, не уместившихся в книге (в куче)
+  std::size_t shared_block_bytes{0};   // блоки разделяемых буферов: объекты строк и счетчики ссылок
+
+  // неиспользуемый резерв
+  std::size_t slot_slack_bytes{0};    // свободные позиции и надгробия массива книг
+  std::size_t string_slack_bytes{0};  // емкость строк в куче сверх их длины
+  std::size_t author_slack_bytes{0};  // емкость списков авторов в куче сверх их размера
+
+  // общий объем памяти (без string_inline_bytes, входящих в размер объектов)
+  std::size_t GetTotal() const;
+
+  // общий объем неиспользуемого резерва
+  std::size_t GetSlack() const;
+
+  MemoryBreakdown &operator+=(const MemoryBreakdown &other);
+  MemoryBreakdown &operator-=(const MemoryBreakdown &other);
+};
+
+/**
+ * Учет памяти, занимаемой символами строки (сам объект std::string не учитывается).
+ *
+ * @param str - строка
+ * @param usage - разбивка памяти, к которой добавляется строка
+ */
+void account_string(const std::string &str, MemoryBreakdown &usage);
+
+// оценка размера счетчиков ссылок в блоке std::make_shared
+inline constexpr std::size_t kSharedControlBytes = 2 * sizeof(void *);
+
+inline bool operator==(const MemoryBreakdown &lhs, const MemoryBreakdown &rhs) {
+  return lhs.slot_bytes == rhs.slot_bytes && lhs.string_inline_bytes == rhs.string_inline_bytes &&
+         lhs.string_heap_bytes == rhs.string_heap_bytes && lhs.author_vector_bytes == rhs.author_vector_bytes &&
+         lhs.shared_block_bytes == rhs.shared_block_bytes && lhs.slot_slack_bytes == rhs.slot_slack_bytes &&
+         lhs.string_slack_bytes == rhs.string_slack_bytes && lhs.author_slack_bytes == rhs.author_slack_bytes;
+}
+
+inline bool operator!=(const MemoryBreakdown &lhs, const MemoryBreakdown &rhs) {
+  return !(lhs == rhs);
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+/**
+ * Индекс MinHash-подписей текстов для поиска почти совпадающих текстов (near-duplicates).
+ *
+ * Текст разбивается на слова (см. for_each_token) без учета регистра латинских букв,
+ * шинглы - последовательности из shingle_size соседних слов. Подпись из num_bands * rows_per_band
+ * значений строится однократным хэшированием (one permutation hashing): хэш шингла выбирает
+ * ячейку подписи, а ячейка хранит минимум хэшей попавших в нее шинглов. Поэтому подпись
+ * вычисляется за O(кол-во шинглов), а не O(шинглы * значения), как при независимых хэш-функциях.
+ * Пустые ячейки коротких текстов заполняются из соседних (densification). Доля совпадающих
+ * значений подписей двух текстов - оценка сходства Жаккара их множеств шинглов.
+ *
+ * Подписи делятся на num_bands полос по rows_per_band значений (LSH): тексты, совпадающие
+ * хотя бы в одной полосе целиком, попадают в одну корзину и становятся кандидатами.
+ * Вероятность стать кандидатами при сходстве s равна 1 - (1 - s^r)^b - резкий порог
+ * около (1 / b)^(1 / r) (см. GetThreshold), поэтому пары заметно ниже порога почти
+ * не сравниваются. Вставка хранит только ключи полос, а корзины собираются сортировкой
+ * при поиске групп - O(n log n) по кол-ву текстов.
+ */
+struct MinHashIndex {
+ public:
+  MinHashIndex();
+
+  /**
+   * Создает пустой индекс с заданными параметрами подписей.
+   *
+   * @param num_bands - кол-во полос LSH (больше полос - ниже порог сходства кандидатов)
+   * @param rows_per_band - кол-во значений подписи в полосе (больше значений - порог резче и выше)
+   * @param shingle_size - кол-во слов в шингле
+   */
+  MinHashIndex(int num_bands, int rows_per_band, int shingle_size);
+
+  /**
+   * Вычисление подписи текста и добавление ее в корзины LSH.
+   * Текст без слов не индексируется (сходство с ним не определено).
+   *
+   * @param text - текст (например, содержание книги)
+   * @param id - неотрицательный идентификатор текста (не должен повторяться)
+   */
+  void Insert(std::string_view text, int id);
+
+  /**
+   * Добавление готовой подписи из другого индекса с теми же параметрами (без повторного хэширования).
+   *
+   * @param other - индекс, содержащий подпись
+   * @param other_id - идентификатор текста в other
+   * @param id - новый идентификатор текста
+   */
+  void InsertFrom(const MinHashIndex &other, int other_id, int id);
+
+  /**
+   * Поиск групп почти совпадающих текстов.
+   * Кандидаты из общих корзин LSH объединяются в группы, если оценка их сходства
+   * не ниже min_similarity (сходство транзитивно замыкается внутри группы).
+   *
+   * @param min_similarity - минимальная оценка сходства Жаккара
+   * @param is_alive - фильтр идентификаторов (пустая функция - учитываются все тексты)
+   * @return группы идентификаторов (в группе не менее двух текстов, по возрастанию)
+   */
+  std::vector<std::vector<int>> FindClusters(double min_similarity,
+                                             const std::function<bool(int)> &is_alive = {}) const;
+
+  /**
+   * Оценка сходства Жаккара множеств шинглов двух текстов по их подписям.
+   *
+   * @return доля совпадающих значений подписей (0 - если один из текстов не индексирован)
+   */
+  double EstimateSimilarity(int lhs, int rhs) const;
+
+  // наличие подписи текста с идентификатором id
+  bool Contains(int id) const;
+
+  // сброс индекса (параметры подписей сохраняются)
+  void Clear();
+
+  // getters
+  int GetSize() const;
+  int GetNumHashes() const;
+  double GetThreshold() const;  // сходство, при котором вероятность стать кандидатами ~ 1/2
+
+ public:
+  static constexpr int kDefaultBands = 16;
+  static constexpr int kDefaultRowsPerBand = 4;
+  static constexpr int kDefaultShingleSize = 3;
+
+ private:
+  int num_bands_{kDefaultBands};
+  int rows_per_band_{kDefaultRowsPerBand};
+  int shingle_size_{kDefaultShingleSize};
+
+  std::vector<std::uint32_t> signatures_;   // id -> num_hashes значений подписи
+  std::vector<bool> has_signature_;         // id -> подпись вычислена
+  int size_{0};                             // кол-во подписей
+
+  std::vector<std::uint64_t> band_keys_;    // id -> num_bands ключей корзин LSH (хэши полос подписи)
+
+  // приватный метод для добавления вычисленной подписи
+  void insert_signature(const std::uint32_t *signature, int id);
+
+  // приватный метод для доступа к подписи текста
+  const std::uint32_t *signature(int id) const;
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(MinHashIndex::kDefaultBands > 0 && MinHashIndex::kDefaultRowsPerBand > 0);
+static_assert(MinHashIndex::kDefaultShingleSize > 0);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>  // lower_bound, merge, upper_bound
+#include <iterator>   // back_inserter
+#include <utility>    // pair, move
+#include <vector>
+
+/**
+ * Упорядоченный вторичный индекс: ключ -> позиция книги в хранилище.
+ *
+ * Записи хранятся в наборе отсортированных прогонов (runs) по принципу LSM:
+ * прогон уровня i вмещает не более kBaseRunSize * 2^i записей.
+ * Новая запись вставляется в нулевой (самый маленький) прогон,
+ * а переполненный прогон сливается со следующим уровнем.
+ * Вставка стоит амортизированно O(log N), поиск - O(log^2 N),
+ * а обход диапазона идет по непрерывным массивам (дружелюбно к кэшу).
+ *
+ * @tparam Key - тип ключа (должен поддерживать operator<)
+ */
+template <typename Key>
+struct OrderedIndex {
+ public:
+  // запись индекса: ключ и позиция книги в хранилище
+  using Entry = std::pair<Key, int>;
+
+  /**
+   * Добавление записи в индекс.
+   *
+   * @param key - ключ записи
+   * @param position - позиция книги в хранилище
+   */
+  void Insert(const Key &key, int position) {
+    Entry entry{key, position};
+
+    if (runs_.empty()) {
+      runs_.emplace_back();
+      runs_.front().reserve(kBaseRunSize);
+    }
+
+    // нулевой прогон небольшой, поэтому вставка со сдвигом дешевая
+    auto &head = runs_.front();
+    head.insert(std::upper_bound(head.begin(), head.end(), entry), std::move(entry));
+    size_ += 1;
+
+    // каскадное слияние переполненных прогонов
+    for (std::size_t level = 0; runs_[level].size() > run_capacity(level); level++) {
+      if (level + 1 == runs_.size()) {
+        runs_.emplace_back();
+      }
+
+      std::vector<Entry> merged;
+      merged.reserve(runs_[level].size() + runs_[level + 1].size());
+      std::merge(std::make_move_iterator(runs_[level].begin()), std::make_move_iterator(runs_[level].end()),
+                 std::make_move_iterator(runs_[level + 1].begin()), std::make_move_iterator(runs_[level + 1].end()),
+                 std::back_inserter(merged));
+
+      runs_[level].clear();
+      runs_[level + 1] = std::move(merged);
+    }
+  }
+
+  /**
+   * Обход записей с ключом >= from в порядке возрастания ключа.
+   * Обход прекращается, когда функция обратного вызова вернет false.
+   *
+   * @param from - нижняя граница ключа (включительно)
+   * @param visit - функция вида bool(const Key &key, int position)
+   */
+  template <typename Visitor>
+  void Scan(const Key &from, Visitor &&visit) const {
+    // курсоры по всем непустым прогонам (их не более O(log N))
+    std::vector<std::pair<const Entry *, const Entry *>> cursors;
+    cursors.reserve(runs_.size());
+
+    for (const auto &run: runs_) {
+      const auto first = std::lower_bound(run.begin(), run.end(), from,
+                                          [](const Entry &entry, const Key &key) { return entry.first < key; });
+      if (first != run.end()) {
+        cursors.emplace_back(run.data() + (first - run.begin()), run.data() + run.size());
+      }
+    }
+
+    // k-путевое слияние курсоров
+    while (!cursors.empty()) {
+      std::size_t min_index = 0;
+
+      for (std::size_t index = 1; index < cursors.size(); index++) {
+        if (*cursors[index].first < *cursors[min_index].first) {
+          min_index = index;
+        }
+      }
+
+      auto &cursor = cursors[min_index];
+
+      if (!visit(cursor.first->first, cursor.first->second)) {
+        return;
+      }
+
+      if (++cursor.first == cursor.second) {
+        cursors.erase(cursors.begin() + static_cast<std::ptrdiff_t>(min_index));
+      }
+    }
+  }
+
+  /**
+   * Обход записей с ключом из полуинтервала [from, to) в порядке возрастания ключа.
+   *
+   * @param from - нижняя граница ключа (включительно)
+   * @param to - верхняя граница ключа (не включительно)
+   * @param visit - функция вида void(const Key &key, int position)
+   */
+  template <typename Visitor>
+  void ForEachInRange(const Key &from, const Key &to, Visitor &&visit) const {
+    Scan(from, [&](const Key &key, int position) {
+      if (!(key < to)) return false;
+      visit(key, position);
+      return true;
+    });
+  }
+
+  // кол-во записей в индексе
+  int GetSize() const {
+    return size_;
+  }
+
+  // высвобождение памяти, занимаемой индексом
+  void Clear() {
+    runs_ = {};
+    size_ = 0;
+  }
+
+ public:
+  // максимальный размер нулевого прогона
+  static constexpr std::size_t kBaseRunSize = 64;
+
+ private:
+  std::vector<std::vector<Entry>> runs_;  // отсортированные прогоны (уровни)
+  int size_{0};                           // общее кол-во записей
+
+  // вместимость прогона заданного уровня
+  static std::size_t run_capacity(std::size_t level) {
+    return kBaseRunSize << level;
+  }
+};
+
+static_assert(OrderedIndex<int>::kBaseRunSize >= 1);
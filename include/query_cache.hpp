@@ -0,0 +1,91 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "book.hpp"
+#include "book_aggregate.hpp"
+#include "book_query.hpp"
+
+// статистика обращений к кэшу запросов
+struct QueryCacheStats {
+  long long num_hits{0};           // запросов с результатом из кэша
+  long long num_misses{0};         // запросов, вычисленных проходом по хранилищу
+  long long num_invalidations{0};  // записей, сброшенных из-за изменения подходящих книг
+  long long num_evictions{0};      // записей, вытесненных при переполнении кэша
+
+  // доля запросов с результатом из кэша
+  double GetHitRate() const;
+};
+
+/**
+ * Кэш результатов запросов BookQuery по нормализованному ключу (см. BookQuery::GetKey).
+ *
+ * Кэш регистрируется в магазине как агрегат и получает уведомления о каждом изменении книг:
+ * сбрасываются только записи, фильтрам которых удовлетворяет добавленная, удаленная
+ * или измененная книга, остальные результаты остаются действительными. Уплотнение хранилища
+ * меняет позиции книг, поэтому сбрасывает кэш целиком. При переполнении вытесняется
+ * запись, к которой дольше всего не обращались.
+ *
+ * Пример:
+ *   QueryCache &cache = store.RegisterAggregate<QueryCache>();
+ *   cache.Indices(BookQuery(store).WhereGenre(Genre::HORROR).WherePublisher(Publisher::USA));
+ */
+struct QueryCache : BookAggregate {
+ public:
+  explicit QueryCache(int capacity = kDefaultCapacity);
+
+  /**
+   * Позиции подходящих книг: из кэша или проходом по хранилищу (с сохранением результата).
+   * Запросы с произвольными предикатами (Where) не кэшируются и всегда вычисляются.
+   *
+   * @param query - запрос к магазину, в котором зарегистрирован кэш
+   * @return позиции подходящих книг (см. BookQuery::Indices)
+   */
+  std::vector<int> Indices(const BookQuery &query);
+
+  // кол-во подходящих книг (см. BookQuery::Count), результат кэшируется так же, как в Indices
+  int Count(const BookQuery &query);
+
+  // уведомления магазина (см. BookAggregate)
+  void Add(const Book &book) override;
+  void Remove(const Book &book) override;
+  void OnRelocated() override;
+
+  // сброс всех записей (статистика сохраняется)
+  void Clear();
+
+  // getters
+  int GetSize() const;
+  int GetCapacity() const;
+  QueryCacheStats GetStats() const;
+
+ public:
+  static constexpr int kDefaultCapacity = 256;  // кол-во записей по умолчанию
+
+ private:
+  // запись кэша: запрос (для проверки изменившихся книг) и его результат
+  struct Entry {
+    BookQuery query;
+    std::vector<int> indices;
+    long long last_used{0};  // момент последнего обращения (для вытеснения)
+  };
+
+  int capacity_{kDefaultCapacity};               // максимальное кол-во записей
+  std::unordered_map<std::string, Entry> entries_;  // ключ запроса -> запись
+  long long clock_{0};                           // счетчик обращений
+  QueryCacheStats stats_;
+
+  // приватный метод для поиска результата запроса (с вычислением и сохранением при промахе)
+  const std::vector<int> *lookup(const BookQuery &query);
+
+  // приватный метод для сброса записей, которым удовлетворяет книга
+  void invalidate(const Book &book);
+
+  // приватный метод для вытеснения записи, к которой дольше всего не обращались
+  void evict();
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(QueryCache::kDefaultCapacity > 0);
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <future>
+#include <memory>  // unique_ptr
+#include <mutex>
+#include <string>
+#include <type_traits>  // invoke_result_t
+#include <vector>
+
+#include "book.hpp"
+#include "book_store.hpp"
+#include "thread_pool.hpp"
+
+// структура: адрес книги в шардированном магазине
+struct ShardedBookRef {
+  int shard{0};  // номер шарда
+  int index{0};  // позиция книги в хранилище шарда
+
+  friend bool operator==(const ShardedBookRef &lhs, const ShardedBookRef &rhs) {
+    return lhs.shard == rhs.shard && lhs.index == rhs.index;
+  }
+};
+
+/**
+ * Шардированный книжный магазин для многоядерной загрузки и поиска.
+ *
+ * Книги распределяются по N независимым магазинам (шардам) по хэшу названия.
+ * У каждого шарда своя блокировка, поэтому добавления из разных потоков в разные шарды
+ * не мешают друг другу. Запросы рассылаются всем шардам параллельно (в пуле потоков),
+ * а их результаты объединяются.
+ */
+struct ShardedBookStore {
+ public:
+  /**
+   * Создает магазин из num_shards пустых шардов.
+   *
+   * @param name - название магазина (шарды называются "name #i")
+   * @param num_shards - кол-во шардов
+   * @param num_threads - кол-во потоков для параллельных запросов (0 - по кол-ву шардов, но не более ядер)
+   */
+  ShardedBookStore(const std::string &name, int num_shards, int num_threads = 0);
+
+  /**
+   * Добавление книги в шард, определяемый хэшем названия.
+   * Потокобезопасно: блокируется только выбранный шард.
+   * Если хранилище шарда не удалось увеличить, выбрасывается std::runtime_error.
+   *
+   * @param book - книга, которую необходимо добавить
+   * @return адрес добавленной книги
+   */
+  ShardedBookRef AddBook(const Book &book);
+
+  /**
+   * Резервирование места под заданное общее кол-во книг (равномерно по шардам).
+   *
+   * @param capacity - ожидаемое общее кол-во книг
+   */
+  void Reserve(int capacity);
+
+  /**
+   * Поиск книг автора во всех шардах параллельно.
+   *
+   * @param full_name - полное имя автора
+   * @return адреса книг (по возрастанию номера шарда и позиции)
+   */
+  std::vector<ShardedBookRef> FindBooksByAuthor(const std::string &full_name) const;
+
+  /**
+   * Поиск книг, название которых лежит в полуинтервале [from, to), во всех шардах параллельно.
+   *
+   * @param from - нижняя граница названия (включительно)
+   * @param to - верхняя граница названия (не включительно)
+   * @return адреса книг в лексикографическом порядке названий (при равенстве - по шарду и позиции)
+   */
+  std::vector<ShardedBookRef> FindBooksByTitleRange(const std::string &from, const std::string &to) const;
+
+  /**
+   * Параллельное выполнение функции над каждым шардом (под его блокировкой).
+   * Результаты собираются по номерам шардов, а не по порядку завершения задач,
+   * поэтому порядок результатов воспроизводим от запуска к запуску.
+   * Если функция выбросила исключение, оно пробрасывается после завершения задач всех шардов
+   * (при нескольких исключениях - исключение шарда с меньшим номером).
+   *
+   * @param func - функция вида T(const BookStore &shard)
+   * @return результаты функции по шардам (в порядке номеров шардов)
+   */
+  template <typename Func>
+  auto FanOut(Func &&func) const -> std::vector<std::invoke_result_t<Func, const BookStore &>> {
+    using Value = std::invoke_result_t<Func, const BookStore &>;
+
+    std::vector<std::future<Value>> futures;
+    futures.reserve(shards_.size());
+
+    for (const auto &shard: shards_) {
+      futures.push_back(pool_->Submit([&func, shard = shard.get()] {
+        std::lock_guard lock(shard->mutex);
+        return func(shard->store);
+      }));
+    }
+
+    // задачи ссылаются на func и шарды: дожидаемся всех, прежде чем get() выбросит исключение
+    for (auto &future: futures) {
+      future.wait();
+    }
+
+    std::vector<Value> results;
+    results.reserve(futures.size());
+
+    // сбор в порядке номеров шардов (future[i] - результат i-го шарда)
+    for (auto &future: futures) {
+      results.push_back(future.get());
+    }
+
+    return results;
+  }
+
+  /**
+   * Последовательный обход всех книг каталога (шард за шардом).
+   *
+   * @param visit - функция вида void(const Book &book, ShardedBookRef ref)
+   */
+  template <typename Visitor>
+  void ForEachBook(Visitor &&visit) const {
+    for (int shard_index = 0; shard_index < GetNumShards(); shard_index++) {
+      const auto &shard = *shards_[shard_index];
+      std::lock_guard lock(shard.mutex);
+
+      const Book *books = shard.store.GetBooks();
+      const bool has_removed = shard.store.GetNumRemoved() > 0;
+
+      for (int index = 0; index < shard.store.GetNumSlots(); index++) {
+        if (has_removed && shard.store.IsRemoved(index)) continue;
+        visit(books[index], ShardedBookRef{shard_index, index});
+      }
+    }
+  }
+
+  // getters
+  const std::string &GetName() const;
+  int GetSize() const;
+  int GetNumShards() const;
+
+  /**
+   * Доступ к шарду. Вызывающий отвечает за отсутствие параллельных добавлений в этот шард.
+   *
+   * @param shard - номер шарда
+   * @return магазин-шард
+   */
+  const BookStore &GetShard(int shard) const;
+
+  /**
+   * Номер шарда для книги с заданным названием.
+   * Хэш названия фиксирован (FNV-1a), поэтому распределение книг не зависит от платформы.
+   *
+   * @param title - название книги
+   * @return номер шарда
+   */
+  int GetShardIndex(const std::string &title) const;
+
+ private:
+  // шард: независимый магазин со своей блокировкой
+  struct Shard {
+    explicit Shard(const std::string &name) : store{name} {}
+
+    BookStore store;
+    mutable std::mutex mutex;
+  };
+
+  std::string name_;                           // название магазина
+  std::vector<std::unique_ptr<Shard>> shards_;  // шарды
+  std::unique_ptr<ThreadPool> pool_;           // пул потоков для параллельных запросов
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>  // equal, move
+#include <array>
+#include <cstddef>    // size_t
+#include <iterator>   // back_inserter, distance
+#include <utility>    // move
+#include <vector>
+
+/**
+ * Динамический массив с встроенным буфером на InlineCapacity элементов.
+ *
+ * Пока элементов не больше InlineCapacity, они хранятся внутри объекта и не требуют
+ * выделения памяти (ни при создании, ни при копировании). При переполнении элементы
+ * переносятся в std::vector в куче и остаются там до очистки массива.
+ * Элементы встроенного буфера создаются конструктором по умолчанию,
+ * поэтому тип элемента должен дешево создаваться без выделения памяти.
+ *
+ * @tparam T - тип элемента (с конструктором по умолчанию)
+ * @tparam InlineCapacity - вместимость встроенного буфера
+ */
+template <typename T, int InlineCapacity>
+struct SmallVector {
+ public:
+  using value_type = T;
+  using iterator = T *;
+  using const_iterator = const T *;
+
+  SmallVector() = default;
+
+  template <typename Iterator>
+  SmallVector(Iterator first, Iterator last) {
+    Reserve(static_cast<int>(std::distance(first, last)));
+
+    for (; first != last; ++first) {
+      PushBack(*first);
+    }
+  }
+
+  SmallVector(const SmallVector &) = default;
+
+  // std::vector сохраняет емкость при присваивании, поэтому буфер выбирается по источнику
+  SmallVector &operator=(const SmallVector &other) {
+    if (this == &other) {
+      return *this;
+    }
+
+    if (other.IsInline()) {
+      inline_ = other.inline_;
+      heap_ = std::vector<T>();  // присваивание {} сохранило бы емкость
+    } else {
+      heap_ = other.heap_;
+      inline_ = {};
+    }
+    size_ = other.size_;
+    return *this;
+  }
+
+  SmallVector(SmallVector &&other) noexcept
+      : inline_{std::move(other.inline_)}, heap_{std::move(other.heap_)}, size_{other.size_} {
+    other.heap_.clear();
+    other.size_ = 0;
+  }
+
+  SmallVector &operator=(SmallVector &&other) noexcept {
+    if (this != &other) {
+      inline_ = std::move(other.inline_);
+      heap_ = std::move(other.heap_);
+      size_ = other.size_;
+      other.heap_.clear();
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /**
+   * Резервирование места под заданное кол-во элементов.
+   * Если элементы не умещаются во встроенный буфер, они сразу переносятся в кучу.
+   *
+   * @param capacity - требуемая вместимость
+   */
+  void Reserve(int capacity) {
+    if (capacity <= InlineCapacity) {
+      return;
+    }
+
+    if (!IsInline()) {
+      heap_.reserve(static_cast<std::size_t>(capacity));
+      return;
+    }
+
+    heap_.reserve(static_cast<std::size_t>(capacity));
+    std::move(inline_.begin(), inline_.begin() + size_, std::back_inserter(heap_));
+    inline_ = {};
+  }
+
+  // добавление элемента в конец массива
+  void PushBack(T value) {
+    if (IsInline() && size_ == InlineCapacity) {
+      Reserve(2 * InlineCapacity);
+    }
+
+    if (IsInline()) {
+      inline_[size_] = std::move(value);
+    } else {
+      heap_.push_back(std::move(value));
+    }
+
+    size_ += 1;
+  }
+
+  // удаление всех элементов (с высвобождением памяти в куче)
+  void Clear() {
+    inline_ = {};
+    heap_ = std::vector<T>();
+    size_ = 0;
+  }
+
+  // элементы хранятся во встроенном буфере (без памяти в куче)
+  bool IsInline() const {
+    return heap_.capacity() == 0;
+  }
+
+  int GetCapacity() const {
+    return IsInline() ? InlineCapacity : static_cast<int>(heap_.capacity());
+  }
+
+  // интерфейс контейнера стандартной библиотеки (для циклов и алгоритмов)
+  std::size_t size() const { return static_cast<std::size_t>(size_); }
+  bool empty() const { return size_ == 0; }
+
+  T *data() { return IsInline() ? inline_.data() : heap_.data(); }
+  const T *data() const { return IsInline() ? inline_.data() : heap_.data(); }
+
+  iterator begin() { return data(); }
+  iterator end() { return data() + size_; }
+  const_iterator begin() const { return data(); }
+  const_iterator end() const { return data() + size_; }
+
+  T &operator[](int index) { return data()[index]; }
+  const T &operator[](int index) const { return data()[index]; }
+
+  const T &front() const { return data()[0]; }
+  const T &back() const { return data()[size_ - 1]; }
+
+  friend bool operator==(const SmallVector &lhs, const SmallVector &rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+
+  friend bool operator!=(const SmallVector &lhs, const SmallVector &rhs) {
+    return !(lhs == rhs);
+  }
+
+ public:
+  static constexpr int kInlineCapacity = InlineCapacity;
+
+ private:
+  std::array<T, InlineCapacity> inline_{};  // встроенный буфер (используется, пока heap_ пуст)
+  std::vector<T> heap_;                     // элементы в куче (после переполнения встроенного буфера)
+  int size_{0};                             // кол-во элементов
+};
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>      // min, partial_sort
+#include <functional>     // hash
+#include <unordered_map>
+#include <utility>        // swap
+#include <vector>
+
+/**
+ * Приближенный подсчет наиболее частых элементов потока (алгоритм Space-Saving).
+ * Хранит не более capacity счетчиков: при переполнении вытесняется счетчик с наименьшим значением,
+ * а новый элемент наследует его значение как верхнюю оценку ошибки.
+ * Любой элемент с частотой больше N / capacity гарантированно присутствует в результате.
+ *
+ * @tparam Key - тип элемента потока
+ * @tparam Hash - хэш-функция элемента
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+struct SpaceSaving {
+ public:
+  // счетчик элемента: оценка частоты сверху и максимальная ошибка оценки
+  struct Counter {
+    Key key;
+    int count{0};
+    int error{0};
+  };
+
+  /**
+   * Создает пустую сводку.
+   *
+   * @param capacity - максимальное кол-во счетчиков
+   */
+  explicit SpaceSaving(int capacity) : capacity_{capacity > 0 ? capacity : 1} {}
+
+  /**
+   * Учет очередного вхождения элемента. Выполняется за O(log capacity).
+   *
+   * @param key - элемент потока
+   */
+  void Add(const Key &key) {
+    const auto it = slots_.find(key);
+
+    if (it != slots_.end()) {
+      counters_[it->second].count += 1;
+      sift_down(heap_position_[it->second]);
+      return;
+    }
+
+    if (static_cast<int>(counters_.size()) < capacity_) {
+      const int slot = static_cast<int>(counters_.size());
+      counters_.push_back(Counter{key, 1, 0});
+      slots_.emplace(key, slot);
+      heap_.push_back(slot);
+      heap_position_.push_back(slot);
+      sift_up(slot);
+      return;
+    }
+
+    // вытеснение счетчика с наименьшим значением (вершина min-кучи)
+    const int slot = heap_.front();
+    Counter &counter = counters_[slot];
+
+    slots_.erase(counter.key);
+    counter.key = key;
+    counter.error = counter.count;
+    counter.count += 1;
+    slots_.emplace(key, slot);
+
+    sift_down(0);
+  }
+
+  /**
+   * Отмена одного вхождения элемента (например, удаление книги автора). Выполняется за O(log capacity).
+   * Уменьшается только счетчик отслеживаемого элемента, поэтому оценка остается оценкой сверху,
+   * но гарантия присутствия частых элементов в результате ослабевает.
+   *
+   * @param key - элемент потока (ранее учтенный в Add)
+   */
+  void Remove(const Key &key) {
+    const auto it = slots_.find(key);
+
+    if (it == slots_.end() || counters_[it->second].count == 0) {
+      return;
+    }
+
+    counters_[it->second].count -= 1;
+    sift_up(heap_position_[it->second]);
+  }
+
+  /**
+   * Наиболее частые элементы в порядке убывания оценки частоты.
+   *
+   * @param k - максимальное кол-во элементов
+   * @return счетчики не более k наиболее частых элементов
+   */
+  std::vector<Counter> Top(int k) const {
+    std::vector<Counter> top = counters_;
+    const auto size = static_cast<std::size_t>(std::min(std::max(k, 0), static_cast<int>(top.size())));
+
+    std::partial_sort(top.begin(), top.begin() + static_cast<std::ptrdiff_t>(size), top.end(),
+                      [](const Counter &lhs, const Counter &rhs) { return lhs.count > rhs.count; });
+    top.resize(size);
+
+    return top;
+  }
+
+  int GetCapacity() const {
+    return capacity_;
+  }
+
+  // высвобождение памяти, занимаемой сводкой
+  void Clear() {
+    counters_ = {};
+    slots_ = {};
+    heap_ = {};
+    heap_position_ = {};
+  }
+
+ private:
+  int capacity_;                                // максимальное кол-во счетчиков
+  std::vector<Counter> counters_;               // счетчики (индекс - номер слота)
+  std::unordered_map<Key, int, Hash> slots_;    // элемент -> номер слота
+  std::vector<int> heap_;                       // min-куча слотов по значению счетчика
+  std::vector<int> heap_position_;              // номер слота -> позиция в куче
+
+  bool less(int lhs_position, int rhs_position) const {
+    return counters_[heap_[lhs_position]].count < counters_[heap_[rhs_position]].count;
+  }
+
+  void swap_positions(int lhs_position, int rhs_position) {
+    std::swap(heap_[lhs_position], heap_[rhs_position]);
+    heap_position_[heap_[lhs_position]] = lhs_position;
+    heap_position_[heap_[rhs_position]] = rhs_position;
+  }
+
+  void sift_up(int position) {
+    while (position > 0) {
+      const int parent = (position - 1) / 2;
+      if (!less(position, parent)) break;
+      swap_positions(position, parent);
+      position = parent;
+    }
+  }
+
+  void sift_down(int position) {
+    const int size = static_cast<int>(heap_.size());
+
+    while (true) {
+      const int left = 2 * position + 1;
+      const int right = left + 1;
+      int smallest = position;
+
+      if (left < size && less(left, smallest)) smallest = left;
+      if (right < size && less(right, smallest)) smallest = right;
+      if (smallest == position) break;
+
+      swap_positions(position, smallest);
+      position = smallest;
+    }
+  }
+};
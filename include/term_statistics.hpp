@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>  // pair
+#include <vector>
+
+#include "book_store.hpp"
+
+// структура: частота термина (результат top-K запросов)
+struct TermCount {
+  std::string term;    // термин (слово в нижнем регистре)
+  long long count{0};  // кол-во вхождений
+};
+
+// структура: статистика терминов книги
+struct BookTermStatistics {
+  int num_tokens{0};                           // кол-во слов в содержании
+  std::vector<std::pair<int, int>> term_counts;  // (идентификатор термина, кол-во вхождений) по возрастанию идентификатора
+};
+
+// структура: статистика терминов по содержанию всех книг магазина
+struct TermStatistics {
+ public:
+  /**
+   * Поиск идентификатора термина.
+   *
+   * @param term - термин (регистр латинских букв не важен)
+   * @return идентификатор термина или -1, если термин не встречается
+   */
+  int FindTerm(std::string_view term) const;
+
+  /**
+   * Поиск k самых частых терминов (по убыванию кол-ва вхождений).
+   *
+   * @param k - максимальное кол-во терминов
+   * @return термины и кол-во их вхождений
+   */
+  std::vector<TermCount> TopTerms(int k) const;
+
+  // размер словаря (кол-во различных терминов)
+  int GetVocabularySize() const;
+
+ public:
+  long long num_tokens{0};                   // кол-во слов во всех книгах
+  std::vector<std::string> terms;            // идентификатор -> термин (в порядке первого вхождения)
+  std::vector<long long> term_counts;        // идентификатор -> кол-во вхождений
+  std::vector<int> document_frequencies;     // идентификатор -> кол-во книг с термином
+  std::vector<BookTermStatistics> books;     // позиция книги в хранилище -> статистика (пустая для удаленных)
+
+ private:
+  std::unordered_map<std::string, int> term_ids_;  // термин -> идентификатор
+
+  friend TermStatistics build_term_statistics(const BookStore &store, int num_threads);
+};
+
+/**
+ * Построение статистики терминов по содержанию книг магазина.
+ * Книги делятся на непрерывные диапазоны по числу потоков, каждый поток строит
+ * собственную хеш-таблицу терминов без синхронизации, затем таблицы сливаются.
+ * Идентификаторы терминов не зависят от кол-ва потоков (порядок первого вхождения).
+ * Регистр латинских букв не учитывается. Магазин не должен изменяться во время построения.
+ *
+ * @param store - книжный магазин
+ * @param num_threads - кол-во потоков (0 - по кол-ву ядер)
+ * @return статистика терминов
+ */
+TermStatistics build_term_statistics(const BookStore &store, int num_threads = 0);
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>       // make_shared
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>  // invoke_result_t
+#include <utility>      // forward, move
+#include <vector>
+
+/**
+ * Пул потоков фиксированного размера с общей очередью задач.
+ * Задачи, поставленные до разрушения пула, выполняются до конца.
+ */
+struct ThreadPool {
+ public:
+  /**
+   * Создает пул и запускает рабочие потоки.
+   *
+   * @param num_threads - кол-во рабочих потоков (не менее одного)
+   */
+  explicit ThreadPool(int num_threads) {
+    num_threads = num_threads > 0 ? num_threads : 1;
+    workers_.reserve(num_threads);
+
+    for (int index = 0; index < num_threads; index++) {
+      workers_.emplace_back([this] { run_worker(); });
+    }
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  // дожидается выполнения поставленных задач и останавливает рабочие потоки
+  ~ThreadPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stopped_ = true;
+    }
+    has_tasks_.notify_all();
+
+    for (auto &worker: workers_) {
+      worker.join();
+    }
+  }
+
+  /**
+   * Постановка задачи в очередь пула.
+   *
+   * @param func - задача (вызываемый объект без аргументов)
+   * @return future с результатом задачи (или выброшенным ею исключением)
+   */
+  template <typename Func>
+  auto Submit(Func &&func) -> std::future<std::invoke_result_t<Func>> {
+    using Value = std::invoke_result_t<Func>;
+
+    // packaged_task не копируется, а std::function требует копируемости
+    auto task = std::make_shared<std::packaged_task<Value()>>(std::forward<Func>(func));
+    std::future<Value> future = task->get_future();
+
+    {
+      std::lock_guard lock(mutex_);
+      tasks_.emplace([task] { (*task)(); });
+    }
+    has_tasks_.notify_one();
+
+    return future;
+  }
+
+  int GetNumThreads() const {
+    return static_cast<int>(workers_.size());
+  }
+
+ private:
+  std::vector<std::thread> workers_;        // рабочие потоки
+  std::queue<std::function<void()>> tasks_;  // очередь задач
+  bool stopped_{false};                      // признак остановки пула
+  std::mutex mutex_;                         // защищает tasks_ и stopped_
+  std::condition_variable has_tasks_;        // ожидание задач
+
+  void run_worker() {
+    while (true) {
+      std::function<void()> task;
+
+      {
+        std::unique_lock lock(mutex_);
+        has_tasks_.wait(lock, [this] { return stopped_ || !tasks_.empty(); });
+
+        if (tasks_.empty()) return;  // пул остановлен и задач не осталось
+
+        task = std::move(tasks_.front());
+        tasks_.pop();
+      }
+
+      task();
+    }
+  }
+};
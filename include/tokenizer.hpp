@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>  // size_t
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // SSE2
+#endif
+
+/**
+ * Проверка, является ли байт частью слова: латинская буква, цифра
+ * или байт многобайтового символа UTF-8 (например, кириллицы).
+ *
+ * @param byte - байт текста
+ * @return true - байт входит в слово
+ */
+constexpr bool is_word_byte(unsigned char byte) {
+  return (byte >= 'a' && byte <= 'z') || (byte >= 'A' && byte <= 'Z') || (byte >= '0' && byte <= '9') || byte >= 0x80;
+}
+
+#if defined(__SSE2__)
+
+/**
+ * Классификация 16 байт текста за несколько SIMD-инструкций.
+ *
+ * @param data - указатель на 16 байт текста
+ * @return битовая маска: i-й бит установлен, если i-й байт входит в слово
+ */
+inline std::uint32_t word_byte_mask(const char *data) {
+  const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+  const __m128i sign = _mm_set1_epi8(static_cast<char>(0x80));
+
+  // беззнаковое сравнение x < n через знаковое: (x ^ 0x80) < (n ^ 0x80)
+  const __m128i letter_offset = _mm_sub_epi8(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+  const __m128i letters = _mm_cmplt_epi8(_mm_xor_si128(letter_offset, sign), _mm_set1_epi8(static_cast<char>(26 ^ 0x80)));
+
+  const __m128i digit_offset = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+  const __m128i digits = _mm_cmplt_epi8(_mm_xor_si128(digit_offset, sign), _mm_set1_epi8(static_cast<char>(10 ^ 0x80)));
+
+  // байты >= 0x80 определяются по старшему биту без сравнений
+  const __m128i words = _mm_or_si128(_mm_or_si128(letters, digits), bytes);
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(words));
+}
+
+#endif
+
+/**
+ * Разбиение текста на слова (последовательности байт, для которых is_word_byte == true).
+ * При наличии SSE2 границы слов ищутся по 16 байт за раз: слова и пробелы длиннее
+ * 16 байт пропускаются без побайтовых проверок, а границы внутри блока находятся по битам маски.
+ *
+ * @param text - текст
+ * @param visit - функция вида void(std::string_view token)
+ */
+template <typename Visitor>
+void for_each_token(std::string_view text, Visitor &&visit) {
+  const char *data = text.data();
+  const std::size_t size = text.size();
+
+  std::size_t position = 0;
+  std::size_t token_start = 0;
+  bool in_token = false;
+
+#if defined(__SSE2__)
+  constexpr std::size_t kBlockSize = 16;
+  constexpr std::uint32_t kFullMask = (1u << kBlockSize) - 1;
+
+  for (; position + kBlockSize <= size; position += kBlockSize) {
+    const std::uint32_t mask = word_byte_mask(data + position);
+
+    // биты, в которых класс байта отличается от класса предыдущего байта
+    std::uint32_t boundaries = (mask ^ ((mask << 1) | static_cast<std::uint32_t>(in_token))) & kFullMask;
+
+    while (boundaries != 0) {
+      const auto offset = static_cast<std::size_t>(__builtin_ctz(boundaries));
+      boundaries &= boundaries - 1;
+
+      if (in_token) {
+        visit(std::string_view(data + token_start, position + offset - token_start));
+      } else {
+        token_start = position + offset;
+      }
+      in_token = !in_token;
+    }
+  }
+#endif
+
+  // хвост текста (или весь текст без SSE2)
+  for (; position < size; position++) {
+    const bool is_word = is_word_byte(static_cast<unsigned char>(data[position]));
+
+    if (is_word == in_token) continue;
+
+    if (in_token) {
+      visit(std::string_view(data + token_start, position - token_start));
+    } else {
+      token_start = position;
+    }
+    in_token = is_word;
+  }
+
+  if (in_token) {
+    visit(std::string_view(data + token_start, size - token_start));
+  }
+}
+
+/**
+ * Разбиение текста на слова (см. for_each_token).
+ *
+ * @param text - текст
+ * @return слова (ссылаются на символы текста)
+ */
+inline std::vector<std::string_view> tokenize(std::string_view text) {
+  std::vector<std::string_view> tokens;
+  for_each_token(text, [&tokens](std::string_view token) { tokens.push_back(token); });
+  return tokens;
+}
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(is_word_byte('a') && is_word_byte('Z') && is_word_byte('7') && is_word_byte(0xD0));
+static_assert(!is_word_byte(' ') && !is_word_byte(',') && !is_word_byte('@') && !is_word_byte('['));
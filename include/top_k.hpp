@@ -0,0 +1,79 @@
+#pragma once
+
+#include <algorithm>   // pop_heap, push_heap, sort_heap
+#include <functional>  // less
+#include <utility>     // move
+#include <vector>
+
+/**
+ * Отбор K наибольших элементов потока в ограниченной куче.
+ * Использует O(K) памяти и O(log K) времени на элемент, полная сортировка потока не требуется.
+ *
+ * @tparam T - тип элемента
+ * @tparam Less - строгое сравнение элементов ("меньше")
+ */
+template <typename T, typename Less = std::less<T>>
+struct TopK {
+ public:
+  /**
+   * Создает пустой отбор K наибольших элементов.
+   *
+   * @param k - максимальное кол-во отбираемых элементов
+   * @param less - сравнение элементов
+   */
+  explicit TopK(int k, Less less = Less{}) : k_{k > 0 ? k : 0}, greater_{std::move(less)} {
+    heap_.reserve(k_);
+  }
+
+  /**
+   * Добавление элемента потока.
+   * Элемент отбрасывается, если он не больше наименьшего из уже отобранных K элементов.
+   *
+   * @param value - элемент потока
+   */
+  void Push(T value) {
+    if (k_ == 0) return;
+
+    if (static_cast<int>(heap_.size()) < k_) {
+      heap_.push_back(std::move(value));
+      std::push_heap(heap_.begin(), heap_.end(), greater_);
+      return;
+    }
+
+    // в вершине кучи находится наименьший из отобранных элементов
+    if (greater_.less(heap_.front(), value)) {
+      std::pop_heap(heap_.begin(), heap_.end(), greater_);
+      heap_.back() = std::move(value);
+      std::push_heap(heap_.begin(), heap_.end(), greater_);
+    }
+  }
+
+  /**
+   * Извлечение отобранных элементов (по убыванию).
+   * После вызова отбор становится пустым.
+   *
+   * @return не более K наибольших элементов потока
+   */
+  std::vector<T> Extract() {
+    std::sort_heap(heap_.begin(), heap_.end(), greater_);
+    return std::move(heap_);
+  }
+
+  int GetSize() const {
+    return static_cast<int>(heap_.size());
+  }
+
+ private:
+  // обратное сравнение: превращает кучу в min-кучу
+  struct Greater {
+    Less less;
+
+    bool operator()(const T &lhs, const T &rhs) const {
+      return less(rhs, lhs);
+    }
+  };
+
+  int k_;              // максимальное кол-во отбираемых элементов
+  Greater greater_;    // сравнение элементов кучи
+  std::vector<T> heap_;  // min-куча отобранных элементов
+};
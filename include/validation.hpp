@@ -0,0 +1,39 @@
+#pragma once
+
+#include <utility>  // move
+
+// перечисление: статус валидации полей автора или книги
+enum class ValidationStatus {
+  SUCCESS,           // валидация прошла успешно
+  EMPTY_FULL_NAME,   // пустое полное имя автора
+  AUTHOR_TOO_YOUNG,  // возраст автора меньше Author::kMinAuthorAge
+  EMPTY_TITLE,       // пустое название книги
+  EMPTY_CONTENT,     // пустое содержание книги
+  EMPTY_AUTHORS      // пустой список авторов книги
+};
+
+/**
+ * Результат создания объекта без исключений: статус валидации и (при успехе) сам объект.
+ *
+ * @tparam T - тип создаваемого объекта
+ */
+template <typename T>
+struct Result {
+  ValidationStatus status{ValidationStatus::SUCCESS};  // статус валидации
+  T value{};                                           // объект (по умолчанию, если валидация не пройдена)
+
+  bool IsOk() const {
+    return status == ValidationStatus::SUCCESS;
+  }
+
+  static Result Ok(T value) {
+    return Result{ValidationStatus::SUCCESS, std::move(value)};
+  }
+
+  static Result Error(ValidationStatus status) {
+    return Result{status, T{}};
+  }
+};
+
+// внутренние проверки на этапе компиляции (не обращайте внимания)
+static_assert(static_cast<int>(ValidationStatus::SUCCESS) == 0);
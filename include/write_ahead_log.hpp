@@ -0,0 +1,185 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "book.hpp"
+
+struct BookStore;
+
+// перечисление: статус операции с журналом предзаписи
+enum class WalStatus {
+  SUCCESS,          // операция прошла успешно
+  NOT_OPEN,         // журнал не открыт
+  OPEN_FAILED,      // не удалось открыть файл журнала
+  WRITE_FAILED,     // не удалось записать данные в файл журнала
+  SYNC_FAILED,      // не удалось сбросить данные на диск (fsync)
+  CORRUPTED_RECORD  // в журнале обнаружена поврежденная запись
+};
+
+/**
+ * Журнал предзаписи (write-ahead log) изменений магазина: добавления книг, их удаления
+ * и добавления авторов.
+ *
+ * Каждое изменение кодируется в компактную двоичную запись: [длина][контрольная сумма][тип][поля].
+ * Удаление и добавление автора ссылаются на книгу по смещению записи ее добавления в файле
+ * журнала: смещение не меняется при уплотнении магазина, в отличие от позиции книги.
+ * Записи накапливаются в памяти и сбрасываются на диск группами (group commit):
+ * один write + fdatasync на пакет из batch_size записей или по истечении временного окна,
+ * а не на каждую книгу. Окно отсчитывается от первой записи пакета и проверяется фоновым
+ * потоком подтверждения, поэтому одиночная запись (или хвост серии) подтверждается не позже
+ * чем через window даже без последующих Append. При сбое теряются только записи, добавленные
+ * за последнее окно (или неподтвержденные из-за ошибки записи на диск).
+ * Ошибка фонового подтверждения возвращается следующим вызовом Append, Sync или Close.
+ * Запись, для которой Append вернул ошибку, в журнал не попадает (в том числе при последующих
+ * Sync и Close), поэтому вызывающий может не применять изменение к магазину.
+ */
+struct WriteAheadLog {
+ public:
+  WriteAheadLog() = default;
+  WriteAheadLog(const WriteAheadLog &) = delete;
+  WriteAheadLog &operator=(const WriteAheadLog &) = delete;
+
+  // подтверждает накопленные записи и закрывает файл
+  ~WriteAheadLog();
+
+  /**
+   * Открытие (или создание) файла журнала для дозаписи.
+   * Обрезанная при сбое последняя запись (см. Replay) удаляется из файла, иначе записи,
+   * дописанные после нее, были бы недоступны при восстановлении.
+   *
+   * @param path - путь к файлу журнала
+   * @param batch_size - кол-во записей в пакете, при котором выполняется подтверждение
+   * @param window - максимальное время ожидания подтверждения первой записи пакета
+   *                 (нулевое окно - подтверждение каждой записи без фонового потока)
+   * @return статус операции
+   */
+  WalStatus Open(const std::string &path,
+                 int batch_size = kDefaultBatchSize,
+                 std::chrono::milliseconds window = kDefaultWindow);
+
+  /**
+   * Добавление книги в журнал.
+   * Запись подтверждается на диске, когда пакет заполнен (в вызывающем потоке)
+   * или истекло временное окно (в фоновом потоке). Потокобезопасно.
+   *
+   * @param book - добавляемая книга
+   * @param offset - смещение записи в файле журнала - идентификатор книги для AppendRemove
+   *                 и AppendAuthor (может быть nullptr)
+   * @return статус операции (ошибка возможна только при подтверждении пакета или после ошибки
+   *         фонового подтверждения; в обоих случаях запись отбрасывается)
+   */
+  WalStatus Append(const Book &book, long long *offset = nullptr);
+
+  /**
+   * Добавление в журнал удаления книги (см. Append).
+   *
+   * @param offset - смещение записи добавления удаляемой книги
+   * @return статус операции
+   */
+  WalStatus AppendRemove(long long offset);
+
+  /**
+   * Добавление в журнал нового автора книги (см. Append).
+   *
+   * @param offset - смещение записи добавления книги
+   * @param author - добавляемый автор
+   * @return статус операции
+   */
+  WalStatus AppendAuthor(long long offset, const Author &author);
+
+  /**
+   * Подтверждение (запись и fdatasync) всех накопленных записей.
+   * После неудачной записи повторный вызов продолжает с первого незаписанного байта,
+   * поэтому уже попавшие в файл байты не дублируются.
+   *
+   * @return статус операции
+   */
+  WalStatus Sync();
+
+  // остановка фонового подтверждения, подтверждение накопленных записей и закрытие файла
+  WalStatus Close();
+
+  /**
+   * Восстановление магазина из журнала: книги добавляются, удаляются и дополняются авторами
+   * в порядке записей. Обрезанная последняя запись (незавершенная запись при сбое) игнорируется.
+   * Журнал не должен быть подключен к магазину во время восстановления. Восстановленные книги
+   * запоминают смещения своих записей, поэтому после повторного подключения того же журнала
+   * их удаления и изменения тоже журналируются.
+   *
+   * @param path - путь к файлу журнала
+   * @param store - книжный магазин, в который добавляются книги
+   * @param num_replayed - кол-во примененных записей (может быть nullptr)
+   * @return статус операции (CORRUPTED_RECORD - в том числе ссылка на неизвестную книгу)
+   */
+  static WalStatus Replay(const std::string &path, BookStore &store, int *num_replayed = nullptr);
+
+  // getters
+  bool IsOpen() const;
+  int GetNumPending() const;
+  long long GetNumAppended() const;
+  long long GetNumSyncs() const;
+
+ public:
+  static constexpr int kDefaultBatchSize = 1024;                         // записей в пакете
+  static constexpr std::chrono::milliseconds kDefaultWindow{10};        // окно подтверждения
+
+ private:
+  int fd_{-1};                             // файловый дескриптор журнала
+  int batch_size_{kDefaultBatchSize};      // записей в пакете
+  std::chrono::milliseconds window_{kDefaultWindow};
+  std::chrono::steady_clock::time_point batch_start_;  // время первой записи пакета
+
+  std::string buffer_;                     // закодированные, но не подтвержденные записи
+  std::size_t num_written_{0};             // кол-во байт buffer_, уже записанных в файл
+  long long next_offset_{0};               // смещение следующей записи в файле журнала
+  int num_pending_{0};                     // кол-во неподтвержденных записей
+  long long num_appended_{0};              // всего добавлено записей
+  long long num_syncs_{0};                 // всего подтверждений
+
+  // фоновое подтверждение по истечении временного окна
+  mutable std::mutex mutex_;               // защищает состояние журнала (кроме потока)
+  std::condition_variable has_pending_;    // появился новый пакет или журнал закрывается
+  std::thread flusher_;                    // поток подтверждения (только при ненулевом окне)
+  bool is_stopping_{false};                // поток подтверждения должен завершиться
+  WalStatus flush_status_{WalStatus::SUCCESS};  // ошибка фонового подтверждения (до передачи вызывающему)
+  bool is_broken_{false};                  // отклоненную запись не удалось обрезать в файле
+
+  // приватный метод для подтверждения накопленных записей (под блокировкой mutex_)
+  WalStatus sync_locked();
+
+  // приватный метод для добавления записи с заполненной полезной нагрузкой (заголовок заполняется здесь)
+  WalStatus append_record(std::string &record, long long *offset);
+
+  // приватный метод для добавления закодированной записи (под блокировкой mutex_)
+  WalStatus append_locked(const std::string &record, long long *offset);
+
+  // приватный метод для отката отклоненной записи из буфера и файла (под блокировкой mutex_)
+  void rollback_locked(long long record_offset, std::size_t buffer_offset);
+
+  // приватный метод - цикл потока подтверждения
+  void run_flusher();
+};
+
+/**
+ * Кодирование книги в двоичное представление (без заголовка записи журнала).
+ *
+ * @param book - книга
+ * @param out - строка, в конец которой дописывается представление
+ */
+void encode_book(const Book &book, std::string &out);
+
+/**
+ * Декодирование книги из двоичного представления.
+ *
+ * @param data - начало представления
+ * @param size - размер представления в байтах
+ * @param book - декодированная книга
+ * @return true - при успешном декодировании, false - представление некорректно
+ */
+bool decode_book(const char *data, std::size_t size, Book &book);
+
+static_assert(WriteAheadLog::kDefaultBatchSize >= 1);
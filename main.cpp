@@ -1,16 +1,234 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>  // invoke_result_t, is_void_v
 #include <vector>
 
+#include "async_loader.hpp"  // read_content_file
 #include "author.hpp"
 #include "book.hpp"
 #include "book_store.hpp"
+#include "bounded_queue.hpp"
+#include "enum_names.hpp"
 
 // 1. константность const и constexpr
 // 2. строки в стиле Си и класс std::string
 // 3. перечисления и структуры
 // 4. указатели и ссылки
 
+// Инструмент импорта каталога:
+//   main <contents_dir> <authors_manifest> <titles_manifest> [num_threads] [queue_capacity]
+//
+// Конвейер: чтение файлов содержания -> разбор и валидация (пул потоков) -> добавление в BookStore.
+// Стадии связаны очередями ограниченного размера, поэтому память не растет при медленном потребителе.
+// i-я книга (в порядке имен файлов) получает i-е название и i-го автора из манифестов (по кругу).
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// прочитанный файл содержания
+struct ContentItem {
+  int index{0};         // порядковый номер книги
+  std::string content;  // содержание
+};
+
+// книга после разбора и валидации
+struct BookItem {
+  int index{0};           // порядковый номер книги
+  Result<Book> book;      // книга или статус валидации
+};
+
+// время работы стадии конвейера (суммарно по всем потокам стадии)
+struct StageTimer {
+  std::atomic<long long> busy_ns{0};
+
+  template <typename Func>
+  auto Measure(Func &&func) {
+    const auto start = Clock::now();
+
+    if constexpr (std::is_void_v<std::invoke_result_t<Func>>) {
+      func();
+      add_elapsed(start);
+    } else {
+      auto result = func();
+      add_elapsed(start);
+      return result;
+    }
+  }
+
+  void add_elapsed(Clock::time_point start) {
+    busy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+  }
+
+  double GetMs() const {
+    return static_cast<double>(busy_ns.load()) / 1e6;
+  }
+};
+
+// чтение непустых строк файла
+std::vector<std::string> read_lines(const std::string &path) {
+  std::vector<std::string> lines;
+
+  if (auto fs = std::ifstream(path)) {
+    for (std::string line; std::getline(fs, line); /* ... */) {
+      if (!line.empty()) {
+        lines.push_back(line);
+      }
+    }
+  }
+
+  return lines;
+}
+
+// разбор строки манифеста авторов вида "full_name age SEX" (без исключений)
+// формат совпадает с tests/samples/authors.txt, пол задается именем (см. parse_enum)
+AuthorRecord parse_author(const std::string &line) {
+  AuthorRecord record;
+  std::string sex_name;
+
+  std::istringstream ss(line);
+  ss >> record.full_name >> record.age >> sex_name;
+
+  if (ss.fail()) {
+    // некорректная строка будет отклонена валидацией
+    return AuthorRecord{};
+  }
+
+  // нераспознанное имя пола оставляет Sex::UNDEFINED
+  parse_enum(sex_name, record.sex);
+  return record;
+}
+
+}  // namespace
 
 int main(int argc, char **argv) {
+  if (argc < 4) {
+    std::cerr << "usage: " << argv[0]
+              << " <contents_dir> <authors_manifest> <titles_manifest> [num_threads] [queue_capacity]" << std::endl;
+    return 1;
+  }
+
+  const std::filesystem::path contents_dir = argv[1];
+  const int num_threads = argc > 4 ? std::max(1, std::atoi(argv[4])) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  const int queue_capacity = argc > 5 ? std::max(1, std::atoi(argv[5])) : 256;
+
+  // манифесты
+  std::vector<AuthorRecord> authors;
+  for (const auto &line: read_lines(argv[2])) {
+    authors.push_back(parse_author(line));
+  }
+
+  const std::vector<std::string> titles = read_lines(argv[3]);
+
+  std::error_code error;
+  std::vector<std::filesystem::path> paths;
+
+  for (const auto &entry: std::filesystem::directory_iterator(contents_dir, error)) {
+    if (entry.is_regular_file()) {
+      paths.push_back(entry.path());
+    }
+  }
+
+  if (error || authors.empty() || titles.empty()) {
+    std::cerr << "failed to read contents directory or manifests" << std::endl;
+    return 1;
+  }
+
+  std::sort(paths.begin(), paths.end());
+
+  auto book_store = BookStore("Imported catalog");
+  book_store.Reserve(static_cast<int>(paths.size()));
+
+  auto content_queue = BoundedQueue<ContentItem>(queue_capacity);
+  auto book_queue = BoundedQueue<BookItem>(queue_capacity);
+
+  StageTimer read_timer;
+  StageTimer parse_timer;
+  StageTimer store_timer;
+  std::atomic<long long> num_bytes{0};
+
+  const auto start = Clock::now();
+
+  // стадия 1: чтение файлов
+  std::thread reader([&] {
+    for (int index = 0; index < static_cast<int>(paths.size()); index++) {
+      std::string content = read_timer.Measure([&] { return read_content_file(paths[index].string()); });
+      num_bytes += static_cast<long long>(content.size());
+
+      if (!content_queue.Push(ContentItem{index, std::move(content)})) break;
+    }
+    content_queue.Close();
+  });
+
+  // стадия 2: разбор и валидация в пуле потоков
+  std::atomic<int> num_active_workers{num_threads};
+  std::vector<std::thread> workers;
+
+  for (int worker = 0; worker < num_threads; worker++) {
+    workers.emplace_back([&] {
+      for (ContentItem item; content_queue.Pop(item); /* ... */) {
+        Result<Book> book = parse_timer.Measure([&] {
+          BookRecord record;
+          record.title = titles[item.index % titles.size()];
+          record.content = std::move(item.content);
+          record.authors.push_back(authors[item.index % authors.size()]);
+          return Book::TryCreate(record);
+        });
+
+        book_queue.Push(BookItem{item.index, std::move(book)});
+      }
+
+      // последний завершившийся обработчик закрывает выходную очередь
+      if (--num_active_workers == 0) {
+        book_queue.Close();
+      }
+    });
+  }
+
+  // стадия 3: добавление книг в магазин (в текущем потоке)
+  std::vector<RejectedRecord> rejected;
+  int num_store_failures = 0;  // книги, прошедшие валидацию, но не добавленные (не удалось увеличить хранилище)
+
+  for (BookItem item; book_queue.Pop(item); /* ... */) {
+    store_timer.Measure([&] {
+      if (item.book.IsOk()) {
+        if (book_store.AddBook(item.book.value) != ResizeStorageStatus::SUCCESS) {
+          std::cerr << "failed to store book #" << item.index << ": storage resize failed" << std::endl;
+          num_store_failures += 1;
+        }
+      } else {
+        rejected.push_back({item.index, item.book.status});
+      }
+    });
+  }
+
+  reader.join();
+  for (auto &worker: workers) {
+    worker.join();
+  }
+
+  const double total_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+  const double total_s = total_ms / 1000.0;
+  const double megabytes = static_cast<double>(num_bytes.load()) / (1024.0 * 1024.0);
+
+  std::cout << "files: " << paths.size() << ", threads: " << num_threads << ", queue capacity: " << queue_capacity
+            << std::endl;
+  std::cout << "imported: " << book_store.GetSize() << ", rejected: " << rejected.size() + num_store_failures
+            << std::endl;
+  std::cout << "read stage: " << read_timer.GetMs() << " ms" << std::endl;
+  std::cout << "parse stage: " << parse_timer.GetMs() << " ms (summed over " << num_threads << " threads)" << std::endl;
+  std::cout << "store stage: " << store_timer.GetMs() << " ms" << std::endl;
+  std::cout << "total: " << total_ms << " ms, "
+            << (total_s > 0 ? book_store.GetSize() / total_s : 0.0) << " books/s, "
+            << (total_s > 0 ? megabytes / total_s : 0.0) << " MB/s" << std::endl;
+
   return 0;
-}
\ No newline at end of file
+}
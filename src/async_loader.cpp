@@ -0,0 +1,80 @@
+#include "async_loader.hpp"
+
+#include <deque>
+#include <fstream>
+#include <utility>  // move
+
+AsyncContentLoader::AsyncContentLoader(int num_io_threads) : io_pool_{num_io_threads} {}
+
+std::future<std::string> AsyncContentLoader::LoadContent(const std::string &path) {
+  return io_pool_.Submit([path] { return read_content_file(path); });
+}
+
+std::future<Result<Book>> AsyncContentLoader::LoadBook(BookSource source) {
+  std::future<std::string> content = LoadContent(source.content_path);
+
+  // поток ввода-вывода только читает файл, валидация выполняется при get() в вызывающем потоке
+  return std::async(std::launch::deferred, [record = std::move(source.record), content = std::move(content)]() mutable {
+    record.content = content.get();
+    return Book::TryCreate(record);
+  });
+}
+
+BulkAddReport AsyncContentLoader::LoadBooksInto(BookStore &store,
+                                                const std::vector<BookSource> &sources,
+                                                int max_in_flight) {
+  BulkAddReport report;
+  max_in_flight = max_in_flight > 0 ? max_in_flight : 1;
+
+  store.Reserve(store.GetNumSlots() + static_cast<int>(sources.size()));
+
+  // скользящее окно загружаемых книг
+  std::deque<std::future<Result<Book>>> in_flight;
+  int next_source = 0;
+  int next_row = 0;
+
+  while (next_row < static_cast<int>(sources.size())) {
+    while (next_source < static_cast<int>(sources.size()) && static_cast<int>(in_flight.size()) < max_in_flight) {
+      in_flight.push_back(LoadBook(sources[next_source]));
+      next_source += 1;
+    }
+
+    // валидация очередной книги в вызывающем потоке, пока следующие файлы читаются
+    Result<Book> result = in_flight.front().get();
+    in_flight.pop_front();
+
+    if (result.IsOk()) {
+      if (store.AddBook(result.value) != ResizeStorageStatus::SUCCESS) {
+        break;  // хранилище не удалось увеличить (см. BookStore::AddBooks)
+      }
+      report.num_added += 1;
+    } else {
+      report.rejected.push_back({next_row, result.status});
+    }
+
+    next_row += 1;
+  }
+
+  return report;
+}
+
+int AsyncContentLoader::GetNumIoThreads() const {
+  return io_pool_.GetNumThreads();
+}
+
+std::string read_content_file(const std::string &path) {
+  std::string content;
+
+  if (auto fs = std::ifstream(path, std::ios::binary | std::ios::ate)) {
+    const auto size = fs.tellg();
+
+    if (size > 0) {
+      content.resize(static_cast<std::size_t>(size));
+      fs.seekg(0, std::ios::beg);
+      fs.read(content.data(), static_cast<std::streamsize>(content.size()));
+      content.resize(static_cast<std::size_t>(fs.gcount()));
+    }
+  }
+
+  return content;
+}
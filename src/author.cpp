@@ -1,6 +1,7 @@
 #include "author.hpp"
 
 #include <stdexcept>  // invalid_argument
+#include <utility>    // move
 
 // 1. реализуйте конструктор ...
 Author::Author(const std::string &full_name, int age, Sex sex) {
@@ -20,6 +21,44 @@ Author::Author(const std::string &full_name, int age, Sex sex) {
   // Tip 1: инициализируйте поля
 }
 
+Result<Author> Author::TryCreate(const std::string &full_name, int age, Sex sex) {
+  const ValidationStatus status = Validate(full_name, age);
+
+  if (status != ValidationStatus::SUCCESS) {
+    return Result<Author>::Error(status);
+  }
+
+  auto author = Author();
+  author.full_name_ = full_name;
+  author.age_ = age;
+  author.sex_ = sex;
+
+  return Result<Author>::Ok(std::move(author));
+}
+
+Result<Author> Author::TryCreate(const AuthorRecord &record) {
+  return TryCreate(record.full_name, record.age, record.sex);
+}
+
+Author Author::Restore(const std::string &full_name, int age, Sex sex) {
+  auto author = Author();
+  author.TrySetFullName(full_name);
+  author.TrySetAge(age);
+  author.SetSex(sex);
+
+  return author;
+}
+
+ValidationStatus Author::Validate(const std::string &full_name, int age) {
+  if (age < kMinAuthorAge) {
+    return ValidationStatus::AUTHOR_TOO_YOUNG;
+  }
+  if (full_name.empty()) {
+    return ValidationStatus::EMPTY_FULL_NAME;
+  }
+  return ValidationStatus::SUCCESS;
+}
+
 void Author::SetAge(int age) {
   if (age < kMinAuthorAge) {
     throw std::invalid_argument("Author::age must be greater than " + std::to_string(kMinAuthorAge));
@@ -38,6 +77,22 @@ void Author::SetFullName(const std::string &full_name) {
   full_name_ = full_name;
 }
 
+ValidationStatus Author::TrySetAge(int age) {
+  if (age < kMinAuthorAge) {
+    return ValidationStatus::AUTHOR_TOO_YOUNG;
+  }
+  age_ = age;
+  return ValidationStatus::SUCCESS;
+}
+
+ValidationStatus Author::TrySetFullName(const std::string &full_name) {
+  if (full_name.empty()) {
+    return ValidationStatus::EMPTY_FULL_NAME;
+  }
+  full_name_ = full_name;
+  return ValidationStatus::SUCCESS;
+}
+
 int Author::GetAge() const {
   return age_;
 }
@@ -0,0 +1,116 @@
+#include "author_index.hpp"
+
+#include <algorithm>  // lower_bound, sort, set_intersection
+#include <iterator>   // back_inserter
+
+namespace {
+
+// отношение длин списков, начиная с которого выгоднее экспоненциальный поиск
+constexpr std::size_t kGallopingRatio = 32;
+
+// экспоненциальный поиск первого элемента >= value, начиная с позиции first
+std::size_t gallop(const std::vector<int> &postings, std::size_t first, int value) {
+  std::size_t step = 1;
+  std::size_t last = first;
+
+  while (last < postings.size() && postings[last] < value) {
+    first = last;
+    last += step;
+    step *= 2;
+  }
+
+  last = std::min(last, postings.size());
+  return static_cast<std::size_t>(std::lower_bound(postings.begin() + first, postings.begin() + last, value) - postings.begin());
+}
+
+}  // namespace
+
+void AuthorIndex::Insert(const std::string &full_name, int position) {
+  auto &postings = postings_[full_name];
+
+  if (postings.empty() || postings.back() < position) {
+    postings.push_back(position);
+    return;
+  }
+
+  const auto it = std::lower_bound(postings.begin(), postings.end(), position);
+
+  if (*it != position) {
+    postings.insert(it, position);
+  }
+}
+
+const std::vector<int> &AuthorIndex::Find(const std::string &full_name) const {
+  static const std::vector<int> kEmptyPostings;
+
+  const auto it = postings_.find(full_name);
+  return it != postings_.end() ? it->second : kEmptyPostings;
+}
+
+std::vector<int> AuthorIndex::FindAll(const std::vector<std::string> &full_names) const {
+  if (full_names.empty()) {
+    return {};
+  }
+
+  std::vector<const std::vector<int> *> lists;
+  lists.reserve(full_names.size());
+
+  for (const auto &full_name: full_names) {
+    const auto &postings = Find(full_name);
+
+    if (postings.empty()) {
+      return {};
+    }
+    lists.push_back(&postings);
+  }
+
+  // самый короткий список ограничивает размер результата
+  std::sort(lists.begin(), lists.end(), [](const auto *lhs, const auto *rhs) { return lhs->size() < rhs->size(); });
+
+  std::vector<int> result = *lists.front();
+
+  for (std::size_t index = 1; index < lists.size() && !result.empty(); index++) {
+    result = intersect_postings(result, *lists[index]);
+  }
+
+  return result;
+}
+
+int AuthorIndex::GetNumAuthors() const {
+  return static_cast<int>(postings_.size());
+}
+
+const std::unordered_map<std::string, std::vector<int>> &AuthorIndex::GetPostings() const {
+  return postings_;
+}
+
+void AuthorIndex::Clear() {
+  postings_ = {};
+}
+
+std::vector<int> intersect_postings(const std::vector<int> &lhs, const std::vector<int> &rhs) {
+  const auto &shorter = lhs.size() <= rhs.size() ? lhs : rhs;
+  const auto &longer = lhs.size() <= rhs.size() ? rhs : lhs;
+
+  std::vector<int> result;
+  result.reserve(shorter.size());
+
+  if (longer.size() < shorter.size() * kGallopingRatio) {
+    std::set_intersection(shorter.begin(), shorter.end(), longer.begin(), longer.end(), std::back_inserter(result));
+    return result;
+  }
+
+  std::size_t cursor = 0;
+
+  for (int position: shorter) {
+    cursor = gallop(longer, cursor, position);
+
+    if (cursor == longer.size()) break;
+
+    if (longer[cursor] == position) {
+      result.push_back(position);
+    }
+  }
+
+  return result;
+}
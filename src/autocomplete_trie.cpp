@@ -0,0 +1,234 @@
+#include "autocomplete_trie.hpp"
+
+#include <algorithm>  // find, lower_bound, min
+#include <queue>      // priority_queue
+#include <utility>    // move, swap
+
+namespace {
+
+// ключ строки в дереве: латинские буквы в нижнем регистре
+std::string to_key(std::string_view text) {
+  std::string key(text);
+
+  for (char &symbol: key) {
+    if (symbol >= 'A' && symbol <= 'Z') {
+      symbol = static_cast<char>(symbol | 0x20);
+    }
+  }
+
+  return key;
+}
+
+}  // namespace
+
+void AutocompleteTrie::Insert(const std::string &text) {
+  if (nodes_.empty()) {
+    nodes_.emplace_back();  // корень
+  }
+
+  const std::string key = to_key(text);
+
+  std::vector<int> path = {0};
+  int node = 0;
+  std::size_t position = 0;
+
+  while (position < key.size()) {
+    int child = find_child(node, key[position]);
+
+    if (child < 0) {
+      node = add_child(node, key.substr(position));
+      path.push_back(node);
+      break;
+    }
+
+    const std::string &label = nodes_[child].label;
+    std::size_t common = 0;
+
+    while (common < label.size() && position + common < key.size() && label[common] == key[position + common]) {
+      common++;
+    }
+
+    if (common < label.size()) {
+      // разбиение ребра: промежуточный узел получает общую часть метки и кэш поддерева
+      Node middle;
+      middle.label = label.substr(0, common);
+      middle.children = {child};
+      middle.top = nodes_[child].top;
+
+      nodes_[child].label.erase(0, common);
+
+      const int middle_index = static_cast<int>(nodes_.size());
+      nodes_.push_back(std::move(middle));
+
+      auto &children = nodes_[node].children;
+      *std::find(children.begin(), children.end(), child) = middle_index;
+
+      child = middle_index;
+    }
+
+    node = child;
+    position += common;
+    path.push_back(node);
+  }
+
+  if (nodes_[node].term < 0) {
+    nodes_[node].term = GetSize();
+    terms_.push_back(text);
+    weights_.push_back(0);
+  }
+
+  const int term = nodes_[node].term;
+  weights_[term] += 1;
+
+  for (int ancestor: path) {
+    update_top(ancestor, term);
+  }
+}
+
+std::vector<std::string> AutocompleteTrie::Complete(std::string_view prefix, int limit) const {
+  std::vector<std::string> completions;
+
+  if (limit <= 0) {
+    return completions;
+  }
+
+  Complete(prefix, [&](const std::string &text, int) {
+    completions.push_back(text);
+    return static_cast<int>(completions.size()) < limit;
+  });
+
+  return completions;
+}
+
+int AutocompleteTrie::GetSize() const {
+  return static_cast<int>(terms_.size());
+}
+
+void AutocompleteTrie::Clear() {
+  nodes_ = {};
+  terms_ = {};
+  weights_ = {};
+}
+
+int AutocompleteTrie::find_node(std::string_view prefix) const {
+  if (nodes_.empty()) {
+    return -1;
+  }
+
+  const std::string key = to_key(prefix);
+
+  int node = 0;
+  std::size_t position = 0;
+
+  while (position < key.size()) {
+    const int child = find_child(node, key[position]);
+
+    if (child < 0) {
+      return -1;
+    }
+
+    // префикс может закончиться посреди метки ребра
+    const std::string &label = nodes_[child].label;
+    const std::size_t length = std::min(label.size(), key.size() - position);
+
+    if (label.compare(0, length, key, position, length) != 0) {
+      return -1;
+    }
+
+    node = child;
+    position += length;
+  }
+
+  return node;
+}
+
+int AutocompleteTrie::find_child(int node, char symbol) const {
+  const auto &children = nodes_[node].children;
+
+  const auto it = std::lower_bound(children.begin(), children.end(), symbol, [this](int child, char value) {
+    return nodes_[child].label.front() < value;
+  });
+
+  return it != children.end() && nodes_[*it].label.front() == symbol ? *it : -1;
+}
+
+int AutocompleteTrie::add_child(int parent, std::string label) {
+  const int child = static_cast<int>(nodes_.size());
+  const char symbol = label.front();
+
+  nodes_.emplace_back();
+  nodes_.back().label = std::move(label);
+
+  auto &children = nodes_[parent].children;
+
+  const auto it = std::lower_bound(children.begin(), children.end(), symbol, [this](int sibling, char value) {
+    return nodes_[sibling].label.front() < value;
+  });
+  children.insert(it, child);
+
+  return child;
+}
+
+void AutocompleteTrie::walk_subtree(int node, int num_skipped, const std::function<bool(int term)> &visit) const {
+  // элемент очереди: строка (node = -1) или узел, ключ которого - лучшая строка его поддерева,
+  // поэтому ни одна строка поддерева не выдается раньше строки с большим весом
+  struct Entry {
+    int term;
+    int node;
+  };
+
+  const auto is_worse = [this](const Entry &lhs, const Entry &rhs) { return is_better(rhs.term, lhs.term); };
+  std::priority_queue<Entry, std::vector<Entry>, decltype(is_worse)> queue(is_worse);
+
+  queue.push({nodes_[node].top.front(), node});
+
+  while (!queue.empty()) {
+    const Entry entry = queue.top();
+    queue.pop();
+
+    if (entry.node < 0) {
+      if (num_skipped > 0) {
+        num_skipped -= 1;
+      } else if (!visit(entry.term)) {
+        return;
+      }
+      continue;
+    }
+
+    const Node &current = nodes_[entry.node];
+
+    if (current.term >= 0) {
+      queue.push({current.term, -1});
+    }
+    for (int child: current.children) {
+      queue.push({nodes_[child].top.front(), child});
+    }
+  }
+}
+
+void AutocompleteTrie::update_top(int node, int term) {
+  auto &top = nodes_[node].top;
+
+  auto it = std::find(top.begin(), top.end(), term);
+
+  if (it == top.end()) {
+    if (static_cast<int>(top.size()) < kMaxCompletions) {
+      top.push_back(term);
+    } else if (is_better(term, top.back())) {
+      top.back() = term;
+    } else {
+      return;
+    }
+    it = top.end() - 1;
+  }
+
+  // вес строки вырос - она поднимается к началу кэша
+  for (; it != top.begin() && is_better(*it, *(it - 1)); --it) {
+    std::swap(*it, *(it - 1));
+  }
+}
+
+bool AutocompleteTrie::is_better(int lhs, int rhs) const {
+  if (weights_[lhs] != weights_[rhs]) return weights_[lhs] > weights_[rhs];
+  return terms_[lhs] < terms_[rhs];
+}
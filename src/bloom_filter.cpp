@@ -0,0 +1,136 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>   // max
+#include <cmath>       // ceil, log, pow
+#include <functional>  // hash
+#include <stdexcept>   // invalid_argument, logic_error
+
+namespace {
+
+// нечетные множители для выбора бита в каждом слове блока (как в split block фильтрах Parquet)
+constexpr std::array<std::uint32_t, BloomFilter::kWordsPerBlock> kSalts = {
+    0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+constexpr int kBitsPerBlock = BloomFilter::kWordsPerBlock * 64;
+
+// запас размера на неравномерное заполнение блоков
+constexpr double kBlockSlack = 1.1;
+
+// перемешивание битов хэша (финализатор splitmix64)
+std::uint64_t mix(std::uint64_t hash) {
+  hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+  hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+  return hash ^ (hash >> 31);
+}
+
+std::uint64_t hash_key(std::string_view key) {
+  return mix(std::hash<std::string_view>{}(key));
+}
+
+}  // namespace
+
+double BloomFilterStats::GetNegativeRate() const {
+  return num_queries > 0 ? static_cast<double>(num_negatives) / static_cast<double>(num_queries) : 0.0;
+}
+
+double BloomFilterStats::GetFalsePositiveRate() const {
+  const long long num_absent = num_negatives + num_false_positives;
+  return num_absent > 0 ? static_cast<double>(num_false_positives) / static_cast<double>(num_absent) : 0.0;
+}
+
+BloomFilter::BloomFilter(int capacity, double false_positive_rate)
+    : capacity_{capacity}, false_positive_rate_{false_positive_rate} {
+  if (capacity < 1) {
+    throw std::invalid_argument("BloomFilter::capacity must be positive");
+  }
+  if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+    throw std::invalid_argument("BloomFilter::false_positive_rate must be in (0, 1)");
+  }
+
+  // каждый ключ устанавливает по одному биту в каждом слове блока (k = kWordsPerBlock),
+  // поэтому при n ключах и c бит на ключ p = (1 - e^(-k / c))^k, откуда c = -k / ln(1 - p^(1/k));
+  // распределение ключей по блокам неравномерно, поэтому размер увеличивается на kBlockSlack
+  const double bits_per_key =
+      -kWordsPerBlock / std::log(1.0 - std::pow(false_positive_rate, 1.0 / kWordsPerBlock)) * kBlockSlack;
+
+  const double num_bits = std::ceil(bits_per_key * static_cast<double>(capacity));
+  blocks_.resize(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(num_bits / kBitsPerBlock))));
+}
+
+bool BloomFilter::Insert(std::string_view key) {
+  if (blocks_.empty()) {
+    throw std::logic_error("BloomFilter::Insert requires a filter with positive capacity");
+  }
+
+  const std::uint64_t hash = hash_key(key);
+  const Block mask = make_mask(static_cast<std::uint32_t>(hash));
+  Block &block = blocks_[block_index(hash)];
+
+  std::uint64_t added = 0;
+
+  for (int word = 0; word < kWordsPerBlock; word++) {
+    added |= mask.words[word] & ~block.words[word];
+    block.words[word] |= mask.words[word];
+  }
+
+  if (added == 0) {
+    return false;
+  }
+
+  size_ += 1;
+  return true;
+}
+
+bool BloomFilter::MightContain(std::string_view key) const {
+  if (blocks_.empty()) {
+    return false;
+  }
+
+  const std::uint64_t hash = hash_key(key);
+  const Block mask = make_mask(static_cast<std::uint32_t>(hash));
+  const Block &block = blocks_[block_index(hash)];
+
+  // без досрочного выхода: цикл фиксированной длины без ветвлений
+  std::uint64_t missing = 0;
+
+  for (int word = 0; word < kWordsPerBlock; word++) {
+    missing |= mask.words[word] & ~block.words[word];
+  }
+
+  return missing == 0;
+}
+
+int BloomFilter::GetSize() const {
+  return size_;
+}
+
+int BloomFilter::GetCapacity() const {
+  return capacity_;
+}
+
+double BloomFilter::GetFalsePositiveRate() const {
+  return false_positive_rate_;
+}
+
+void BloomFilter::Clear() {
+  blocks_ = {};
+  size_ = 0;
+  capacity_ = 0;
+  false_positive_rate_ = 0.0;
+}
+
+BloomFilter::Block BloomFilter::make_mask(std::uint32_t hash) const {
+  Block mask;
+
+  // старшие 6 бит произведения - номер бита в слове
+  for (int word = 0; word < kWordsPerBlock; word++) {
+    mask.words[word] = std::uint64_t{1} << ((hash * kSalts[word]) >> 26);
+  }
+
+  return mask;
+}
+
+std::size_t BloomFilter::block_index(std::uint64_t hash) const {
+  // отображение старших 32 бит хэша на [0, кол-во блоков) без деления
+  return static_cast<std::size_t>(((hash >> 32) * blocks_.size()) >> 32);
+}
@@ -1,6 +1,27 @@
 #include "book.hpp"
 
+#include <initializer_list>
 #include <stdexcept>  // invalid_argument
+#include <utility>    // move
+
+namespace {
+
+/**
+ * Замена значения разделяемого буфера поля книги.
+ * Единственный владелец переиспользует свой буфер, иначе создается новый.
+ */
+template <typename T, typename Value>
+void assign(std::shared_ptr<T> &field, Value &&value) {
+  if (field != nullptr && field.use_count() == 1) {
+    *field = std::forward<Value>(value);
+  } else {
+    field = std::make_shared<T>(std::forward<Value>(value));
+  }
+}
+
+const std::string kEmptyString;
+
+}  // namespace
 
 // 1. реализуйте конструктор ...
 Book::Book(const std::string &title,
@@ -13,48 +34,129 @@ Book::Book(const std::string &title,
   if (title.empty()) {
     throw std::invalid_argument("Book::title cannot be empty");
   }else{
-      title_ = title;
+      assign(title_, title);
   }
 
   if (content.empty()) {
     throw std::invalid_argument(
         "Book::content cannot be empty");
   }else{
-      content_ = content;
+      assign(content_, content);
   }
 
   if (authors.empty()) {
     throw std::invalid_argument("Book::authors cannot be empty");
   }else{
-      authors_ = authors;
+      authors_ = AuthorList(authors.begin(), authors.end());
   }
   genre_ = genre;
   publisher_ = publisher;
   // Tip 1: остались слезы на щеках, осталось лишь инициализировать поля ...
 }
 
+Result<Book> Book::TryCreate(const std::string &title,
+                             const std::string &content,
+                             Genre genre,
+                             Publisher publisher,
+                             const std::vector<Author> &authors) {
+  if (title.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_TITLE);
+  }
+  if (content.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_CONTENT);
+  }
+  if (authors.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_AUTHORS);
+  }
+
+  auto book = Book();
+  assign(book.title_, title);
+  assign(book.content_, content);
+  book.authors_ = AuthorList(authors.begin(), authors.end());
+  book.genre_ = genre;
+  book.publisher_ = publisher;
+
+  return Result<Book>::Ok(std::move(book));
+}
+
+Result<Book> Book::TryCreate(const BookRecord &record) {
+  // дешевые проверки выполняются до копирования строк
+  if (record.title.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_TITLE);
+  }
+  if (record.content.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_CONTENT);
+  }
+  if (record.authors.empty()) {
+    return Result<Book>::Error(ValidationStatus::EMPTY_AUTHORS);
+  }
+
+  auto book = Book();
+  book.authors_.Reserve(static_cast<int>(record.authors.size()));
+
+  // каждый автор проверяется один раз; название и содержание копируются после проверки всех авторов
+  for (const auto &author: record.authors) {
+    Result<Author> result = Author::TryCreate(author);
+
+    if (!result.IsOk()) {
+      return Result<Book>::Error(result.status);
+    }
+    book.authors_.PushBack(std::move(result.value));
+  }
+
+  assign(book.title_, record.title);
+  assign(book.content_, record.content);
+  book.genre_ = record.genre;
+  book.publisher_ = record.publisher;
+
+  return Result<Book>::Ok(std::move(book));
+}
+
+Book Book::Restore(const std::string &title,
+                   const std::string &content,
+                   Genre genre,
+                   Publisher publisher,
+                   const std::vector<Author> &authors) {
+  Result<Book> result = TryCreate(title, content, genre, publisher, authors);
+
+  if (result.IsOk()) {
+    return std::move(result.value);
+  }
+
+  auto book = Book();
+  book.TrySetTitle(title);
+  book.TrySetContent(content);
+  book.SetGenre(genre);
+  book.SetPublisher(publisher);
+
+  for (const auto &author: authors) {
+    book.AddAuthor(author);
+  }
+
+  return book;
+}
+
 // 2. реализуйте метод ...
 bool Book::AddAuthor(const Author &author) {
   // здесь мог бы быть ваш сногсшибающий код ...
   // Tip 1: для поиска дубликатов можно использовать цикл for-each
-  for(Author a : authors_){
-      if(a.GetFullName() ==  author.GetFullName()){
+  for (const Author &a : GetAuthors()) {
+      if (a.GetFullName() == author.GetFullName()) {
           return false;
-      }else{
-          authors_.push_back(author);
       }
   }
+  authors_.PushBack(author);
   return true;
 }
 
 // РЕАЛИЗОВАНО
 
 const std::string &Book::GetTitle() const {
-  return title_;
+  return title_ != nullptr ? *title_ : kEmptyString;
 }
 
 const std::string &Book::GetContent() const {
-  return content_;
+  return content_ != nullptr ? *content_ : kEmptyString;
 }
 
 Genre Book::GetGenre() const {
@@ -65,7 +167,7 @@ Publisher Book::GetPublisher() const {
   return publisher_;
 }
 
-const std::vector<Author> &Book::GetAuthors() const {
+const AuthorList &Book::GetAuthors() const {
   return authors_;
 }
 
@@ -73,14 +175,30 @@ void Book::SetTitle(const std::string &title) {
   if (title.empty()) {
     throw std::invalid_argument("Book::title cannot be empty");
   }
-  title_ = title;
+  assign(title_, title);
 }
 
 void Book::SetContent(const std::string &content) {
   if (content.empty()) {
     throw std::invalid_argument("Book::content cannot be empty");
   }
-  content_ = content;
+  assign(content_, content);
+}
+
+ValidationStatus Book::TrySetTitle(const std::string &title) {
+  if (title.empty()) {
+    return ValidationStatus::EMPTY_TITLE;
+  }
+  assign(title_, title);
+  return ValidationStatus::SUCCESS;
+}
+
+ValidationStatus Book::TrySetContent(const std::string &content) {
+  if (content.empty()) {
+    return ValidationStatus::EMPTY_CONTENT;
+  }
+  assign(content_, content);
+  return ValidationStatus::SUCCESS;
 }
 
 void Book::SetGenre(Genre genre) {
@@ -90,3 +208,22 @@ void Book::SetGenre(Genre genre) {
 void Book::SetPublisher(Publisher publisher) {
   publisher_ = publisher;
 }
+
+void Book::AccountMemory(MemoryBreakdown &usage) const {
+  for (const auto *field: {&title_, &content_}) {
+    if (*field) {
+      usage.shared_block_bytes += kSharedControlBytes + sizeof(std::string);
+      account_string(**field, usage);
+    }
+  }
+
+  // встроенный буфер авторов входит в размер книги, в куче - только переполненные списки
+  if (!authors_.IsInline()) {
+    usage.author_vector_bytes += authors_.size() * sizeof(Author);
+    usage.author_slack_bytes += (static_cast<std::size_t>(authors_.GetCapacity()) - authors_.size()) * sizeof(Author);
+  }
+
+  for (const auto &author: authors_) {
+    account_string(author.GetFullName(), usage);
+  }
+}
@@ -0,0 +1,169 @@
+#include "book_aggregate.hpp"
+
+#include <algorithm>  // max
+#include <stdexcept>  // invalid_argument
+#include <utility>    // pair
+
+#include "top_k.hpp"  // TopK
+
+void CatalogAggregate::Add(const Book &book) {
+  apply(book, +1);
+}
+
+void CatalogAggregate::Remove(const Book &book) {
+  apply(book, -1);
+}
+
+int CatalogAggregate::GetCount(Genre genre) const {
+  return genre_counts[static_cast<int>(genre)];
+}
+
+int CatalogAggregate::GetCount(Publisher publisher) const {
+  return publisher_counts[static_cast<int>(publisher)];
+}
+
+int CatalogAggregate::GetCount(Sex sex) const {
+  return author_sex_counts[static_cast<int>(sex)];
+}
+
+void CatalogAggregate::apply(const Book &book, int sign) {
+  num_books += sign;
+  content_bytes += sign * static_cast<long long>(book.GetContent().size());
+  genre_counts[static_cast<int>(book.GetGenre())] += sign;
+  publisher_counts[static_cast<int>(book.GetPublisher())] += sign;
+
+  for (const auto &author: book.GetAuthors()) {
+    author_sex_counts[static_cast<int>(author.GetSex())] += sign;
+  }
+}
+
+void GenrePublisherAggregate::Add(const Book &book) {
+  counts_[static_cast<int>(book.GetGenre()) * CatalogAggregate::kNumPublishers + static_cast<int>(book.GetPublisher())] += 1;
+}
+
+void GenrePublisherAggregate::Remove(const Book &book) {
+  counts_[static_cast<int>(book.GetGenre()) * CatalogAggregate::kNumPublishers + static_cast<int>(book.GetPublisher())] -= 1;
+}
+
+std::vector<GenrePublisherCount> GenrePublisherAggregate::Top(int k) const {
+  auto top = TopK<std::pair<int, int>>(k);
+
+  for (int pair = 0; pair < kNumPairs; pair++) {
+    if (counts_[pair] > 0) {
+      top.Push({counts_[pair], -pair});  // при равенстве выше пара с меньшим номером
+    }
+  }
+
+  std::vector<GenrePublisherCount> result;
+
+  for (const auto &[count, pair]: top.Extract()) {
+    result.push_back({static_cast<Genre>(-pair / CatalogAggregate::kNumPublishers),
+                      static_cast<Publisher>(-pair % CatalogAggregate::kNumPublishers), count});
+  }
+
+  return result;
+}
+
+int GenrePublisherAggregate::GetCount(Genre genre, Publisher publisher) const {
+  return counts_[static_cast<int>(genre) * CatalogAggregate::kNumPublishers + static_cast<int>(publisher)];
+}
+
+AuthorHeavyHittersAggregate::AuthorHeavyHittersAggregate(int capacity) : summary_{capacity} {}
+
+void AuthorHeavyHittersAggregate::Add(const Book &book) {
+  for (const auto &author: book.GetAuthors()) {
+    summary_.Add(author.GetFullName());
+  }
+}
+
+void AuthorHeavyHittersAggregate::Remove(const Book &book) {
+  for (const auto &author: book.GetAuthors()) {
+    summary_.Remove(author.GetFullName());
+  }
+}
+
+std::vector<AuthorBookCount> AuthorHeavyHittersAggregate::Top(int k) const {
+  std::vector<AuthorBookCount> result;
+
+  for (const auto &counter: summary_.Top(k)) {
+    // счетчик автора, все книги которого удалены, остается в сводке с нулевым значением
+    if (counter.count > 0) {
+      result.push_back({counter.key, counter.count});
+    }
+  }
+
+  return result;
+}
+
+PresenceFilterAggregate::PresenceFilterAggregate(double false_positive_rate, int capacity)
+    : false_positive_rate_{false_positive_rate} {
+  if (!(false_positive_rate > 0.0 && false_positive_rate < 1.0)) {
+    throw std::invalid_argument("PresenceFilterAggregate::false_positive_rate must be in (0, 1)");
+  }
+
+  capacity = std::max(capacity, 1);
+  title_filter_ = BloomFilter(capacity, false_positive_rate_);
+  author_filter_ = BloomFilter(capacity, false_positive_rate_);
+}
+
+void PresenceFilterAggregate::Add(const Book &book) {
+  title_filter_.Insert(book.GetTitle());
+
+  for (const auto &author: book.GetAuthors()) {
+    author_filter_.Insert(author.GetFullName());
+  }
+
+  num_books_ += 1;
+}
+
+void PresenceFilterAggregate::Remove(const Book &) {
+  // строки удаленной книги остаются в фильтрах до пересчета
+  num_books_ -= 1;
+  num_removed_ += 1;
+}
+
+bool PresenceFilterAggregate::NeedsRebuild() const {
+  // каждый фильтр сравнивается со своей вместимостью (имен авторов может быть больше, чем названий);
+  // уплотнение не меняет набор строк в фильтрах и пересчета не требует (шаги уплотнения остаются ограниченными)
+  return title_filter_.GetSize() >= title_filter_.GetCapacity() ||
+         author_filter_.GetSize() >= author_filter_.GetCapacity() ||
+         num_removed_ > std::max(num_books_, kInitCapacity);
+}
+
+void PresenceFilterAggregate::Reset() {
+  // запас вдвое от кол-ва ключей каждого фильтра: пересчет из-за заполнения происходит не чаще
+  // удвоения кол-ва ключей. У книги одно название, но авторов может быть несколько, поэтому
+  // фильтр имен рассчитывается по различным именам прежнего фильтра (среди них все имена живых книг)
+  const int title_capacity = std::max(kInitCapacity, 2 * num_books_);
+  const int author_capacity = std::max(kInitCapacity, 2 * author_filter_.GetSize());
+
+  title_filter_ = BloomFilter(title_capacity, false_positive_rate_);
+  author_filter_ = BloomFilter(author_capacity, false_positive_rate_);
+  num_books_ = 0;
+  num_removed_ = 0;
+  num_rebuilds_ += 1;
+}
+
+bool PresenceFilterAggregate::MightContainTitle(std::string_view title) const {
+  return title_filter_.MightContain(title);
+}
+
+bool PresenceFilterAggregate::MightContainAuthor(std::string_view full_name) const {
+  return author_filter_.MightContain(full_name);
+}
+
+int PresenceFilterAggregate::GetCapacity() const {
+  return title_filter_.GetCapacity();
+}
+
+int PresenceFilterAggregate::GetAuthorCapacity() const {
+  return author_filter_.GetCapacity();
+}
+
+int PresenceFilterAggregate::GetNumRebuilds() const {
+  return num_rebuilds_;
+}
+
+double PresenceFilterAggregate::GetFalsePositiveRate() const {
+  return false_positive_rate_;
+}
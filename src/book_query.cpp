@@ -0,0 +1,133 @@
+#include "book_query.hpp"
+
+#include <algorithm>  // sort, upper_bound
+#include <cstdio>     // snprintf
+#include <utility>    // move
+
+BookQuery::BookQuery(const BookStore &store) : store_{store} {}
+
+BookQuery &BookQuery::WhereGenre(Genre genre) {
+  return WhereGenreIn({genre});
+}
+
+BookQuery &BookQuery::WhereGenreIn(const std::vector<Genre> &genres) {
+  std::uint32_t mask = 0;
+  for (Genre genre: genres) {
+    mask |= 1u << static_cast<int>(genre);
+  }
+  genre_mask_ &= mask;
+  return *this;
+}
+
+BookQuery &BookQuery::WherePublisher(Publisher publisher) {
+  return WherePublisherIn({publisher});
+}
+
+BookQuery &BookQuery::WherePublisherIn(const std::vector<Publisher> &publishers) {
+  std::uint32_t mask = 0;
+  for (Publisher publisher: publishers) {
+    mask |= 1u << static_cast<int>(publisher);
+  }
+  publisher_mask_ &= mask;
+  return *this;
+}
+
+BookQuery &BookQuery::WhereAuthorOlderThan(int age) {
+  return where([age](const Book &book) {
+    for (const auto &author: book.GetAuthors()) {
+      if (author.GetAge() > age) return true;
+    }
+    return false;
+  }, PredicateCost::MEDIUM, "older", std::to_string(age));
+}
+
+BookQuery &BookQuery::WhereAuthor(const std::string &full_name) {
+  return where([full_name](const Book &book) {
+    for (const auto &author: book.GetAuthors()) {
+      if (author.GetFullName() == full_name) return true;
+    }
+    return false;
+  }, PredicateCost::MEDIUM, "author", full_name);
+}
+
+BookQuery &BookQuery::WhereContentContains(const std::string &text) {
+  return where([text](const Book &book) {
+    return book.GetContent().find(text) != std::string::npos;
+  }, PredicateCost::EXPENSIVE, "content", text);
+}
+
+BookQuery &BookQuery::WhereTitleContains(const std::string &text) {
+  return where([text](const Book &book) {
+    return book.GetTitle().find(text) != std::string::npos;
+  }, PredicateCost::CHEAP, "title", text);
+}
+
+BookQuery &BookQuery::Where(std::function<bool(const Book &)> predicate, PredicateCost cost) {
+  // произвольный предикат нельзя сравнить с другим - такой запрос не кэшируется
+  is_cacheable_ = false;
+  return where(std::move(predicate), cost);
+}
+
+BookQuery &BookQuery::where(std::function<bool(const Book &)> predicate, PredicateCost cost) {
+  // вставка после предикатов той же стоимости сохраняет порядок добавления
+  const auto position = std::upper_bound(predicates_.begin(), predicates_.end(), cost,
+                                         [](PredicateCost lhs, const Predicate &rhs) { return lhs < rhs.cost; });
+  predicates_.insert(position, Predicate{std::move(predicate), cost});
+  return *this;
+}
+
+BookQuery &BookQuery::where(std::function<bool(const Book &)> predicate, PredicateCost cost,
+                            const char *tag, const std::string &value) {
+  // длина значения в ключе исключает неоднозначность при разделителях внутри значения
+  predicate_keys_.push_back(std::string(tag) + ':' + std::to_string(value.size()) + ':' + value);
+  return where(std::move(predicate), cost);
+}
+
+BookQuery &BookQuery::Limit(int limit) {
+  limit_ = limit < 0 ? -1 : limit;
+  return *this;
+}
+
+std::vector<int> BookQuery::Indices() const {
+  std::vector<int> indices;
+  ForEach([&](const Book &, int index) { indices.push_back(index); });
+  return indices;
+}
+
+int BookQuery::Count() const {
+  int count = 0;
+  ForEach([&](const Book &, int) { count += 1; });
+  return count;
+}
+
+bool BookQuery::Matches(const Book &book) const {
+  return matches(book);
+}
+
+std::string BookQuery::GetKey() const {
+  if (!is_cacheable_) {
+    return {};
+  }
+
+  char header[64];
+  std::snprintf(header, sizeof(header), "g%x|p%x|l%d", genre_mask_, publisher_mask_, limit_);
+
+  // порядок вызова фильтров не меняет результат, поэтому ключи предикатов упорядочиваются
+  std::vector<std::string> keys = predicate_keys_;
+  std::sort(keys.begin(), keys.end());
+
+  std::string key = header;
+  for (const auto &predicate_key: keys) {
+    key += '|';
+    key += predicate_key;
+  }
+  return key;
+}
+
+int BookQuery::GetLimit() const {
+  return limit_;
+}
+
+const BookStore &BookQuery::GetStore() const {
+  return store_;
+}
@@ -1,7 +1,12 @@
 #include "book_store.hpp"
 
-#include <algorithm>  // copy
-#include <stdexcept>  // invalid_argument
+#include <algorithm>  // any_of, copy, count_if, max, min, sort, unique
+#include <limits>
+#include <stdexcept>  // invalid_argument, logic_error, runtime_error
+#include <utility>    // move, pair
+
+#include "top_k.hpp"            // TopK
+#include "write_ahead_log.hpp"  // WriteAheadLog
 
 // 1. реализуйте функцию ...
 ResizeStorageStatus resize_storage(Book *&storage, int size, int new_capacity) {
@@ -48,21 +53,315 @@ BookStore::~BookStore() {
         delete[] storage_;
         storage_ = nullptr;
     }
+    if (compaction_.shrunk_storage != nullptr) {
+        delete[] compaction_.shrunk_storage;
+        compaction_.shrunk_storage = nullptr;
+    }
+    indexes_ = {};
+    compaction_ = {};
+    book_ids_ = {};
+    id_positions_ = {};
+    log_offsets_ = {};
+    num_removed_ = 0;
+    book_memory_ = {};
+    presence_filters_ = nullptr;
+    title_filter_stats_.Reset();
+    author_filter_stats_.Reset();
+    is_near_duplicates_enabled_ = false;
+    catalog_ = {};
+    aggregates_.clear();
     storage_capacity_ = 0;
     storage_size_ = 0;
 }
 
 // 4. реализуйте метод ...
-void BookStore::AddBook(const Book &book) {
+ResizeStorageStatus BookStore::AddBook(const Book &book) {
+    // хранилище меньшего объема не вмещает новую книгу - уплотнение продолжится без сжатия
+    if (compaction_.phase == CompactionPhase::SHRINKING && storage_size_ == compaction_.shrunk_capacity) {
+        cancel_shrinking();
+    }
+
     if (storage_size_ == storage_capacity_) {
-        resize_storage_internal(storage_capacity_ + kCapacityCoefficient);
-        // здесь мог бы быть ваш умопомрачительный код ...
-        // Tip 1: используйте функцию resize_storage_internal, задав новый размер хранилища
-        // Tip 2: не забудьте обработать статус вызова функции
+        const ResizeStorageStatus status = resize_storage_internal(grown_capacity());
+
+        // без места в хранилище книга не добавляется (запись за его границу недопустима)
+        if (status != ResizeStorageStatus::SUCCESS) {
+            return status;
+        }
     }
-    // Tip 3: не забудьте добавить книгу в наше бездонное хранилище ...
+
+    // книга фиксируется в журнале, когда место под нее уже есть: восстановленный журнал
+    // не должен содержать книг, которые не попали в магазин
+    long long log_offset = kNoLogOffset;
+
+    if (log_ != nullptr && log_->Append(book, &log_offset) != WalStatus::SUCCESS) {
+        throw std::runtime_error("BookStore::log failed to persist the book");
+    }
+
     storage_[storage_size_] = book;
+    book_ids_.push_back(static_cast<int>(id_positions_.size()));
+    log_offsets_.push_back(log_offset);
+    id_positions_.push_back(storage_size_);
+    storage_[storage_size_].AccountMemory(book_memory_);
+    index_book(storage_size_);
     storage_size_ += 1;
+    rebuild_aggregates();
+
+    return ResizeStorageStatus::SUCCESS;
+}
+
+BulkAddReport BookStore::AddBooks(const std::vector<BookRecord> &records) {
+    BulkAddReport report;
+
+    // одно увеличение хранилища на весь пакет вместо пошагового
+    Reserve(storage_size_ + static_cast<int>(records.size()));
+
+    for (int row = 0; row < static_cast<int>(records.size()); row++) {
+        Result<Book> result = Book::TryCreate(records[row]);
+
+        if (!result.IsOk()) {
+            report.rejected.push_back({row, result.status});
+            continue;
+        }
+
+        if (AddBook(result.value) != ResizeStorageStatus::SUCCESS) {
+            break;
+        }
+        report.num_added += 1;
+    }
+
+    return report;
+}
+
+void BookStore::AttachLog(WriteAheadLog *log) {
+    log_ = log;
+}
+
+void BookStore::restore_log_offset(int index, long long offset) {
+    log_offsets_[index] = offset;
+}
+
+ResizeStorageStatus BookStore::Reserve(int capacity) {
+    // зарезервированный объем не должен потеряться при сжатии хранилища
+    if (compaction_.phase == CompactionPhase::SHRINKING && capacity > compaction_.shrunk_capacity) {
+        cancel_shrinking();
+    }
+
+    if (capacity <= storage_capacity_) {
+        return ResizeStorageStatus::SUCCESS;
+    }
+    return resize_storage_internal(capacity);
+}
+
+bool BookStore::AddBookAuthor(int index, const Author &author) {
+    if (index < 0 || index >= storage_size_) {
+        throw std::invalid_argument("BookStore::index is out of range");
+    }
+
+    if (book_ids_[index] == kRemovedId) {
+        return false;
+    }
+
+    // дубликат проверяется заранее, чтобы журнал не содержал отклоненных авторов
+    const auto &authors = storage_[index].GetAuthors();
+    if (std::any_of(authors.begin(), authors.end(),
+                    [&author](const Author &other) { return other.GetFullName() == author.GetFullName(); })) {
+        return false;
+    }
+
+    if (log_ != nullptr && log_offsets_[index] != kNoLogOffset &&
+        log_->AppendAuthor(log_offsets_[index], author) != WalStatus::SUCCESS) {
+        throw std::runtime_error("BookStore::log failed to persist the author");
+    }
+
+    // список авторов может быть перенесен в кучу - учет памяти книги пересчитывается
+    MemoryBreakdown memory_before;
+    storage_[index].AccountMemory(memory_before);
+
+    // прежняя версия книги нужна агрегатам (копия разделяет строки с книгой)
+    const Book before = storage_[index];
+    const bool is_added = storage_[index].AddAuthor(author);
+
+    book_memory_ -= memory_before;
+    storage_[index].AccountMemory(book_memory_);
+
+    if (!is_added) {
+        return false;
+    }
+
+    aggregate_remove(before);
+    aggregate_add(storage_[index]);
+
+    index_author(index, author);
+    sync_shrunk_slot(index);
+    rebuild_aggregates();
+    return true;
+}
+
+bool BookStore::RemoveBook(int index) {
+    if (index < 0 || index >= storage_size_) {
+        throw std::invalid_argument("BookStore::index is out of range");
+    }
+
+    const int id = book_ids_[index];
+
+    if (id == kRemovedId) {
+        return false;
+    }
+
+    // без записи об удалении восстановление из журнала вернуло бы книгу
+    if (log_ != nullptr && log_offsets_[index] != kNoLogOffset &&
+        log_->AppendRemove(log_offsets_[index]) != WalStatus::SUCCESS) {
+        throw std::runtime_error("BookStore::log failed to persist the removal");
+    }
+
+    const Book &book = storage_[index];
+    aggregate_remove(book);
+
+    MemoryBreakdown book_memory;
+    book.AccountMemory(book_memory);
+    book_memory_ -= book_memory;
+
+    // записи индексов остаются до перестроения и отфильтровываются по идентификатору
+    id_positions_[id] = kRemovedId;
+    book_ids_[index] = kRemovedId;
+    num_removed_ += 1;
+
+    if (compaction_.phase == CompactionPhase::REINDEXING && index < compaction_.read) {
+        compaction_.book_ids[index] = kRemovedId;
+    }
+
+    storage_[index] = Book{};
+    sync_shrunk_slot(index);
+    rebuild_aggregates();
+    return true;
+}
+
+int BookStore::RemoveIf(const std::function<bool(const Book &)> &predicate) {
+    int num_removed = 0;
+
+    for (int index = 0; index < storage_size_; index++) {
+        if (book_ids_[index] != kRemovedId && predicate(storage_[index])) {
+            RemoveBook(index);
+            num_removed += 1;
+        }
+    }
+
+    return num_removed;
+}
+
+bool BookStore::CompactStep(int max_slots) {
+    // шаг без обработки позиций не продвигает уплотнение: цикл while (CompactStep(n)) не завершился бы
+    if (max_slots <= 0) {
+        throw std::invalid_argument("BookStore::max_slots must be positive");
+    }
+
+    if (compaction_.phase == CompactionPhase::IDLE) {
+        if (num_removed_ == 0) {
+            return false;
+        }
+        compaction_.phase = CompactionPhase::MOVING;
+        compaction_.read = 0;
+        compaction_.write = 0;
+    }
+
+    bool is_relocated = false;  // хотя бы одна книга сменила позицию
+
+    for (int step = 0; step < max_slots && compaction_.phase != CompactionPhase::IDLE; step++) {
+        // курсор дошел до конца хранилища (книги могли добавляться между шагами)
+        if (compaction_.read == storage_size_) {
+            switch (compaction_.phase) {
+                case CompactionPhase::MOVING:
+                    finish_moving();
+                    break;
+                case CompactionPhase::SHRINKING:
+                    finish_shrinking();
+                    break;
+                default:
+                    finish_reindexing();
+                    break;
+            }
+            continue;
+        }
+
+        const int index = compaction_.read++;
+        const int id = book_ids_[index];
+
+        switch (compaction_.phase) {
+            case CompactionPhase::MOVING:
+                // живая книга сдвигается на первую свободную позицию, на ее месте остается надгробие
+                if (id != kRemovedId) {
+                    const int position = compaction_.write++;
+
+                    if (position != index) {
+                        storage_[position] = std::move(storage_[index]);
+                        storage_[index] = Book{};
+                        book_ids_[position] = id;
+                        book_ids_[index] = kRemovedId;
+                        log_offsets_[position] = log_offsets_[index];
+                        id_positions_[id] = position;
+                        is_relocated = true;
+                    }
+                }
+                break;
+            case CompactionPhase::SHRINKING:
+                compaction_.shrunk_storage[index] = storage_[index];
+                break;
+            default:
+                // в перестроенных индексах идентификатор книги совпадает с ее позицией
+                compaction_.book_ids.push_back(id == kRemovedId ? kRemovedId : index);
+
+                if (id != kRemovedId) {
+                    const Book &book = storage_[index];
+                    compaction_.indexes.InsertTitle(book.GetTitle(), index);
+
+                    // подпись содержания (если поиск дубликатов включен) переносится без повторного хэширования
+                    compaction_.indexes.content_signatures.InsertFrom(indexes_.content_signatures, id, index);
+
+                    for (const auto &author: book.GetAuthors()) {
+                        compaction_.indexes.InsertAuthor(author, index);
+                    }
+                }
+                break;
+        }
+    }
+
+    if (is_relocated) {
+        aggregate_relocated();
+        rebuild_aggregates();
+    }
+
+    return compaction_.phase != CompactionPhase::IDLE;
+}
+
+void BookStore::Compact() {
+    while (CompactStep(storage_size_ + 1)) {
+        // каждый шаг проходит хранилище целиком
+    }
+}
+
+bool BookStore::IsRemoved(int index) const {
+    if (index < 0 || index >= storage_size_) {
+        throw std::invalid_argument("BookStore::index is out of range");
+    }
+    return book_ids_[index] == kRemovedId;
+}
+
+MemoryBreakdown BookStore::MemoryUsage() const {
+    MemoryBreakdown usage;
+    account_slots(usage);
+
+    for (int index = 0; index < storage_size_; index++) {
+        storage_[index].AccountMemory(usage);  // надгробия не содержат данных
+    }
+
+    return usage;
+}
+
+MemoryBreakdown BookStore::GetMemoryUsage() const {
+    MemoryBreakdown usage = book_memory_;
+    account_slots(usage);
+    return usage;
 }
 
 // РЕАЛИЗОВАНО
@@ -72,9 +371,17 @@ const std::string &BookStore::GetName() const {
 }
 
 int BookStore::GetSize() const {
+    return storage_size_ - num_removed_;
+}
+
+int BookStore::GetNumSlots() const {
     return storage_size_;
 }
 
+int BookStore::GetNumRemoved() const {
+    return num_removed_;
+}
+
 int BookStore::GetCapacity() const {
     return storage_capacity_;
 }
@@ -83,6 +390,318 @@ const Book *BookStore::GetBooks() const {
     return storage_;
 }
 
+CompactionPhase BookStore::GetCompactionPhase() const {
+    return compaction_.phase;
+}
+
+std::vector<int> BookStore::FindBooksByTitleRange(const std::string &from, const std::string &to) const {
+    std::vector<int> positions;
+
+    indexes_.titles.ForEachInRange(from, to, [&](const std::string &, int id) {
+        if (id_positions_[id] != kRemovedId) {
+            positions.push_back(id_positions_[id]);
+        }
+    });
+
+    return positions;
+}
+
+std::vector<int> BookStore::FindBooksByTitlePrefix(const std::string &prefix, int offset, int limit) const {
+    std::vector<int> positions;
+
+    if (offset < 0 || limit <= 0) {
+        return positions;
+    }
+
+    positions.reserve(limit);
+
+    indexes_.titles.Scan(prefix, [&](const std::string &title, int id) {
+        // названия с общим префиксом идут в индексе подряд
+        if (title.compare(0, prefix.size(), prefix) != 0) return false;
+
+        const int position = id_positions_[id];
+        if (position == kRemovedId) return true;
+
+        if (offset > 0) {
+            offset -= 1;
+            return true;
+        }
+
+        positions.push_back(position);
+        return static_cast<int>(positions.size()) < limit;
+    });
+
+    return positions;
+}
+
+std::vector<int> BookStore::FindBooksByAuthorAge(int min_age, int max_age) const {
+    std::vector<int> positions;
+
+    if (min_age > max_age) {
+        return positions;
+    }
+
+    indexes_.author_ages.Scan(min_age, [&](int age, int id) {
+        if (age > max_age) return false;
+        if (id_positions_[id] != kRemovedId) {
+            positions.push_back(id_positions_[id]);
+        }
+        return true;
+    });
+
+    // у книги может быть несколько подходящих авторов
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+    return positions;
+}
+
+std::vector<int> BookStore::FindBooksByAuthor(const std::string &full_name) const {
+    return to_positions(indexes_.authors.Find(full_name));
+}
+
+std::vector<int> BookStore::FindBooksByCoAuthors(const std::vector<std::string> &full_names) const {
+    return to_positions(indexes_.authors.FindAll(full_names));
+}
+
+std::vector<FuzzyBookMatch> BookStore::FindBooksByFuzzyTitle(const std::string &title, int max_distance, int limit) const {
+    std::vector<FuzzyBookMatch> matches;
+
+    if (limit <= 0) {
+        return matches;
+    }
+
+    for (const auto &match: indexes_.title_dictionary.Search(title, max_distance)) {
+        // книги с найденным названием идут в индексе подряд по возрастанию позиций
+        indexes_.titles.Scan(*match.text, [&](const std::string &key, int id) {
+            if (key != *match.text) return false;
+
+            if (id_positions_[id] != kRemovedId) {
+                matches.push_back({id_positions_[id], match.distance});
+            }
+            return static_cast<int>(matches.size()) < limit;
+        });
+
+        if (static_cast<int>(matches.size()) == limit) break;
+    }
+
+    return matches;
+}
+
+std::vector<FuzzyAuthorMatch> BookStore::FindAuthorsByFuzzyName(const std::string &full_name, int max_distance, int limit) const {
+    std::vector<FuzzyAuthorMatch> matches;
+
+    for (const auto &match: indexes_.author_dictionary.Search(full_name, max_distance)) {
+        if (static_cast<int>(matches.size()) >= limit) break;
+
+        // все книги автора могли быть удалены
+        if (has_books_by_author(*match.text)) {
+            matches.push_back({*match.text, match.distance});
+        }
+    }
+
+    return matches;
+}
+
+std::vector<std::string> BookStore::SuggestTitles(const std::string &prefix, int limit) const {
+    std::vector<std::string> titles;
+
+    if (limit <= 0) {
+        return titles;
+    }
+
+    const bool is_filtered = has_removed_ids();
+
+    indexes_.title_completions.Complete(prefix, [&](const std::string &title, int) {
+        if (!is_filtered || has_books_with_title(title)) {
+            titles.push_back(title);
+        }
+        return static_cast<int>(titles.size()) < limit;
+    });
+
+    return titles;
+}
+
+std::vector<std::string> BookStore::SuggestAuthors(const std::string &prefix, int limit) const {
+    std::vector<std::string> full_names;
+
+    if (limit <= 0) {
+        return full_names;
+    }
+
+    const bool is_filtered = has_removed_ids();
+
+    indexes_.author_completions.Complete(prefix, [&](const std::string &full_name, int) {
+        if (!is_filtered || has_books_by_author(full_name)) {
+            full_names.push_back(full_name);
+        }
+        return static_cast<int>(full_names.size()) < limit;
+    });
+
+    return full_names;
+}
+
+bool BookStore::HasTitle(const std::string &title) const {
+    title_filter_stats_.num_queries.fetch_add(1, std::memory_order_relaxed);
+
+    if (presence_filters_ != nullptr && !presence_filters_->MightContainTitle(title)) {
+        title_filter_stats_.num_negatives.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (has_books_with_title(title)) {
+        return true;
+    }
+
+    if (presence_filters_ != nullptr) {
+        title_filter_stats_.num_false_positives.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+bool BookStore::HasAuthor(const std::string &full_name) const {
+    author_filter_stats_.num_queries.fetch_add(1, std::memory_order_relaxed);
+
+    if (presence_filters_ != nullptr && !presence_filters_->MightContainAuthor(full_name)) {
+        author_filter_stats_.num_negatives.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    if (has_books_by_author(full_name)) {
+        return true;
+    }
+
+    if (presence_filters_ != nullptr) {
+        author_filter_stats_.num_false_positives.fetch_add(1, std::memory_order_relaxed);
+    }
+    return false;
+}
+
+const PresenceFilterAggregate &BookStore::EnablePresenceFilters(double false_positive_rate) {
+    // некорректная вероятность отклоняется до замены прежних фильтров
+    auto filters = std::make_unique<PresenceFilterAggregate>(
+        false_positive_rate, std::max(PresenceFilterAggregate::kInitCapacity, 2 * GetSize()));
+    const PresenceFilterAggregate &result = *filters;
+
+    if (presence_filters_ != nullptr) {
+        aggregates_.erase(std::find_if(aggregates_.begin(), aggregates_.end(), [this](const auto &aggregate) {
+            return aggregate.get() == presence_filters_;
+        }));
+    }
+
+    register_aggregate(std::move(filters));
+
+    presence_filters_ = &result;
+    title_filter_stats_.Reset();
+    author_filter_stats_.Reset();
+    return result;
+}
+
+void BookStore::EnableNearDuplicates() {
+    if (is_near_duplicates_enabled_) {
+        return;
+    }
+
+    for (int index = 0; index < storage_size_; index++) {
+        sign_content(index);
+    }
+    is_near_duplicates_enabled_ = true;
+}
+
+bool BookStore::IsNearDuplicatesEnabled() const {
+    return is_near_duplicates_enabled_;
+}
+
+std::vector<std::vector<int>> BookStore::FindNearDuplicates(double min_similarity) const {
+    if (!is_near_duplicates_enabled_) {
+        throw std::logic_error("BookStore::near-duplicate detection is not enabled");
+    }
+
+    std::vector<std::vector<int>> clusters = indexes_.content_signatures.FindClusters(min_similarity, [this](int id) {
+        return id_positions_[id] != kRemovedId;
+    });
+
+    for (auto &cluster: clusters) {
+        cluster = to_positions(cluster);
+    }
+
+    return clusters;
+}
+
+double BookStore::EstimateContentSimilarity(int lhs, int rhs) const {
+    if (lhs < 0 || lhs >= storage_size_ || rhs < 0 || rhs >= storage_size_) {
+        throw std::invalid_argument("BookStore::index is out of range");
+    }
+    if (!is_near_duplicates_enabled_) {
+        throw std::logic_error("BookStore::near-duplicate detection is not enabled");
+    }
+    return indexes_.content_signatures.EstimateSimilarity(book_ids_[lhs], book_ids_[rhs]);
+}
+
+const CatalogAggregate &BookStore::GetCatalogAggregate() const {
+    return catalog_;
+}
+
+BloomFilterStats BookStore::GetTitleFilterStats() const {
+    return title_filter_stats_.Load();
+}
+
+BloomFilterStats BookStore::GetAuthorFilterStats() const {
+    return author_filter_stats_.Load();
+}
+
+std::vector<AuthorBookCount> BookStore::TopAuthorsByBookCount(int k) const {
+    // в куче хранятся указатели на имена, чтобы не копировать строки
+    using Candidate = std::pair<int, const std::string *>;
+
+    auto top = TopK<Candidate, bool (*)(const Candidate &, const Candidate &)>(
+        k, [](const Candidate &lhs, const Candidate &rhs) {
+            if (lhs.first != rhs.first) return lhs.first < rhs.first;
+            return *lhs.second > *rhs.second;  // при равенстве выше тот, чье имя меньше
+        });
+
+    // в индексах остались записи удаленных книг - их приходится отфильтровывать
+    const bool is_filtered = has_removed_ids();
+
+    for (const auto &[full_name, postings]: indexes_.authors.GetPostings()) {
+        int count = static_cast<int>(postings.size());
+
+        if (is_filtered) {
+            count = static_cast<int>(std::count_if(postings.begin(), postings.end(),
+                                                   [this](int id) { return id_positions_[id] != kRemovedId; }));
+        }
+
+        if (count > 0) {
+            top.Push({count, &full_name});
+        }
+    }
+
+    std::vector<AuthorBookCount> result;
+
+    for (const auto &[count, full_name]: top.Extract()) {
+        result.push_back({*full_name, count});
+    }
+
+    return result;
+}
+
+std::vector<int> BookStore::TopBooksByContentSize(int k) const {
+    auto top = TopK<std::pair<std::size_t, int>>(k);
+
+    for (int index = 0; index < storage_size_; index++) {
+        if (book_ids_[index] == kRemovedId) continue;
+        top.Push({storage_[index].GetContent().size(), -index});  // при равенстве выше книга с меньшей позицией
+    }
+
+    std::vector<int> positions;
+
+    for (const auto &[size, position]: top.Extract()) {
+        positions.push_back(-position);
+    }
+
+    return positions;
+}
+
 ResizeStorageStatus BookStore::resize_storage_internal(int new_capacity) {
     // изменяем размеры хранилища с копированием старых данных в хранилище нового объема
     const ResizeStorageStatus status = resize_storage(storage_, storage_size_, new_capacity);
@@ -93,4 +712,235 @@ ResizeStorageStatus BookStore::resize_storage_internal(int new_capacity) {
     }
 
     return status;
-}
\ No newline at end of file
+}
+
+int BookStore::grown_capacity() const {
+    const long long growth = std::max<long long>(kCapacityCoefficient, storage_capacity_ / 2);
+    const long long capacity = storage_capacity_ + growth;
+
+    // при переполнении int объем не растет, и resize_storage сообщает об ошибке
+    return static_cast<int>(std::min<long long>(capacity, std::numeric_limits<int>::max()));
+}
+
+void BookStore::index_book(int index) {
+    const Book &book = storage_[index];
+
+    indexes_.InsertTitle(book.GetTitle(), book_ids_[index]);
+    aggregate_add(book);
+
+    if (is_near_duplicates_enabled_) {
+        sign_content(index);
+    }
+
+    for (const auto &author: book.GetAuthors()) {
+        index_author(index, author);
+    }
+}
+
+void BookStore::index_author(int index, const Author &author) {
+    const int id = book_ids_[index];
+
+    indexes_.InsertAuthor(author, id);
+
+    // книга уже попала в перестраиваемые индексы - автор добавляется и туда
+    if (compaction_.phase == CompactionPhase::REINDEXING && index < compaction_.read) {
+        compaction_.indexes.InsertAuthor(author, index);
+    }
+}
+
+void BookStore::SecondaryIndexes::InsertTitle(const std::string &title, int id) {
+    titles.Insert(title, id);
+    title_dictionary.Insert(title);
+    title_completions.Insert(title);
+}
+
+void BookStore::SecondaryIndexes::InsertAuthor(const Author &author, int id) {
+    author_ages.Insert(author.GetAge(), id);
+    authors.Insert(author.GetFullName(), id);
+    author_dictionary.Insert(author.GetFullName());
+    author_completions.Insert(author.GetFullName());
+}
+
+BloomFilterStats BookStore::FilterCounters::Load() const {
+    BloomFilterStats stats;
+    stats.num_queries = num_queries.load(std::memory_order_relaxed);
+    stats.num_negatives = num_negatives.load(std::memory_order_relaxed);
+    stats.num_false_positives = num_false_positives.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void BookStore::FilterCounters::Reset() {
+    num_queries.store(0, std::memory_order_relaxed);
+    num_negatives.store(0, std::memory_order_relaxed);
+    num_false_positives.store(0, std::memory_order_relaxed);
+}
+
+bool BookStore::has_removed_ids() const {
+    return static_cast<int>(id_positions_.size()) != storage_size_ - num_removed_;
+}
+
+bool BookStore::has_books_with_title(const std::string &title) const {
+    bool has_books = false;
+
+    indexes_.titles.Scan(title, [&](const std::string &key, int id) {
+        if (key != title) return false;
+        has_books = id_positions_[id] != kRemovedId;
+        return !has_books;
+    });
+
+    return has_books;
+}
+
+bool BookStore::has_books_by_author(const std::string &full_name) const {
+    const auto &postings = indexes_.authors.Find(full_name);
+
+    return std::any_of(postings.begin(), postings.end(), [this](int id) { return id_positions_[id] != kRemovedId; });
+}
+
+void BookStore::register_aggregate(std::unique_ptr<BookAggregate> aggregate) {
+    for (int index = 0; index < storage_size_; index++) {
+        if (book_ids_[index] != kRemovedId) {
+            aggregate->Add(storage_[index]);
+        }
+    }
+
+    aggregates_.push_back(std::move(aggregate));
+}
+
+void BookStore::aggregate_add(const Book &book) {
+    catalog_.Add(book);
+
+    for (const auto &aggregate: aggregates_) {
+        aggregate->Add(book);
+    }
+}
+
+void BookStore::aggregate_remove(const Book &book) {
+    catalog_.Remove(book);
+
+    for (const auto &aggregate: aggregates_) {
+        aggregate->Remove(book);
+    }
+}
+
+void BookStore::aggregate_relocated() {
+    // встроенные агрегаты не зависят от позиций книг
+    for (const auto &aggregate: aggregates_) {
+        aggregate->OnRelocated();
+    }
+}
+
+void BookStore::sign_content(int index) {
+    const int id = book_ids_[index];
+
+    // содержание без слов не получает подписи и проверяется заново (дешево: хэшировать нечего)
+    if (id == kRemovedId || indexes_.content_signatures.Contains(id)) {
+        return;
+    }
+    indexes_.content_signatures.Insert(storage_[index].GetContent(), id);
+
+    // книга уже перенесена в перестраиваемые индексы (без подписи) - подпись переносится туда же
+    if (compaction_.phase == CompactionPhase::REINDEXING && index < compaction_.read) {
+        compaction_.indexes.content_signatures.InsertFrom(indexes_.content_signatures, id, index);
+    }
+}
+
+void BookStore::rebuild_aggregates() {
+    for (const auto &aggregate: aggregates_) {
+        if (!aggregate->NeedsRebuild()) continue;
+
+        aggregate->Reset();
+
+        for (int index = 0; index < storage_size_; index++) {
+            if (book_ids_[index] != kRemovedId) {
+                aggregate->Add(storage_[index]);
+            }
+        }
+    }
+}
+
+void BookStore::account_slots(MemoryBreakdown &usage) const {
+    const auto num_books = static_cast<std::size_t>(storage_size_ - num_removed_);
+
+    usage.slot_bytes += num_books * sizeof(Book);
+    usage.slot_slack_bytes += (static_cast<std::size_t>(storage_capacity_) - num_books) * sizeof(Book);
+    usage.slot_slack_bytes += static_cast<std::size_t>(compaction_.shrunk_capacity) * sizeof(Book);
+}
+
+std::vector<int> BookStore::to_positions(const std::vector<int> &ids) const {
+    std::vector<int> positions;
+    positions.reserve(ids.size());
+
+    // уплотнение сохраняет порядок книг, поэтому отсортированные идентификаторы дают отсортированные позиции
+    for (int id: ids) {
+        if (id_positions_[id] != kRemovedId) {
+            positions.push_back(id_positions_[id]);
+        }
+    }
+
+    return positions;
+}
+
+void BookStore::finish_moving() {
+    // все позиции за курсором записи - надгробия (удаления перед курсором остаются до следующего уплотнения)
+    num_removed_ -= storage_size_ - compaction_.write;
+    storage_size_ = compaction_.write;
+    book_ids_.resize(storage_size_);
+    log_offsets_.resize(storage_size_);
+
+    const int shrunk_capacity = std::max(storage_size_ + kCapacityCoefficient, kInitStorageCapacity);
+
+    compaction_.read = 0;
+
+    // хранилище сжимается, только если пустует более половины его объема
+    if (storage_size_ * 2 < storage_capacity_ && shrunk_capacity < storage_capacity_) {
+        compaction_.phase = CompactionPhase::SHRINKING;
+        compaction_.shrunk_capacity = shrunk_capacity;
+        compaction_.shrunk_storage = new Book[shrunk_capacity];
+    } else {
+        compaction_.phase = CompactionPhase::REINDEXING;
+        compaction_.book_ids.reserve(storage_size_);
+    }
+}
+
+void BookStore::finish_shrinking() {
+    delete[] storage_;
+    storage_ = compaction_.shrunk_storage;
+    storage_capacity_ = compaction_.shrunk_capacity;
+
+    compaction_.shrunk_storage = nullptr;
+    compaction_.shrunk_capacity = 0;
+    compaction_.phase = CompactionPhase::REINDEXING;
+    compaction_.read = 0;
+    compaction_.book_ids.reserve(storage_size_);
+}
+
+void BookStore::finish_reindexing() {
+    indexes_ = std::move(compaction_.indexes);
+    compaction_.indexes = {};
+
+    // после перестроения идентификаторы книг совпадают с их позициями
+    id_positions_ = compaction_.book_ids;
+    book_ids_ = std::move(compaction_.book_ids);
+    compaction_.book_ids = {};
+
+    compaction_.phase = CompactionPhase::IDLE;
+    compaction_.read = 0;
+    compaction_.write = 0;
+}
+
+void BookStore::cancel_shrinking() {
+    delete[] compaction_.shrunk_storage;
+
+    compaction_.shrunk_storage = nullptr;
+    compaction_.shrunk_capacity = 0;
+    compaction_.phase = CompactionPhase::REINDEXING;
+    compaction_.read = 0;
+    compaction_.book_ids.reserve(storage_size_);
+}
+
+void BookStore::sync_shrunk_slot(int index) {
+    if (compaction_.phase == CompactionPhase::SHRINKING && index < compaction_.read) {
+        compaction_.shrunk_storage[index] = storage_[index];
+    }
+}
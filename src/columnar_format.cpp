@@ -0,0 +1,286 @@
+#include "columnar_format.hpp"
+
+#include <algorithm>  // max
+#include <cstring>    // memcmp
+#include <utility>    // move
+
+#include "book_store.hpp"
+
+namespace {
+
+// сигнатура колоночного потока
+constexpr char kMagic[8] = {'B', 'O', 'O', 'K', 'C', 'O', 'L', '1'};
+
+// максимальный объем строковых данных пакета (смещения - 32-битные)
+constexpr std::size_t kMaxBatchBytes = std::size_t{1} << 30;
+
+// максимальный размер буфера при чтении (защита от выделения памяти по поврежденной длине)
+constexpr std::uint64_t kMaxBufferBytes = std::uint64_t{1} << 31;
+
+template <typename T>
+void write_value(std::ostream &out, T value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read_value(std::istream &in, T &value) {
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+}
+
+// буфер столбца: длина в байтах и данные
+template <typename T>
+void write_buffer(std::ostream &out, const T *data, std::size_t count) {
+  write_value(out, static_cast<std::uint64_t>(count * sizeof(T)));
+  out.write(reinterpret_cast<const char *>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+template <typename Buffer>
+bool read_buffer(std::istream &in, Buffer &buffer) {
+  using T = typename Buffer::value_type;
+
+  std::uint64_t num_bytes = 0;
+
+  if (!read_value(in, num_bytes) || num_bytes > kMaxBufferBytes || num_bytes % sizeof(T) != 0) {
+    return false;
+  }
+
+  buffer.resize(static_cast<std::size_t>(num_bytes / sizeof(T)));
+  return static_cast<bool>(in.read(reinterpret_cast<char *>(buffer.data()), static_cast<std::streamsize>(num_bytes)));
+}
+
+// смещения начинаются с нуля, не убывают и не выходят за данные
+bool valid_offsets(const std::vector<std::int32_t> &offsets, std::size_t num_values, std::size_t data_size) {
+  if (offsets.size() != num_values + 1 || offsets.front() != 0) return false;
+
+  for (std::size_t index = 1; index < offsets.size(); index++) {
+    if (offsets[index] < offsets[index - 1]) return false;
+  }
+
+  return static_cast<std::size_t>(offsets.back()) == data_size;
+}
+
+void append_string(std::vector<std::int32_t> &offsets, std::string &data, const std::string &value) {
+  data.append(value);
+  offsets.push_back(static_cast<std::int32_t>(data.size()));
+}
+
+}  // namespace
+
+void RecordBatch::Append(const Book &book) {
+  genres.push_back(static_cast<std::uint8_t>(book.GetGenre()));
+  publishers.push_back(static_cast<std::uint8_t>(book.GetPublisher()));
+  append_string(title_offsets, title_data, book.GetTitle());
+  append_string(content_offsets, content_data, book.GetContent());
+
+  for (const auto &author: book.GetAuthors()) {
+    append_string(author_name_offsets, author_name_data, author.GetFullName());
+    author_ages.push_back(author.GetAge());
+    author_sexes.push_back(static_cast<std::uint8_t>(author.GetSex()));
+  }
+
+  author_offsets.push_back(static_cast<std::int32_t>(author_ages.size()));
+  num_rows += 1;
+}
+
+bool RecordBatch::Validate() const {
+  const auto rows = static_cast<std::size_t>(num_rows);
+
+  if (num_rows < 0 || genres.size() != rows || publishers.size() != rows) return false;
+  if (!valid_offsets(title_offsets, rows, title_data.size())) return false;
+  if (!valid_offsets(content_offsets, rows, content_data.size())) return false;
+  if (!valid_offsets(author_offsets, rows, author_ages.size())) return false;
+  if (author_sexes.size() != author_ages.size()) return false;
+  if (!valid_offsets(author_name_offsets, author_ages.size(), author_name_data.size())) return false;
+
+  for (std::size_t row = 0; row < rows; row++) {
+    if (genres[row] > static_cast<std::uint8_t>(Genre::UNDEFINED)) return false;
+    if (publishers[row] > static_cast<std::uint8_t>(Publisher::UNDEFINED)) return false;
+  }
+
+  for (std::uint8_t sex: author_sexes) {
+    if (sex > static_cast<std::uint8_t>(Sex::UNDEFINED)) return false;
+  }
+
+  return true;
+}
+
+Book RecordBatch::MakeBook(int row) const {
+  std::vector<Author> authors;
+  authors.reserve(static_cast<std::size_t>(author_offsets[row + 1] - author_offsets[row]));
+
+  for (int author = author_offsets[row]; author < author_offsets[row + 1]; author++) {
+    authors.push_back(Author::Restore(std::string(GetAuthorName(author)), author_ages[author],
+                                      static_cast<Sex>(author_sexes[author])));
+  }
+
+  return Book::Restore(std::string(GetTitle(row)), std::string(GetContent(row)), static_cast<Genre>(genres[row]),
+                       static_cast<Publisher>(publishers[row]), authors);
+}
+
+std::string_view RecordBatch::GetTitle(int row) const {
+  return std::string_view(title_data).substr(title_offsets[row], title_offsets[row + 1] - title_offsets[row]);
+}
+
+std::string_view RecordBatch::GetContent(int row) const {
+  return std::string_view(content_data).substr(content_offsets[row], content_offsets[row + 1] - content_offsets[row]);
+}
+
+std::string_view RecordBatch::GetAuthorName(int author) const {
+  return std::string_view(author_name_data)
+      .substr(author_name_offsets[author], author_name_offsets[author + 1] - author_name_offsets[author]);
+}
+
+void RecordBatch::Clear() {
+  num_rows = 0;
+  genres.clear();
+  publishers.clear();
+  title_offsets.assign(1, 0);
+  title_data.clear();
+  content_offsets.assign(1, 0);
+  content_data.clear();
+  author_offsets.assign(1, 0);
+  author_name_offsets.assign(1, 0);
+  author_name_data.clear();
+  author_ages.clear();
+  author_sexes.clear();
+}
+
+ColumnarStatus write_columnar_header(std::ostream &out) {
+  out.write(kMagic, sizeof(kMagic));
+  return out ? ColumnarStatus::SUCCESS : ColumnarStatus::WRITE_FAILED;
+}
+
+ColumnarStatus read_columnar_header(std::istream &in) {
+  char magic[sizeof(kMagic)] = {};
+
+  if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0) {
+    return ColumnarStatus::READ_FAILED;
+  }
+  return ColumnarStatus::SUCCESS;
+}
+
+ColumnarStatus write_record_batch(const RecordBatch &batch, std::ostream &out) {
+  write_value(out, static_cast<std::int32_t>(batch.num_rows));
+
+  if (batch.num_rows > 0) {
+    write_buffer(out, batch.genres.data(), batch.genres.size());
+    write_buffer(out, batch.publishers.data(), batch.publishers.size());
+    write_buffer(out, batch.title_offsets.data(), batch.title_offsets.size());
+    write_buffer(out, batch.title_data.data(), batch.title_data.size());
+    write_buffer(out, batch.content_offsets.data(), batch.content_offsets.size());
+    write_buffer(out, batch.content_data.data(), batch.content_data.size());
+    write_buffer(out, batch.author_offsets.data(), batch.author_offsets.size());
+    write_buffer(out, batch.author_name_offsets.data(), batch.author_name_offsets.size());
+    write_buffer(out, batch.author_name_data.data(), batch.author_name_data.size());
+    write_buffer(out, batch.author_ages.data(), batch.author_ages.size());
+    write_buffer(out, batch.author_sexes.data(), batch.author_sexes.size());
+  }
+
+  return out ? ColumnarStatus::SUCCESS : ColumnarStatus::WRITE_FAILED;
+}
+
+ColumnarStatus read_record_batch(std::istream &in, RecordBatch &batch) {
+  batch.Clear();
+
+  std::int32_t num_rows = 0;
+
+  if (!read_value(in, num_rows) || num_rows < 0) {
+    return ColumnarStatus::READ_FAILED;
+  }
+
+  if (num_rows == 0) {
+    return ColumnarStatus::SUCCESS;
+  }
+
+  batch.num_rows = num_rows;
+
+  const bool is_read = read_buffer(in, batch.genres) && read_buffer(in, batch.publishers) &&
+      read_buffer(in, batch.title_offsets) && read_buffer(in, batch.title_data) &&
+      read_buffer(in, batch.content_offsets) && read_buffer(in, batch.content_data) &&
+      read_buffer(in, batch.author_offsets) && read_buffer(in, batch.author_name_offsets) &&
+      read_buffer(in, batch.author_name_data) && read_buffer(in, batch.author_ages) &&
+      read_buffer(in, batch.author_sexes);
+
+  if (!is_read) {
+    return ColumnarStatus::READ_FAILED;
+  }
+
+  return batch.Validate() ? ColumnarStatus::SUCCESS : ColumnarStatus::CORRUPTED_BATCH;
+}
+
+ColumnarStatus export_columnar(const BookStore &store, std::ostream &out, int batch_rows) {
+  batch_rows = std::max(batch_rows, 1);
+
+  ColumnarStatus status = write_columnar_header(out);
+
+  RecordBatch batch;
+
+  const auto flush = [&] {
+    if (status == ColumnarStatus::SUCCESS && batch.num_rows > 0) {
+      status = write_record_batch(batch, out);
+      batch.Clear();
+    }
+  };
+
+  const bool has_removed = store.GetNumRemoved() > 0;
+
+  for (int index = 0; index < store.GetNumSlots() && status == ColumnarStatus::SUCCESS; index++) {
+    if (has_removed && store.IsRemoved(index)) continue;
+
+    batch.Append(store.GetBooks()[index]);
+
+    // пакет ограничен и по кол-ву строк, и по объему данных (смещения - 32-битные)
+    const std::size_t num_bytes =
+        batch.content_data.size() + batch.title_data.size() + batch.author_name_data.size();
+
+    if (batch.num_rows == batch_rows || num_bytes >= kMaxBatchBytes) {
+      flush();
+    }
+  }
+
+  flush();
+
+  // завершающий пакет из нуля строк
+  if (status == ColumnarStatus::SUCCESS) {
+    status = write_record_batch(batch, out);
+  }
+
+  return status;
+}
+
+ColumnarStatus import_columnar(std::istream &in, BookStore &store, int *num_imported) {
+  if (num_imported != nullptr) {
+    *num_imported = 0;
+  }
+
+  ColumnarStatus status = read_columnar_header(in);
+
+  RecordBatch batch;
+
+  while (status == ColumnarStatus::SUCCESS) {
+    status = read_record_batch(in, batch);
+
+    if (status != ColumnarStatus::SUCCESS || batch.num_rows == 0) {
+      break;
+    }
+
+    // объем хранилища растет геометрически: резерв точно под пакет копировал бы хранилище на каждом пакете
+    const int capacity = store.GetNumSlots() + batch.num_rows;
+
+    if (capacity > store.GetCapacity()) {
+      store.Reserve(std::max(capacity, 2 * store.GetCapacity()));
+    }
+
+    for (int row = 0; row < batch.num_rows; row++) {
+      if (store.AddBook(batch.MakeBook(row)) != ResizeStorageStatus::SUCCESS) {
+        return ColumnarStatus::STORE_FAILED;
+      }
+
+      if (num_imported != nullptr) {
+        *num_imported += 1;
+      }
+    }
+  }
+
+  return status;
+}
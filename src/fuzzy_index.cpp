@@ -0,0 +1,242 @@
+#include "fuzzy_index.hpp"
+
+#include <algorithm>  // max, min, sort, unique
+#include <array>
+#include <cstdlib>    // abs
+#include <utility>    // swap
+
+namespace {
+
+// символ-заполнитель на границах строки при разбиении на триграммы
+constexpr unsigned char kPadding = 0;
+
+// максимальная длина строки для бит-параллельного алгоритма (кол-во бит машинного слова)
+constexpr int kMaxBitParallelLength = 64;
+
+// счетчик общих триграмм: номер запроса в старших 8 битах, кол-во триграмм в младших 8 битах
+// (запрос с большим кол-вом триграмм проверяется полным перебором)
+constexpr std::uint16_t kGenerationStep = 1 << 8;
+constexpr int kMaxSharedTrigrams = static_cast<int>(kGenerationStep) - 1;
+
+unsigned char to_lower(char symbol) {
+  const auto byte = static_cast<unsigned char>(symbol);
+  return byte >= 'A' && byte <= 'Z' ? static_cast<unsigned char>(byte | 0x20) : byte;
+}
+
+// различные триграммы строки (с двумя заполнителями в начале и одним в конце), по возрастанию
+std::vector<std::uint32_t> distinct_trigrams(std::string_view text) {
+  std::vector<std::uint32_t> trigrams;
+  trigrams.reserve(text.size() + 1);
+
+  std::uint32_t window = (kPadding << 8) | kPadding;
+
+  for (std::size_t index = 0; index <= text.size(); index++) {
+    const unsigned char symbol = index < text.size() ? to_lower(text[index]) : kPadding;
+    window = ((window << 8) | symbol) & 0xFFFFFFu;
+    trigrams.push_back(window);
+  }
+
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+  return trigrams;
+}
+
+// алгоритм Майерса (в формулировке Хюрре для глобального расстояния), |pattern| <= 64
+int bit_parallel_distance(std::string_view pattern, std::string_view text, int max_distance) {
+  const int length = static_cast<int>(pattern.size());
+
+  std::array<std::uint64_t, 256> peq{};  // позиции символов в шаблоне
+
+  for (int index = 0; index < length; index++) {
+    peq[to_lower(pattern[index])] |= std::uint64_t{1} << index;
+  }
+
+  const std::uint64_t high_bit = std::uint64_t{1} << (length - 1);
+
+  std::uint64_t pv = ~std::uint64_t{0};  // вертикальные приращения +1
+  std::uint64_t mv = 0;                  // вертикальные приращения -1
+  int score = length;
+
+  for (std::size_t column = 0; column < text.size(); column++) {
+    const std::uint64_t eq = peq[to_lower(text[column])];
+    const std::uint64_t xv = eq | mv;
+    const std::uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+
+    std::uint64_t ph = mv | ~(xh | pv);
+    std::uint64_t mh = pv & xh;
+
+    if (ph & high_bit) {
+      score += 1;
+    } else if (mh & high_bit) {
+      score -= 1;
+    }
+
+    // верхняя строка матрицы растет на 1 в каждом столбце (глобальное выравнивание)
+    ph = (ph << 1) | 1;
+    mh <<= 1;
+
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+
+    // оставшиеся столбцы уменьшают расстояние не более чем на 1 каждый
+    if (score - static_cast<int>(text.size() - column - 1) > max_distance) {
+      return max_distance + 1;
+    }
+  }
+
+  return std::min(score, max_distance + 1);
+}
+
+// классическое динамическое программирование по двум строкам матрицы
+int dynamic_distance(std::string_view lhs, std::string_view rhs, int max_distance) {
+  std::vector<int> previous(rhs.size() + 1);
+  std::vector<int> current(rhs.size() + 1);
+
+  for (std::size_t column = 0; column <= rhs.size(); column++) {
+    previous[column] = static_cast<int>(column);
+  }
+
+  for (std::size_t row = 1; row <= lhs.size(); row++) {
+    current[0] = static_cast<int>(row);
+    int row_minimum = current[0];
+
+    for (std::size_t column = 1; column <= rhs.size(); column++) {
+      const int substitution = previous[column - 1] + (to_lower(lhs[row - 1]) != to_lower(rhs[column - 1]));
+      current[column] = std::min({substitution, previous[column] + 1, current[column - 1] + 1});
+      row_minimum = std::min(row_minimum, current[column]);
+    }
+
+    // значения в строке матрицы далее не уменьшаются
+    if (row_minimum > max_distance) {
+      return max_distance + 1;
+    }
+    std::swap(previous, current);
+  }
+
+  return std::min(previous[rhs.size()], max_distance + 1);
+}
+
+}  // namespace
+
+int edit_distance(std::string_view lhs, std::string_view rhs, int max_distance) {
+  // расстояние не меньше разности длин
+  if (std::abs(static_cast<int>(lhs.size()) - static_cast<int>(rhs.size())) > max_distance) {
+    return max_distance + 1;
+  }
+
+  if (lhs.size() > rhs.size()) {
+    std::swap(lhs, rhs);
+  }
+
+  if (lhs.empty()) {
+    return static_cast<int>(rhs.size());
+  }
+
+  if (static_cast<int>(lhs.size()) <= kMaxBitParallelLength) {
+    return bit_parallel_distance(lhs, rhs, max_distance);
+  }
+
+  return dynamic_distance(lhs, rhs, max_distance);
+}
+
+void FuzzyIndex::Insert(const std::string &text) {
+  const auto [it, is_inserted] = term_ids_.try_emplace(text, static_cast<int>(terms_.size()));
+
+  if (!is_inserted) {
+    return;
+  }
+
+  terms_.push_back(&it->first);
+
+  // идентификаторы растут, поэтому списки триграмм остаются отсортированными
+  for (std::uint32_t trigram: distinct_trigrams(text)) {
+    trigrams_[trigram].push_back(it->second);
+  }
+}
+
+std::vector<FuzzyMatch> FuzzyIndex::Search(std::string_view query, int max_distance) const {
+  std::vector<FuzzyMatch> matches;
+
+  if (max_distance < 0) {
+    return matches;
+  }
+
+  const std::vector<std::uint32_t> query_trigrams = distinct_trigrams(query);
+  const int threshold = static_cast<int>(query_trigrams.size()) - 3 * max_distance;
+
+  const auto verify = [&](int id) {
+    const int distance = edit_distance(query, *terms_[id], max_distance);
+
+    if (distance <= max_distance) {
+      matches.push_back({terms_[id], distance});
+    }
+  };
+
+  if (threshold <= 0 || static_cast<int>(query_trigrams.size()) > kMaxSharedTrigrams) {
+    // фильтр по триграммам ничего не отсекает (или кол-во триграмм не помещается в счетчик) -
+    // проверяются все строки (длина отсекается в edit_distance)
+    for (int id = 0; id < GetSize(); id++) {
+      verify(id);
+    }
+  } else {
+    // подсчет общих триграмм в буфере потока без очистки между запросами: счетчик хранит
+    // номер запроса, и счетчик предыдущего запроса считается нулевым. Запрос не выделяет
+    // и не обнуляет память размером со словарь, а счетчик не переполняется: кол-во общих
+    // триграмм не превышает кол-ва триграмм запроса (не более kMaxSharedTrigrams)
+    thread_local std::vector<std::uint16_t> counts;
+    thread_local std::uint16_t generation = 0;
+
+    if (counts.size() < terms_.size()) {
+      counts.resize(terms_.size());
+    }
+
+    // при переполнении номера запроса буфер очищается (раз в 255 запросов)
+    generation += kGenerationStep;
+    if (generation == 0) {
+      std::fill(counts.begin(), counts.end(), 0);
+      generation = kGenerationStep;
+    }
+
+    // локальные копии: запись в буфер не должна заставлять перечитывать переменные потока
+    std::uint16_t *slots = counts.data();
+    const std::uint16_t base = generation;
+    const std::uint16_t target = static_cast<std::uint16_t>(base + threshold);
+
+    std::vector<int> candidates;
+
+    for (std::uint32_t trigram: query_trigrams) {
+      const auto it = trigrams_.find(trigram);
+      if (it == trigrams_.end()) continue;
+
+      for (int id: it->second) {
+        std::uint16_t &slot = slots[id];
+        slot = static_cast<std::uint16_t>(std::max(slot, base) + 1);
+
+        if (slot == target) {
+          candidates.push_back(id);
+        }
+      }
+    }
+
+    for (int id: candidates) {
+      verify(id);
+    }
+  }
+
+  std::sort(matches.begin(), matches.end(), [](const FuzzyMatch &lhs, const FuzzyMatch &rhs) {
+    if (lhs.distance != rhs.distance) return lhs.distance < rhs.distance;
+    return *lhs.text < *rhs.text;
+  });
+
+  return matches;
+}
+
+int FuzzyIndex::GetSize() const {
+  return static_cast<int>(terms_.size());
+}
+
+void FuzzyIndex::Clear() {
+  term_ids_ = {};
+  terms_ = {};
+  trigrams_ = {};
+}
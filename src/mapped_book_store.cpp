@@ -0,0 +1,338 @@
+#include "mapped_book_store.hpp"
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, mremap, msync, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // ftruncate, close
+
+#include <algorithm>  // max
+#include <cstring>    // memcpy, memcmp
+#include <stdexcept>  // invalid_argument
+
+#include "write_ahead_log.hpp"  // encode_book, decode_book
+
+namespace {
+
+// сигнатура таблицы записей
+constexpr char kMagic[8] = {'B', 'O', 'O', 'K', 'M', 'A', 'P', '1'};
+
+// кол-во байт, занимаемых длиной строки (целое переменной длины, см. encode_book)
+std::size_t varint_size(std::uint64_t value) {
+  std::size_t size = 1;
+  while (value >= 0x80u) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+
+}  // namespace
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+MappedStatus MappedFile::Open(const std::string &path) {
+  if (IsOpen()) {
+    Close();
+  }
+
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+
+  if (fd_ < 0) {
+    return MappedStatus::OPEN_FAILED;
+  }
+
+  struct stat info{};
+
+  if (::fstat(fd_, &info) != 0) {
+    Close();
+    return MappedStatus::OPEN_FAILED;
+  }
+
+  const auto size = static_cast<std::size_t>(info.st_size);
+
+  if (size == 0) {
+    return MappedStatus::SUCCESS;  // пустой файл отображается при первом увеличении
+  }
+
+  void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+  if (data == MAP_FAILED) {
+    Close();
+    return MappedStatus::OPEN_FAILED;
+  }
+
+  data_ = static_cast<char *>(data);
+  size_ = size;
+  return MappedStatus::SUCCESS;
+}
+
+MappedStatus MappedFile::Grow(std::size_t size) {
+  if (!IsOpen()) {
+    return MappedStatus::NOT_OPEN;
+  }
+
+  if (size <= size_) {
+    return MappedStatus::SUCCESS;
+  }
+
+  // файл увеличивается разреженно: новые страницы не занимают место на диске до первой записи
+  if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+    return MappedStatus::RESIZE_FAILED;
+  }
+
+  // отображение переносится без копирования страниц (ядро переставляет таблицы страниц)
+  void *data = data_ == nullptr ? ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                                : ::mremap(data_, size_, size, MREMAP_MAYMOVE);
+
+  if (data == MAP_FAILED) {
+    return MappedStatus::RESIZE_FAILED;
+  }
+
+  data_ = static_cast<char *>(data);
+  size_ = size;
+  return MappedStatus::SUCCESS;
+}
+
+MappedStatus MappedFile::Sync() {
+  if (!IsOpen()) {
+    return MappedStatus::NOT_OPEN;
+  }
+
+  if (data_ != nullptr && ::msync(data_, size_, MS_SYNC) != 0) {
+    return MappedStatus::SYNC_FAILED;
+  }
+  return MappedStatus::SUCCESS;
+}
+
+void MappedFile::Close() {
+  if (data_ != nullptr) {
+    ::munmap(data_, size_);
+  }
+
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+
+  fd_ = -1;
+  data_ = nullptr;
+  size_ = 0;
+}
+
+bool MappedFile::IsOpen() const {
+  return fd_ >= 0;
+}
+
+char *MappedFile::GetData() {
+  return data_;
+}
+
+const char *MappedFile::GetData() const {
+  return data_;
+}
+
+std::size_t MappedFile::GetSize() const {
+  return size_;
+}
+
+MappedBookStore::~MappedBookStore() {
+  Close();
+}
+
+MappedStatus MappedBookStore::Open(const std::string &path) {
+  if (IsOpen()) {
+    Close();
+  }
+
+  MappedStatus status = slots_.Open(path);
+
+  if (status == MappedStatus::SUCCESS) {
+    status = heap_.Open(path + ".heap");
+  }
+
+  if (status == MappedStatus::SUCCESS) {
+    if (slots_.GetSize() == 0) {
+      status = initialize();
+    } else if (!validate()) {
+      status = MappedStatus::CORRUPTED_FILE;
+    }
+  }
+
+  if (status != MappedStatus::SUCCESS) {
+    slots_.Close();
+    heap_.Close();
+    num_books_ = 0;
+    heap_size_ = 0;
+  }
+
+  return status;
+}
+
+MappedStatus MappedBookStore::AddBook(const Book &book) {
+  if (!IsOpen()) {
+    return MappedStatus::NOT_OPEN;
+  }
+
+  buffer_.clear();
+  encode_book(book, buffer_);
+
+  const std::size_t slots_size = sizeof(Header) + (static_cast<std::size_t>(num_books_) + 1) * sizeof(Slot);
+
+  MappedStatus status = reserve(slots_, slots_size);
+
+  if (status == MappedStatus::SUCCESS) {
+    status = reserve(heap_, heap_size_ + buffer_.size());
+  }
+
+  if (status != MappedStatus::SUCCESS) {
+    return status;
+  }
+
+  std::memcpy(heap_.GetData() + heap_size_, buffer_.data(), buffer_.size());
+
+  Slot record{};
+  record.offset = heap_size_;
+  record.size = static_cast<std::uint32_t>(buffer_.size());
+  record.title_size = static_cast<std::uint32_t>(book.GetTitle().size());
+
+  std::memcpy(slots_.GetData() + sizeof(Header) + static_cast<std::size_t>(num_books_) * sizeof(Slot),
+              &record, sizeof(Slot));
+
+  num_books_ += 1;
+  heap_size_ += buffer_.size();
+
+  // заголовок обновляется последним: книга становится видимой после записи ее данных
+  header().num_books = static_cast<std::uint64_t>(num_books_);
+  header().heap_size = heap_size_;
+
+  return MappedStatus::SUCCESS;
+}
+
+MappedStatus MappedBookStore::GetBook(int index, Book &book) const {
+  if (!IsOpen()) {
+    return MappedStatus::NOT_OPEN;
+  }
+
+  check_index(index);
+
+  const Slot &record = slot(index);
+
+  if (record.offset + record.size > heap_size_ ||
+      !decode_book(heap_.GetData() + record.offset, record.size, book)) {
+    return MappedStatus::CORRUPTED_FILE;
+  }
+
+  return MappedStatus::SUCCESS;
+}
+
+std::string_view MappedBookStore::GetTitle(int index) const {
+  check_index(index);
+
+  const Slot &record = slot(index);
+  const std::size_t prefix_size = varint_size(record.title_size);
+
+  if (prefix_size + record.title_size > record.size || record.offset + record.size > heap_size_) {
+    return {};
+  }
+
+  return {heap_.GetData() + record.offset + prefix_size, record.title_size};
+}
+
+MappedStatus MappedBookStore::Sync() {
+  if (!IsOpen()) {
+    return MappedStatus::NOT_OPEN;
+  }
+
+  // куча сбрасывается первой, чтобы заголовок на диске не ссылался на незаписанные книги
+  const MappedStatus status = heap_.Sync();
+  return status == MappedStatus::SUCCESS ? slots_.Sync() : status;
+}
+
+void MappedBookStore::Close() {
+  slots_.Close();
+  heap_.Close();
+
+  num_books_ = 0;
+  heap_size_ = 0;
+  buffer_ = {};
+}
+
+bool MappedBookStore::IsOpen() const {
+  return slots_.IsOpen() && heap_.IsOpen();
+}
+
+int MappedBookStore::GetSize() const {
+  return num_books_;
+}
+
+int MappedBookStore::GetCapacity() const {
+  return slots_.GetSize() < sizeof(Header) ? 0 : static_cast<int>((slots_.GetSize() - sizeof(Header)) / sizeof(Slot));
+}
+
+std::size_t MappedBookStore::GetHeapSize() const {
+  return heap_size_;
+}
+
+std::size_t MappedBookStore::GetHeapCapacity() const {
+  return heap_.GetSize();
+}
+
+MappedBookStore::Header &MappedBookStore::header() {
+  return *reinterpret_cast<Header *>(slots_.GetData());
+}
+
+const MappedBookStore::Slot &MappedBookStore::slot(int index) const {
+  return *reinterpret_cast<const Slot *>(slots_.GetData() + sizeof(Header) + static_cast<std::size_t>(index) * sizeof(Slot));
+}
+
+MappedStatus MappedBookStore::initialize() {
+  MappedStatus status = slots_.Grow(sizeof(Header) + kInitCapacity * sizeof(Slot));
+
+  if (status == MappedStatus::SUCCESS) {
+    status = heap_.Grow(kInitHeapCapacity);
+  }
+
+  if (status != MappedStatus::SUCCESS) {
+    return status;
+  }
+
+  // новые страницы файла заполнены нулями - остается записать сигнатуру
+  std::memcpy(header().magic, kMagic, sizeof(kMagic));
+
+  num_books_ = 0;
+  heap_size_ = 0;
+  return MappedStatus::SUCCESS;
+}
+
+bool MappedBookStore::validate() {
+  if (slots_.GetSize() < sizeof(Header) || std::memcmp(header().magic, kMagic, sizeof(kMagic)) != 0) {
+    return false;
+  }
+
+  const std::uint64_t num_books = header().num_books;
+  const std::uint64_t heap_size = header().heap_size;
+
+  if (num_books > static_cast<std::uint64_t>(GetCapacity()) || heap_size > heap_.GetSize()) {
+    return false;
+  }
+
+  num_books_ = static_cast<int>(num_books);
+  heap_size_ = static_cast<std::size_t>(heap_size);
+  return true;
+}
+
+MappedStatus MappedBookStore::reserve(MappedFile &file, std::size_t size) {
+  if (size <= file.GetSize()) {
+    return MappedStatus::SUCCESS;
+  }
+
+  // геометрический рост: кол-во ftruncate и mremap логарифмическое от размера хранилища
+  return file.Grow(std::max(size, 2 * file.GetSize()));
+}
+
+void MappedBookStore::check_index(int index) const {
+  if (index < 0 || index >= num_books_) {
+    throw std::invalid_argument("MappedBookStore::index is out of range");
+  }
+}
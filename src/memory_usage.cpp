@@ -0,0 +1,50 @@
+#include "memory_usage.hpp"
+
+namespace {
+
+// вместимость строки, хранящейся внутри объекта std::string (без выделения памяти в куче)
+const std::size_t kInlineStringCapacity = std::string().capacity();
+
+}  // namespace
+
+std::size_t MemoryBreakdown::GetTotal() const {
+  return slot_bytes + string_heap_bytes + author_vector_bytes + shared_block_bytes + GetSlack();
+}
+
+std::size_t MemoryBreakdown::GetSlack() const {
+  return slot_slack_bytes + string_slack_bytes + author_slack_bytes;
+}
+
+MemoryBreakdown &MemoryBreakdown::operator+=(const MemoryBreakdown &other) {
+  slot_bytes += other.slot_bytes;
+  string_inline_bytes += other.string_inline_bytes;
+  string_heap_bytes += other.string_heap_bytes;
+  author_vector_bytes += other.author_vector_bytes;
+  shared_block_bytes += other.shared_block_bytes;
+  slot_slack_bytes += other.slot_slack_bytes;
+  string_slack_bytes += other.string_slack_bytes;
+  author_slack_bytes += other.author_slack_bytes;
+  return *this;
+}
+
+MemoryBreakdown &MemoryBreakdown::operator-=(const MemoryBreakdown &other) {
+  slot_bytes -= other.slot_bytes;
+  string_inline_bytes -= other.string_inline_bytes;
+  string_heap_bytes -= other.string_heap_bytes;
+  author_vector_bytes -= other.author_vector_bytes;
+  shared_block_bytes -= other.shared_block_bytes;
+  slot_slack_bytes -= other.slot_slack_bytes;
+  string_slack_bytes -= other.string_slack_bytes;
+  author_slack_bytes -= other.author_slack_bytes;
+  return *this;
+}
+
+void account_string(const std::string &str, MemoryBreakdown &usage) {
+  if (str.capacity() <= kInlineStringCapacity) {
+    usage.string_inline_bytes += str.size();
+    return;
+  }
+
+  usage.string_heap_bytes += str.size() + 1;
+  usage.string_slack_bytes += str.capacity() - str.size();
+}
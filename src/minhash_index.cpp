@@ -0,0 +1,266 @@
+#include "minhash_index.hpp"
+
+#include <algorithm>  // copy, max, min, sort
+#include <cmath>      // pow
+#include <limits>
+#include <numeric>    // iota
+#include <stdexcept>  // invalid_argument
+#include <unordered_map>
+#include <utility>    // pair
+
+#include "tokenizer.hpp"  // for_each_token
+
+namespace {
+
+constexpr std::uint32_t kEmptyValue = std::numeric_limits<std::uint32_t>::max();
+
+// множитель свертки слов шингла (нечетный)
+constexpr std::uint64_t kShingleMultiplier = 0x100000001B3ull;
+
+// сдвиг значения, заимствованного из соседней ячейки (отличает его от собственных значений ячейки)
+constexpr std::uint32_t kDensifyOffset = 0x9E3779B9u;
+
+// перемешивание 64-битного значения (SplitMix64)
+std::uint64_t mix(std::uint64_t value) {
+  value += 0x9E3779B97F4A7C15ull;
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+// хэш FNV-1a слова в нижнем регистре
+std::uint64_t hash_token(std::string_view token) {
+  std::uint64_t hash = 14695981039346656037ull;
+
+  for (char symbol: token) {
+    const auto byte = static_cast<unsigned char>(symbol >= 'A' && symbol <= 'Z' ? symbol | 0x20 : symbol);
+    hash = (hash ^ byte) * 1099511628211ull;
+  }
+
+  return hash;
+}
+
+// система непересекающихся множеств для объединения кандидатов в группы
+struct DisjointSets {
+  std::vector<int> parents;
+
+  explicit DisjointSets(int size) : parents(static_cast<std::size_t>(size)) {
+    std::iota(parents.begin(), parents.end(), 0);
+  }
+
+  int Find(int item) {
+    while (parents[item] != item) {
+      parents[item] = parents[parents[item]];  // сжатие пути
+      item = parents[item];
+    }
+    return item;
+  }
+
+  void Unite(int lhs, int rhs) {
+    lhs = Find(lhs);
+    rhs = Find(rhs);
+
+    // меньший корень сохраняется, чтобы группы были упорядочены по первому элементу
+    if (lhs != rhs) {
+      parents[std::max(lhs, rhs)] = std::min(lhs, rhs);
+    }
+  }
+};
+
+}  // namespace
+
+MinHashIndex::MinHashIndex() : MinHashIndex(kDefaultBands, kDefaultRowsPerBand, kDefaultShingleSize) {}
+
+MinHashIndex::MinHashIndex(int num_bands, int rows_per_band, int shingle_size)
+    : num_bands_{num_bands}, rows_per_band_{rows_per_band}, shingle_size_{shingle_size} {
+  if (num_bands <= 0 || rows_per_band <= 0 || shingle_size <= 0) {
+    throw std::invalid_argument("MinHashIndex::parameters must be positive");
+  }
+}
+
+void MinHashIndex::Insert(std::string_view text, int id) {
+  std::vector<std::uint64_t> tokens;
+  for_each_token(text, [&](std::string_view token) { tokens.push_back(hash_token(token)); });
+
+  if (tokens.empty()) {
+    return;
+  }
+
+  const auto num_hashes = static_cast<std::size_t>(GetNumHashes());
+  std::vector<std::uint32_t> values(num_hashes, kEmptyValue);
+
+  // короткий текст образует один шингл из всех слов
+  const std::size_t shingle_size = std::min(tokens.size(), static_cast<std::size_t>(shingle_size_));
+
+  // однократное хэширование: старшие биты хэша шингла выбирают ячейку подписи, младшие - значение
+  for (std::size_t start = 0; start + shingle_size <= tokens.size(); start++) {
+    std::uint64_t shingle = tokens[start];
+
+    // слова шингла сворачиваются с учетом порядка, а перемешивается только результат
+    for (std::size_t offset = 1; offset < shingle_size; offset++) {
+      shingle = shingle * kShingleMultiplier + tokens[start + offset];
+    }
+    shingle = mix(shingle);
+
+    const std::size_t cell = static_cast<std::size_t>(((shingle >> 32) * num_hashes) >> 32);
+    values[cell] = std::min(values[cell], static_cast<std::uint32_t>(shingle));
+  }
+
+  // пустые ячейки (короткий текст) заполняются значением следующей непустой ячейки по кругу
+  // со сдвигом по расстоянию: у одинаковых текстов заполнение совпадает
+  std::vector<std::uint32_t> dense = values;
+
+  for (std::size_t cell = 0; cell < num_hashes; cell++) {
+    std::size_t distance = 1;
+
+    while (dense[cell] == kEmptyValue && distance < num_hashes) {
+      const std::uint32_t value = values[(cell + distance) % num_hashes];
+
+      if (value != kEmptyValue) {
+        dense[cell] = value + static_cast<std::uint32_t>(distance) * kDensifyOffset;
+      }
+      distance++;
+    }
+  }
+
+  insert_signature(dense.data(), id);
+}
+
+void MinHashIndex::InsertFrom(const MinHashIndex &other, int other_id, int id) {
+  if (other.GetNumHashes() != GetNumHashes() || other.rows_per_band_ != rows_per_band_) {
+    throw std::invalid_argument("MinHashIndex::parameters of indices must match");
+  }
+
+  if (other.Contains(other_id)) {
+    insert_signature(other.signature(other_id), id);
+  }
+}
+
+std::vector<std::vector<int>> MinHashIndex::FindClusters(double min_similarity,
+                                                         const std::function<bool(int)> &is_alive) const {
+  auto sets = DisjointSets(static_cast<int>(has_signature_.size()));
+
+  const auto try_unite = [&](int lhs, int rhs) {
+    if (sets.Find(lhs) != sets.Find(rhs) && EstimateSimilarity(lhs, rhs) >= min_similarity) {
+      sets.Unite(lhs, rhs);
+    }
+  };
+
+  // корзины LSH - отрезки одинаковых ключей полос после сортировки пар (ключ, идентификатор):
+  // сортировка непрерывного массива дешевле поддержки хэш-таблиц корзин при каждой вставке
+  std::vector<std::pair<std::uint64_t, int>> entries;
+  entries.reserve(static_cast<std::size_t>(size_) * static_cast<std::size_t>(num_bands_));
+
+  for (int id = 0; id < static_cast<int>(has_signature_.size()); id++) {
+    if (!has_signature_[id] || (is_alive && !is_alive(id))) continue;
+
+    for (int band = 0; band < num_bands_; band++) {
+      entries.emplace_back(band_keys_[static_cast<std::size_t>(id) * num_bands_ + band], id);
+    }
+  }
+
+  std::sort(entries.begin(), entries.end());
+
+  // сравнение с первым и предыдущим текстом корзины: линейно даже для больших корзин
+  // (например, из точных копий), при этом цепочка похожих текстов собирается в одну группу
+  for (std::size_t first = 0, index = 1; index < entries.size(); index++) {
+    if (entries[index].first != entries[first].first) {
+      first = index;
+      continue;
+    }
+
+    try_unite(entries[first].second, entries[index].second);
+    try_unite(entries[index - 1].second, entries[index].second);
+  }
+
+  std::unordered_map<int, std::vector<int>> groups;
+
+  for (int id = 0; id < static_cast<int>(has_signature_.size()); id++) {
+    if (has_signature_[id] && sets.Find(id) != id) {
+      groups[sets.Find(id)].push_back(id);
+    }
+  }
+
+  std::vector<std::vector<int>> clusters;
+  clusters.reserve(groups.size());
+
+  // корень - наименьший идентификатор группы, остальные добавлены по возрастанию
+  for (auto &[root, group]: groups) {
+    group.insert(group.begin(), root);
+    clusters.push_back(std::move(group));
+  }
+
+  std::sort(clusters.begin(), clusters.end());
+  return clusters;
+}
+
+double MinHashIndex::EstimateSimilarity(int lhs, int rhs) const {
+  if (!Contains(lhs) || !Contains(rhs)) {
+    return 0.0;
+  }
+
+  const std::uint32_t *lhs_signature = signature(lhs);
+  const std::uint32_t *rhs_signature = signature(rhs);
+
+  int num_equal = 0;
+  for (int hash = 0; hash < GetNumHashes(); hash++) {
+    num_equal += lhs_signature[hash] == rhs_signature[hash] ? 1 : 0;
+  }
+
+  return static_cast<double>(num_equal) / GetNumHashes();
+}
+
+bool MinHashIndex::Contains(int id) const {
+  return id >= 0 && id < static_cast<int>(has_signature_.size()) && has_signature_[id];
+}
+
+void MinHashIndex::Clear() {
+  signatures_ = {};
+  has_signature_ = {};
+  size_ = 0;
+  band_keys_ = {};
+}
+
+int MinHashIndex::GetSize() const {
+  return size_;
+}
+
+int MinHashIndex::GetNumHashes() const {
+  return num_bands_ * rows_per_band_;
+}
+
+double MinHashIndex::GetThreshold() const {
+  return std::pow(1.0 / num_bands_, 1.0 / rows_per_band_);
+}
+
+void MinHashIndex::insert_signature(const std::uint32_t *signature, int id) {
+  if (id < 0 || Contains(id)) {
+    throw std::invalid_argument("MinHashIndex::id must be non-negative and unique");
+  }
+
+  const auto num_hashes = static_cast<std::size_t>(GetNumHashes());
+
+  if (id >= static_cast<int>(has_signature_.size())) {
+    has_signature_.resize(static_cast<std::size_t>(id) + 1, false);
+    signatures_.resize(has_signature_.size() * num_hashes, kEmptyValue);
+    band_keys_.resize(has_signature_.size() * static_cast<std::size_t>(num_bands_));
+  }
+
+  std::copy(signature, signature + num_hashes, signatures_.begin() + static_cast<std::ptrdiff_t>(id * num_hashes));
+  has_signature_[id] = true;
+  size_ += 1;
+
+  for (int band = 0; band < num_bands_; band++) {
+    std::uint64_t key = static_cast<std::uint64_t>(band);
+
+    for (int row = 0; row < rows_per_band_; row++) {
+      key = mix(key ^ signature[band * rows_per_band_ + row]);
+    }
+
+    band_keys_[static_cast<std::size_t>(id) * num_bands_ + band] = key;
+  }
+}
+
+const std::uint32_t *MinHashIndex::signature(int id) const {
+  return signatures_.data() + static_cast<std::size_t>(id) * static_cast<std::size_t>(GetNumHashes());
+}
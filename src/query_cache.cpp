@@ -0,0 +1,105 @@
+#include "query_cache.hpp"
+
+#include <algorithm>  // max, min_element
+#include <utility>    // move
+
+double QueryCacheStats::GetHitRate() const {
+  const long long num_queries = num_hits + num_misses;
+  return num_queries > 0 ? static_cast<double>(num_hits) / static_cast<double>(num_queries) : 0.0;
+}
+
+QueryCache::QueryCache(int capacity) : capacity_{std::max(capacity, 1)} {
+  entries_.reserve(static_cast<std::size_t>(capacity_));
+}
+
+std::vector<int> QueryCache::Indices(const BookQuery &query) {
+  const std::vector<int> *indices = lookup(query);
+  return indices != nullptr ? *indices : query.Indices();
+}
+
+int QueryCache::Count(const BookQuery &query) {
+  const std::vector<int> *indices = lookup(query);
+  return indices != nullptr ? static_cast<int>(indices->size()) : query.Count();
+}
+
+void QueryCache::Add(const Book &book) {
+  invalidate(book);
+}
+
+void QueryCache::Remove(const Book &book) {
+  invalidate(book);
+}
+
+void QueryCache::OnRelocated() {
+  stats_.num_invalidations += static_cast<long long>(entries_.size());
+  entries_.clear();
+}
+
+void QueryCache::Clear() {
+  entries_.clear();
+}
+
+int QueryCache::GetSize() const {
+  return static_cast<int>(entries_.size());
+}
+
+int QueryCache::GetCapacity() const {
+  return capacity_;
+}
+
+QueryCacheStats QueryCache::GetStats() const {
+  return stats_;
+}
+
+const std::vector<int> *QueryCache::lookup(const BookQuery &query) {
+  std::string key = query.GetKey();
+
+  if (key.empty()) {
+    stats_.num_misses += 1;
+    return nullptr;
+  }
+
+  clock_ += 1;
+
+  auto it = entries_.find(key);
+
+  // запись другого магазина с тем же ключом не подходит и заменяется
+  if (it != entries_.end() && &it->second.query.GetStore() == &query.GetStore()) {
+    stats_.num_hits += 1;
+    it->second.last_used = clock_;
+    return &it->second.indices;
+  }
+
+  stats_.num_misses += 1;
+
+  if (it != entries_.end()) {
+    entries_.erase(it);
+  } else if (GetSize() == capacity_) {
+    evict();
+  }
+
+  auto [inserted, is_inserted] = entries_.emplace(std::move(key), Entry{query, query.Indices(), clock_});
+  return &inserted->second.indices;
+}
+
+void QueryCache::invalidate(const Book &book) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.query.Matches(book)) {
+      it = entries_.erase(it);
+      stats_.num_invalidations += 1;
+    } else {
+      ++it;
+    }
+  }
+}
+
+void QueryCache::evict() {
+  const auto oldest = std::min_element(entries_.begin(), entries_.end(), [](const auto &lhs, const auto &rhs) {
+    return lhs.second.last_used < rhs.second.last_used;
+  });
+
+  if (oldest != entries_.end()) {
+    entries_.erase(oldest);
+    stats_.num_evictions += 1;
+  }
+}
@@ -0,0 +1,152 @@
+#include "sharded_book_store.hpp"
+
+#include <algorithm>  // min
+#include <cstdint>
+#include <stdexcept>  // invalid_argument, runtime_error
+#include <thread>     // hardware_concurrency
+#include <utility>    // pair
+
+namespace {
+
+// хэш FNV-1a названия: в отличие от std::hash, одинаков для всех платформ и стандартных библиотек
+std::uint64_t hash_title(const std::string &title) {
+  std::uint64_t hash = 14695981039346656037ull;
+
+  for (char symbol: title) {
+    hash = (hash ^ static_cast<unsigned char>(symbol)) * 1099511628211ull;
+  }
+
+  return hash;
+}
+
+}  // namespace
+
+ShardedBookStore::ShardedBookStore(const std::string &name, int num_shards, int num_threads) : name_{name} {
+  if (name.empty()) {
+    throw std::invalid_argument("ShardedBookStore::name must not be empty");
+  }
+  if (num_shards <= 0) {
+    throw std::invalid_argument("ShardedBookStore::num_shards must be positive");
+  }
+
+  shards_.reserve(num_shards);
+
+  for (int index = 0; index < num_shards; index++) {
+    shards_.push_back(std::make_unique<Shard>(name + " #" + std::to_string(index)));
+  }
+
+  if (num_threads <= 0) {
+    const int num_cores = static_cast<int>(std::thread::hardware_concurrency());
+    num_threads = std::min(num_shards, num_cores > 0 ? num_cores : 1);
+  }
+
+  pool_ = std::make_unique<ThreadPool>(num_threads);
+}
+
+ShardedBookRef ShardedBookStore::AddBook(const Book &book) {
+  const int shard_index = GetShardIndex(book.GetTitle());
+  Shard &shard = *shards_[shard_index];
+
+  std::lock_guard lock(shard.mutex);
+
+  if (shard.store.AddBook(book) != ResizeStorageStatus::SUCCESS) {
+    throw std::runtime_error("ShardedBookStore::shard storage could not grow");
+  }
+
+  return ShardedBookRef{shard_index, shard.store.GetNumSlots() - 1};
+}
+
+void ShardedBookStore::Reserve(int capacity) {
+  // небольшой запас на неравномерность распределения по хэшу
+  const int num_shards = GetNumShards();
+  const int shard_capacity = capacity / num_shards + capacity / (num_shards * 16) + 1;
+
+  for (auto &shard: shards_) {
+    std::lock_guard lock(shard->mutex);
+    shard->store.Reserve(shard_capacity);
+  }
+}
+
+std::vector<ShardedBookRef> ShardedBookStore::FindBooksByAuthor(const std::string &full_name) const {
+  const auto shard_results = FanOut([&full_name](const BookStore &shard) { return shard.FindBooksByAuthor(full_name); });
+
+  std::vector<ShardedBookRef> refs;
+
+  for (int shard_index = 0; shard_index < static_cast<int>(shard_results.size()); shard_index++) {
+    for (int index: shard_results[shard_index]) {
+      refs.push_back({shard_index, index});
+    }
+  }
+
+  return refs;
+}
+
+std::vector<ShardedBookRef> ShardedBookStore::FindBooksByTitleRange(const std::string &from, const std::string &to) const {
+  // каждый шард возвращает пары (название, позиция) уже в лексикографическом порядке
+  using TitledRefs = std::vector<std::pair<std::string, int>>;
+
+  const auto shard_results = FanOut([&from, &to](const BookStore &shard) {
+    TitledRefs titled_refs;
+
+    for (int index: shard.FindBooksByTitleRange(from, to)) {
+      titled_refs.emplace_back(shard.GetBooks()[index].GetTitle(), index);
+    }
+
+    return titled_refs;
+  });
+
+  // k-путевое слияние отсортированных результатов шардов
+  std::vector<std::size_t> cursors(shard_results.size(), 0);
+  std::vector<ShardedBookRef> refs;
+
+  while (true) {
+    int min_shard = -1;
+
+    for (int shard_index = 0; shard_index < static_cast<int>(shard_results.size()); shard_index++) {
+      if (cursors[shard_index] == shard_results[shard_index].size()) continue;
+
+      // при равных названиях первым идет меньший номер шарда (шарды перебираются по возрастанию)
+      if (min_shard < 0 || shard_results[shard_index][cursors[shard_index]].first
+          < shard_results[min_shard][cursors[min_shard]].first) {
+        min_shard = shard_index;
+      }
+    }
+
+    if (min_shard < 0) break;
+
+    refs.push_back({min_shard, shard_results[min_shard][cursors[min_shard]].second});
+    cursors[min_shard] += 1;
+  }
+
+  return refs;
+}
+
+const std::string &ShardedBookStore::GetName() const {
+  return name_;
+}
+
+int ShardedBookStore::GetSize() const {
+  int size = 0;
+
+  for (const auto &shard: shards_) {
+    std::lock_guard lock(shard->mutex);
+    size += shard->store.GetSize();
+  }
+
+  return size;
+}
+
+int ShardedBookStore::GetNumShards() const {
+  return static_cast<int>(shards_.size());
+}
+
+const BookStore &ShardedBookStore::GetShard(int shard) const {
+  if (shard < 0 || shard >= GetNumShards()) {
+    throw std::invalid_argument("ShardedBookStore::shard is out of range");
+  }
+  return shards_[shard]->store;
+}
+
+int ShardedBookStore::GetShardIndex(const std::string &title) const {
+  return static_cast<int>(hash_title(title) % shards_.size());
+}
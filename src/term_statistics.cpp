@@ -0,0 +1,183 @@
+#include "term_statistics.hpp"
+
+#include <algorithm>  // max, min, sort
+#include <future>
+#include <thread>     // hardware_concurrency
+
+#include "thread_pool.hpp"  // ThreadPool
+#include "tokenizer.hpp"    // for_each_token
+#include "top_k.hpp"        // TopK
+
+namespace {
+
+// таблица терминов, построенная одним потоком по непрерывному диапазону книг
+struct LocalTable {
+  std::unordered_map<std::string, int> term_ids;  // термин -> локальный идентификатор
+  std::vector<const std::string *> terms;         // локальный идентификатор -> термин (ключ таблицы)
+  std::vector<long long> term_counts;             // локальный идентификатор -> кол-во вхождений
+  std::vector<int> document_frequencies;          // локальный идентификатор -> кол-во книг
+  std::vector<BookTermStatistics> books;          // статистика книг диапазона
+  long long num_tokens{0};                        // кол-во слов в диапазоне
+};
+
+// приведение латинских букв слова к нижнему регистру (буфер переиспользуется между словами)
+void to_lower(std::string_view token, std::string &term) {
+  term.assign(token.data(), token.size());
+
+  for (char &symbol: term) {
+    if (symbol >= 'A' && symbol <= 'Z') {
+      symbol = static_cast<char>(symbol | 0x20);
+    }
+  }
+}
+
+LocalTable build_local_table(const BookStore &store, int first, int last) {
+  LocalTable table;
+  table.books.resize(last - first);
+
+  const Book *books = store.GetBooks();
+  const bool has_removed = store.GetNumRemoved() > 0;
+
+  std::string term;
+  std::vector<int> book_term_counts;  // локальный идентификатор -> кол-во вхождений в текущую книгу
+  std::vector<int> book_terms;        // идентификаторы терминов текущей книги
+
+  for (int index = first; index < last; index++) {
+    if (has_removed && store.IsRemoved(index)) continue;
+
+    BookTermStatistics &stats = table.books[index - first];
+
+    for_each_token(books[index].GetContent(), [&](std::string_view token) {
+      to_lower(token, term);
+
+      const auto [it, is_inserted] = table.term_ids.try_emplace(term, static_cast<int>(table.terms.size()));
+
+      if (is_inserted) {
+        table.terms.push_back(&it->first);
+        table.term_counts.push_back(0);
+        table.document_frequencies.push_back(0);
+        book_term_counts.push_back(0);
+      }
+
+      const int id = it->second;
+      table.term_counts[id] += 1;
+
+      if (book_term_counts[id]++ == 0) {
+        book_terms.push_back(id);
+      }
+
+      stats.num_tokens += 1;
+    });
+
+    std::sort(book_terms.begin(), book_terms.end());
+    stats.term_counts.reserve(book_terms.size());
+
+    for (int id: book_terms) {
+      stats.term_counts.emplace_back(id, book_term_counts[id]);
+      table.document_frequencies[id] += 1;
+      book_term_counts[id] = 0;
+    }
+
+    book_terms.clear();
+    table.num_tokens += stats.num_tokens;
+  }
+
+  return table;
+}
+
+}  // namespace
+
+int TermStatistics::FindTerm(std::string_view term) const {
+  std::string key;
+  to_lower(term, key);
+
+  const auto it = term_ids_.find(key);
+  return it != term_ids_.end() ? it->second : -1;
+}
+
+std::vector<TermCount> TermStatistics::TopTerms(int k) const {
+  auto top = TopK<std::pair<long long, int>>(k);
+
+  for (int id = 0; id < GetVocabularySize(); id++) {
+    top.Push({term_counts[id], -id});  // при равенстве выше термин, встретившийся раньше
+  }
+
+  std::vector<TermCount> result;
+
+  for (const auto &[count, id]: top.Extract()) {
+    result.push_back({terms[-id], count});
+  }
+
+  return result;
+}
+
+int TermStatistics::GetVocabularySize() const {
+  return static_cast<int>(terms.size());
+}
+
+TermStatistics build_term_statistics(const BookStore &store, int num_threads) {
+  const int size = store.GetNumSlots();
+
+  if (num_threads <= 0) {
+    num_threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  }
+  num_threads = std::max(1, std::min(num_threads, size));
+
+  // фаза 1: независимое построение таблиц по диапазонам книг
+  std::vector<LocalTable> tables;
+
+  if (num_threads == 1) {
+    tables.push_back(build_local_table(store, 0, size));
+  } else {
+    ThreadPool pool(num_threads);
+    std::vector<std::future<LocalTable>> futures;
+
+    for (int thread = 0; thread < num_threads; thread++) {
+      const int first = static_cast<int>(static_cast<long long>(size) * thread / num_threads);
+      const int last = static_cast<int>(static_cast<long long>(size) * (thread + 1) / num_threads);
+      futures.push_back(pool.Submit([&store, first, last] { return build_local_table(store, first, last); }));
+    }
+
+    for (auto &future: futures) {
+      tables.push_back(future.get());
+    }
+  }
+
+  // фаза 2: слияние таблиц в порядке диапазонов (сохраняет порядок первого вхождения терминов)
+  TermStatistics stats;
+  stats.books.reserve(size);
+
+  std::vector<int> global_ids;
+
+  for (auto &table: tables) {
+    global_ids.resize(table.terms.size());
+
+    for (std::size_t local_id = 0; local_id < table.terms.size(); local_id++) {
+      const auto [it, is_inserted] = stats.term_ids_.try_emplace(*table.terms[local_id], stats.GetVocabularySize());
+
+      if (is_inserted) {
+        stats.terms.push_back(it->first);
+        stats.term_counts.push_back(0);
+        stats.document_frequencies.push_back(0);
+      }
+
+      const int id = it->second;
+      global_ids[local_id] = id;
+      stats.term_counts[id] += table.term_counts[local_id];
+      stats.document_frequencies[id] += table.document_frequencies[local_id];
+    }
+
+    for (auto &book: table.books) {
+      for (auto &[id, count]: book.term_counts) {
+        id = global_ids[id];
+      }
+      std::sort(book.term_counts.begin(), book.term_counts.end());
+
+      stats.books.push_back(std::move(book));
+    }
+
+    stats.num_tokens += table.num_tokens;
+  }
+
+  return stats;
+}
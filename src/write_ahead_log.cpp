@@ -0,0 +1,561 @@
+#include "write_ahead_log.hpp"
+
+#include <fcntl.h>   // open
+#include <unistd.h>  // write, pread, fdatasync, ftruncate, close, lseek
+
+#include <algorithm>  // min
+#include <cerrno>
+#include <cstdint>
+#include <fstream>
+#include <iterator>  // istreambuf_iterator
+#include <unordered_map>
+#include <utility>   // move
+#include <vector>
+
+#include "book_store.hpp"
+
+namespace {
+
+// размер заголовка записи: длина полезной нагрузки и контрольная сумма
+constexpr std::size_t kHeaderSize = 8;
+
+// тип записи (первый байт полезной нагрузки)
+constexpr char kAddBookRecord = 0;     // [книга]
+constexpr char kRemoveBookRecord = 1;  // [смещение записи добавления]
+constexpr char kAddAuthorRecord = 2;   // [смещение записи добавления][автор]
+
+// контрольная сумма FNV-1a
+std::uint32_t checksum(const char *data, std::size_t size) {
+  std::uint32_t hash = 2166136261u;
+  for (std::size_t index = 0; index < size; index++) {
+    hash ^= static_cast<unsigned char>(data[index]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void put_u32(std::string &out, std::uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<char>((value >> shift) & 0xFFu));
+  }
+}
+
+std::uint32_t get_u32(const char *data) {
+  std::uint32_t value = 0;
+  for (int index = 0; index < 4; index++) {
+    value |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[index])) << (8 * index);
+  }
+  return value;
+}
+
+// целое переменной длины (по 7 бит в байте)
+void put_varint(std::string &out, std::uint64_t value) {
+  while (value >= 0x80u) {
+    out.push_back(static_cast<char>((value & 0x7Fu) | 0x80u));
+    value >>= 7;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+bool get_varint(const char *&data, const char *end, std::uint64_t &value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && data < end; shift += 7) {
+    const auto byte = static_cast<unsigned char>(*data++);
+    value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+    if ((byte & 0x80u) == 0) return true;
+  }
+  return false;
+}
+
+void put_string(std::string &out, const std::string &value) {
+  put_varint(out, value.size());
+  out.append(value);
+}
+
+bool get_string(const char *&data, const char *end, std::string &value) {
+  std::uint64_t size = 0;
+  if (!get_varint(data, end, size) || size > static_cast<std::uint64_t>(end - data)) return false;
+
+  value.assign(data, static_cast<std::size_t>(size));
+  data += size;
+  return true;
+}
+
+void put_author(std::string &out, const Author &author) {
+  put_string(out, author.GetFullName());
+  put_varint(out, static_cast<std::uint64_t>(author.GetAge()));
+  out.push_back(static_cast<char>(author.GetSex()));
+}
+
+bool get_author(const char *&data, const char *end, Author &author) {
+  std::string full_name;
+  std::uint64_t age = 0;
+
+  if (!get_string(data, end, full_name) || !get_varint(data, end, age) || data == end) {
+    return false;
+  }
+
+  const auto sex = static_cast<unsigned char>(*data++);
+
+  if (sex > static_cast<unsigned char>(Sex::UNDEFINED)) {
+    return false;
+  }
+
+  author = Author::Restore(full_name, static_cast<int>(age), static_cast<Sex>(sex));
+  return true;
+}
+
+// дозапись буфера с позиции offset с повтором при прерывании системного вызова;
+// offset сдвигается на каждый записанный байт, в том числе при ошибке после частичной записи
+bool write_all(int fd, const std::string &buffer, std::size_t &offset) {
+  while (offset < buffer.size()) {
+    const ssize_t written = ::write(fd, buffer.data() + offset, buffer.size() - offset);
+
+    if (written < 0) {
+      if (errno == EINTR) continue;
+      return false;
+    }
+
+    offset += static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+// размер префикса файла журнала из целых записей (по заголовкам, без проверки контрольных сумм);
+// -1 - ошибка чтения
+long long complete_records_size(int fd, long long file_size) {
+  long long offset = 0;
+  char header[kHeaderSize];
+
+  while (file_size - offset >= static_cast<long long>(kHeaderSize)) {
+    const ssize_t num_read = ::pread(fd, header, kHeaderSize, static_cast<off_t>(offset));
+
+    if (num_read < 0 && errno == EINTR) continue;
+    if (num_read != static_cast<ssize_t>(kHeaderSize)) return -1;
+
+    const long long record_size = static_cast<long long>(kHeaderSize) + get_u32(header);
+
+    if (file_size - offset < record_size) break;
+    offset += record_size;
+  }
+
+  return offset;
+}
+
+}  // namespace
+
+WriteAheadLog::~WriteAheadLog() {
+  Close();
+}
+
+WalStatus WriteAheadLog::Open(const std::string &path, int batch_size, std::chrono::milliseconds window) {
+  if (IsOpen()) {
+    Close();
+  }
+
+  // чтение нужно для поиска обрезанной последней записи (см. complete_records_size)
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+
+  if (fd_ < 0) {
+    return WalStatus::OPEN_FAILED;
+  }
+
+  // обрезанная при сбое последняя запись отрезается: записи, дописанные после нее,
+  // Replay не прочитал бы. С размера файла начинаются смещения новых записей
+  const long long file_size = static_cast<long long>(::lseek(fd_, 0, SEEK_END));
+  next_offset_ = file_size < 0 ? -1 : complete_records_size(fd_, file_size);
+
+  if (next_offset_ < 0 || (next_offset_ < file_size && ::ftruncate(fd_, static_cast<off_t>(next_offset_)) != 0)) {
+    ::close(fd_);
+    fd_ = -1;
+    return WalStatus::OPEN_FAILED;
+  }
+
+  batch_size_ = batch_size > 0 ? batch_size : 1;
+  window_ = window;
+  buffer_.reserve(static_cast<std::size_t>(batch_size_) * 256);
+  flush_status_ = WalStatus::SUCCESS;
+  is_stopping_ = false;
+  is_broken_ = false;
+
+  // при нулевом окне каждая запись подтверждается в Append - фоновый поток не нужен
+  if (window_.count() > 0) {
+    flusher_ = std::thread([this] { run_flusher(); });
+  }
+
+  return WalStatus::SUCCESS;
+}
+
+WalStatus WriteAheadLog::Append(const Book &book, long long *offset) {
+  if (!IsOpen()) {
+    return WalStatus::NOT_OPEN;
+  }
+
+  std::string record(kHeaderSize, '\0');
+  record.push_back(kAddBookRecord);
+  encode_book(book, record);
+
+  return append_record(record, offset);
+}
+
+WalStatus WriteAheadLog::AppendRemove(long long offset) {
+  if (!IsOpen()) {
+    return WalStatus::NOT_OPEN;
+  }
+
+  std::string record(kHeaderSize, '\0');
+  record.push_back(kRemoveBookRecord);
+  put_varint(record, static_cast<std::uint64_t>(offset));
+
+  return append_record(record, nullptr);
+}
+
+WalStatus WriteAheadLog::AppendAuthor(long long offset, const Author &author) {
+  if (!IsOpen()) {
+    return WalStatus::NOT_OPEN;
+  }
+
+  std::string record(kHeaderSize, '\0');
+  record.push_back(kAddAuthorRecord);
+  put_varint(record, static_cast<std::uint64_t>(offset));
+  put_author(record, author);
+
+  return append_record(record, nullptr);
+}
+
+WalStatus WriteAheadLog::Sync() {
+  std::lock_guard lock(mutex_);
+  return sync_locked();
+}
+
+WalStatus WriteAheadLog::Close() {
+  if (!IsOpen()) {
+    return WalStatus::SUCCESS;
+  }
+
+  if (flusher_.joinable()) {
+    {
+      std::lock_guard lock(mutex_);
+      is_stopping_ = true;
+    }
+    has_pending_.notify_one();
+    flusher_.join();
+  }
+
+  std::lock_guard lock(mutex_);
+  const WalStatus status = sync_locked();
+
+  ::close(fd_);
+  fd_ = -1;
+
+  // незаписанные данные закрытого журнала отбрасываются
+  buffer_.clear();
+  num_written_ = 0;
+  num_pending_ = 0;
+
+  return status;
+}
+
+WalStatus WriteAheadLog::Replay(const std::string &path, BookStore &store, int *num_replayed) {
+  if (num_replayed != nullptr) {
+    *num_replayed = 0;
+  }
+
+  auto fs = std::ifstream(path, std::ios::binary);
+
+  if (!fs) {
+    return WalStatus::OPEN_FAILED;
+  }
+
+  const std::string data{std::istreambuf_iterator<char>(fs), std::istreambuf_iterator<char>()};
+  std::size_t offset = 0;
+
+  // смещение записи добавления -> позиция книги в магазине (магазин не уплотняется во время восстановления)
+  std::unordered_map<long long, int> positions;
+
+  const auto find_position = [&positions](const char *&data, const char *end, int &position) {
+    std::uint64_t book_offset = 0;
+    if (!get_varint(data, end, book_offset)) return false;
+
+    const auto found = positions.find(static_cast<long long>(book_offset));
+    if (found == positions.end()) return false;
+
+    position = found->second;
+    return true;
+  };
+
+  while (data.size() - offset >= kHeaderSize) {
+    const std::uint32_t payload_size = get_u32(data.data() + offset);
+    const std::uint32_t expected_checksum = get_u32(data.data() + offset + 4);
+
+    // обрезанная последняя запись: сбой произошел во время записи пакета
+    if (data.size() - offset - kHeaderSize < payload_size) {
+      break;
+    }
+
+    const char *payload = data.data() + offset + kHeaderSize;
+    const char *end = payload + payload_size;
+
+    if (payload_size == 0 || checksum(payload, payload_size) != expected_checksum) {
+      return WalStatus::CORRUPTED_RECORD;
+    }
+
+    const char type = *payload++;
+    bool is_applied = false;
+
+    if (type == kAddBookRecord) {
+      Book book;
+
+      if (decode_book(payload, static_cast<std::size_t>(end - payload), book) &&
+          store.AddBook(book) == ResizeStorageStatus::SUCCESS) {
+        const int position = store.GetNumSlots() - 1;
+
+        positions[static_cast<long long>(offset)] = position;
+        store.restore_log_offset(position, static_cast<long long>(offset));
+        is_applied = true;
+      }
+    } else if (type == kRemoveBookRecord) {
+      int position = 0;
+      is_applied = find_position(payload, end, position) && payload == end;
+
+      if (is_applied) {
+        store.RemoveBook(position);
+      }
+    } else if (type == kAddAuthorRecord) {
+      int position = 0;
+      Author author;
+      is_applied = find_position(payload, end, position) && get_author(payload, end, author) && payload == end;
+
+      if (is_applied) {
+        store.AddBookAuthor(position, author);
+      }
+    }
+
+    if (!is_applied) {
+      return WalStatus::CORRUPTED_RECORD;
+    }
+
+    offset += kHeaderSize + payload_size;
+
+    if (num_replayed != nullptr) {
+      *num_replayed += 1;
+    }
+  }
+
+  return WalStatus::SUCCESS;
+}
+
+bool WriteAheadLog::IsOpen() const {
+  return fd_ >= 0;
+}
+
+int WriteAheadLog::GetNumPending() const {
+  std::lock_guard lock(mutex_);
+  return num_pending_;
+}
+
+long long WriteAheadLog::GetNumAppended() const {
+  std::lock_guard lock(mutex_);
+  return num_appended_;
+}
+
+long long WriteAheadLog::GetNumSyncs() const {
+  std::lock_guard lock(mutex_);
+  return num_syncs_;
+}
+
+WalStatus WriteAheadLog::append_record(std::string &record, long long *offset) {
+  const std::size_t payload_size = record.size() - kHeaderSize;
+
+  std::string header;
+  put_u32(header, static_cast<std::uint32_t>(payload_size));
+  put_u32(header, checksum(record.data() + kHeaderSize, payload_size));
+  record.replace(0, kHeaderSize, header);
+
+  // запись кодируется до блокировки, чтобы не задерживать фоновое подтверждение
+  std::lock_guard lock(mutex_);
+  return append_locked(record, offset);
+}
+
+WalStatus WriteAheadLog::append_locked(const std::string &record, long long *offset) {
+  if (is_broken_) {
+    return WalStatus::WRITE_FAILED;
+  }
+
+  // ошибка фонового подтверждения передается первому вызывающему, его запись не добавляется
+  if (flush_status_ != WalStatus::SUCCESS) {
+    const WalStatus status = flush_status_;
+    flush_status_ = WalStatus::SUCCESS;
+    return status;
+  }
+
+  const long long record_offset = next_offset_;
+  const std::size_t buffer_offset = buffer_.size();
+
+  if (offset != nullptr) {
+    *offset = record_offset;
+  }
+
+  if (num_pending_ == 0) {
+    batch_start_ = std::chrono::steady_clock::now();
+    has_pending_.notify_one();  // поток подтверждения начинает отсчет окна
+  }
+
+  buffer_.append(record);
+  next_offset_ += static_cast<long long>(record.size());
+  num_pending_ += 1;
+  num_appended_ += 1;
+
+  if (num_pending_ < batch_size_ && std::chrono::steady_clock::now() - batch_start_ < window_) {
+    return WalStatus::SUCCESS;
+  }
+
+  const WalStatus status = sync_locked();
+
+  // вызывающий получит ошибку и не применит изменение - его запись не должна попасть в журнал
+  if (status != WalStatus::SUCCESS) {
+    rollback_locked(record_offset, buffer_offset);
+  }
+
+  return status;
+}
+
+void WriteAheadLog::rollback_locked(long long record_offset, std::size_t buffer_offset) {
+  // запись либо осталась в буфере (возможно, частично записанной в файл), либо записана целиком
+  bool is_in_file = true;
+
+  if (buffer_.size() > buffer_offset) {
+    is_in_file = num_written_ > buffer_offset;
+    num_written_ = std::min(num_written_, buffer_offset);
+    buffer_.resize(buffer_offset);
+    num_pending_ -= 1;
+  }
+
+  // байты записи обрезаются в файле: последующие записи ложатся на ее место
+  if (is_in_file && ::ftruncate(fd_, static_cast<off_t>(record_offset)) != 0) {
+    // файл нельзя привести в согласованное состояние - журнал перестает принимать записи
+    is_broken_ = true;
+  }
+
+  next_offset_ = record_offset;
+  num_appended_ -= 1;
+}
+
+WalStatus WriteAheadLog::sync_locked() {
+  if (!IsOpen()) {
+    return WalStatus::NOT_OPEN;
+  }
+
+  // дозапись после необрезанной отклоненной записи сделала бы ее частью журнала
+  if (is_broken_) {
+    return WalStatus::WRITE_FAILED;
+  }
+
+  WalStatus status = WalStatus::SUCCESS;
+
+  if (num_pending_ > 0) {
+    // запись продолжается с первого незаписанного байта (после частичной записи буфер не дублируется)
+    if (!write_all(fd_, buffer_, num_written_)) {
+      return WalStatus::WRITE_FAILED;
+    }
+
+    buffer_.clear();
+    num_written_ = 0;
+    num_pending_ = 0;
+
+    if (::fdatasync(fd_) != 0) {
+      status = WalStatus::SYNC_FAILED;
+    } else {
+      num_syncs_ += 1;
+    }
+  }
+
+  // ошибка фонового подтверждения передается первому вызывающему
+  if (status == WalStatus::SUCCESS) {
+    status = flush_status_;
+  }
+  flush_status_ = WalStatus::SUCCESS;
+
+  return status;
+}
+
+void WriteAheadLog::run_flusher() {
+  std::unique_lock lock(mutex_);
+
+  while (!is_stopping_) {
+    if (num_pending_ == 0) {
+      has_pending_.wait(lock, [this] { return is_stopping_ || num_pending_ > 0; });
+      continue;
+    }
+
+    // окно отсчитывается от первой записи текущего пакета (пакет мог смениться во время ожидания)
+    const auto deadline = batch_start_ + window_;
+
+    if (std::chrono::steady_clock::now() < deadline) {
+      has_pending_.wait_until(lock, deadline);
+      continue;
+    }
+
+    const WalStatus status = sync_locked();
+
+    if (status != WalStatus::SUCCESS) {
+      flush_status_ = status;
+
+      // неудачная запись повторяется не чаще раза в окно
+      batch_start_ = std::chrono::steady_clock::now();
+    }
+  }
+}
+
+void encode_book(const Book &book, std::string &out) {
+  put_string(out, book.GetTitle());
+  put_string(out, book.GetContent());
+  out.push_back(static_cast<char>(book.GetGenre()));
+  out.push_back(static_cast<char>(book.GetPublisher()));
+
+  put_varint(out, book.GetAuthors().size());
+
+  for (const auto &author: book.GetAuthors()) {
+    put_author(out, author);
+  }
+}
+
+bool decode_book(const char *data, std::size_t size, Book &book) {
+  const char *end = data + size;
+
+  BookRecord record;
+
+  if (!get_string(data, end, record.title) || !get_string(data, end, record.content) || end - data < 2) {
+    return false;
+  }
+
+  const auto genre = static_cast<unsigned char>(*data++);
+  const auto publisher = static_cast<unsigned char>(*data++);
+
+  if (genre > static_cast<unsigned char>(Genre::UNDEFINED) || publisher > static_cast<unsigned char>(Publisher::UNDEFINED)) {
+    return false;
+  }
+
+  std::uint64_t num_authors = 0;
+  if (!get_varint(data, end, num_authors)) return false;
+
+  std::vector<Author> authors;
+
+  for (std::uint64_t index = 0; index < num_authors; index++) {
+    Author author;
+
+    if (!get_author(data, end, author)) {
+      return false;
+    }
+
+    authors.push_back(std::move(author));
+  }
+
+  if (data != end) {
+    return false;
+  }
+
+  book = Book::Restore(record.title, record.content, static_cast<Genre>(genre), static_cast<Publisher>(publisher),
+                       authors);
+  return true;
+}
@@ -0,0 +1,74 @@
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "async_loader.hpp"
+#include "book_store.hpp"
+#include "utility/dataset_loader.hpp"
+
+using namespace std;
+using namespace test::utils;
+using namespace Catch::Matchers;
+
+SCENARIO("load book contents asynchronously") {
+  const string contents_dir = string{kDatasetDir} + "contents/";
+  const AuthorRecord author = {"S.King", 73, Sex::MALE};
+
+  GIVEN("an asynchronous loader") {
+    const int num_io_threads = GENERATE(1, 4);
+    auto loader = AsyncContentLoader(num_io_threads);
+
+    WHEN("loading a single content file") {
+      auto content = loader.LoadContent(contents_dir + "3.txt");
+      auto missing = loader.LoadContent(contents_dir + "missing.txt");
+
+      THEN("the file must be read completely") {
+        REQUIRE(content.get() == load_book_contents({"3.txt"}, 1).front());
+        REQUIRE(missing.get().empty());
+      }
+    }
+
+    AND_WHEN("loading a single book") {
+      auto book = loader.LoadBook({BookRecord{"3.txt", "", Genre::HORROR, Publisher::USA, {author}}, contents_dir + "3.txt"});
+
+      THEN("validation must be deferred to the thread calling get") {
+        REQUIRE(book.wait_for(chrono::seconds(0)) == future_status::deferred);
+
+        const Result<Book> result = book.get();
+        REQUIRE(result.IsOk());
+        REQUIRE(result.value.GetContent() == load_book_contents({"3.txt"}, 1).front());
+      }
+    }
+
+    AND_WHEN("loading books into a bookstore") {
+      auto book_store = BookStore("Async Books");
+
+      vector<BookSource> sources;
+      for (int round = 0; round < 10; round++) {
+        for (const string file: {"1.txt", "2.txt", "missing.txt", "3.txt"}) {
+          sources.push_back({BookRecord{file, "", Genre::HORROR, Publisher::USA, {author}}, contents_dir + file});
+        }
+      }
+
+      const int max_in_flight = GENERATE(1, 8);
+      const BulkAddReport report = loader.LoadBooksInto(book_store, sources, max_in_flight);
+
+      THEN("books must be added in the order of sources") {
+        REQUIRE(report.num_added == 30);
+        REQUIRE(book_store.GetSize() == 30);
+        REQUIRE_THAT(book_store.GetBooks()[0].GetTitle(), Equals("1.txt"));
+        REQUIRE_THAT(book_store.GetBooks()[2].GetTitle(), Equals("3.txt"));
+        REQUIRE(book_store.GetBooks()[2].GetContent() == load_book_contents({"3.txt"}, 1).front());
+      }
+
+      AND_THEN("unreadable files must be rejected") {
+        REQUIRE(report.rejected.size() == 10);
+        REQUIRE(report.rejected.front().row == 2);
+        REQUIRE(report.rejected.front().status == ValidationStatus::EMPTY_CONTENT);
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "author_index.hpp"
+#include "book_store.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("intersect sorted posting lists") {
+
+  GIVEN("posting lists of similar length") {
+    const vector<int> lhs = {1, 3, 5, 7, 9};
+    const vector<int> rhs = {2, 3, 4, 7, 10};
+
+    THEN("intersection must contain common positions") {
+      REQUIRE_THAT(intersect_postings(lhs, rhs), Equals(vector<int>{3, 7}));
+      REQUIRE_THAT(intersect_postings(rhs, lhs), Equals(vector<int>{3, 7}));
+    }
+  }
+
+  AND_GIVEN("posting lists of very different length") {
+    vector<int> longer;
+    for (int position = 0; position < 10000; position += 2) {
+      longer.push_back(position);
+    }
+    const vector<int> shorter = {0, 1, 500, 501, 9998, 10000};
+
+    THEN("galloping intersection must contain common positions") {
+      REQUIRE_THAT(intersect_postings(shorter, longer), Equals(vector<int>{0, 500, 9998}));
+      REQUIRE_THAT(intersect_postings(longer, shorter), Equals(vector<int>{0, 500, 9998}));
+    }
+  }
+}
+
+SCENARIO("search books by authors") {
+  auto book_store = BookStore("Authored Books");
+
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+  const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  book_store.AddBook(Book("Hobbit", "Content", Genre::FANTASY, Publisher::ENG, {tolkien}));
+  book_store.AddBook(Book("Harry Potter", "Content", Genre::FANTASY, Publisher::ENG, {rowling}));
+  book_store.AddBook(Book("Joint Work", "Content", Genre::FANTASY, Publisher::USA, {king, rowling}));
+  book_store.AddBook(Book("Misery", "Content", Genre::HORROR, Publisher::USA, {king}));
+
+  GIVEN("a bookstore with books") {
+
+    WHEN("searching books of a single author") {
+      THEN("all books of the author must be found") {
+        REQUIRE_THAT(book_store.FindBooksByAuthor("J.K.Rowling"), Equals(vector<int>{1, 2}));
+        REQUIRE_THAT(book_store.FindBooksByAuthor("S.King"), Equals(vector<int>{2, 3}));
+        REQUIRE(book_store.FindBooksByAuthor("W.Shakespeare").empty());
+      }
+    }
+
+    AND_WHEN("searching books of co-authors") {
+      THEN("only joint books must be found") {
+        REQUIRE_THAT(book_store.FindBooksByCoAuthors({"S.King", "J.K.Rowling"}), Equals(vector<int>{2}));
+        REQUIRE(book_store.FindBooksByCoAuthors({"S.King", "J.Tolkien"}).empty());
+        REQUIRE(book_store.FindBooksByCoAuthors({}).empty());
+      }
+    }
+
+    AND_WHEN("adding an author to a stored book") {
+      const bool status = book_store.AddBookAuthor(0, king);
+      const bool duplicate_status = book_store.AddBookAuthor(0, king);
+
+      THEN("the index must be updated") {
+        REQUIRE(status);
+        REQUIRE_FALSE(duplicate_status);
+        REQUIRE(book_store.GetBooks()[0].GetAuthors().size() == 2);
+        REQUIRE_THAT(book_store.FindBooksByAuthor("S.King"), Equals(vector<int>{0, 2, 3}));
+        REQUIRE_THAT(book_store.FindBooksByCoAuthors({"J.Tolkien", "S.King"}), Equals(vector<int>{0}));
+      }
+
+      AND_THEN("invalid book positions must be rejected") {
+        REQUIRE_THROWS(book_store.AddBookAuthor(-1, king), Contains("BookStore::index"));
+        REQUIRE_THROWS(book_store.AddBookAuthor(book_store.GetSize(), king), Contains("BookStore::index"));
+      }
+    }
+  }
+}
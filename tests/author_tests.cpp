@@ -173,4 +173,35 @@ SCENARIO("compare authors using operator ==") {
       }
     }
   }
-}
\ No newline at end of file
+}
+SCENARIO("create author without exceptions") {
+
+  GIVEN("valid factory arguments") {
+    const auto result = Author::TryCreate("J.K. Rowling", Author::kMinAuthorAge, Sex::FEMALE);
+
+    THEN("the author must be created") {
+      REQUIRE(result.IsOk());
+      REQUIRE(result.value == Author("J.K. Rowling", Author::kMinAuthorAge, Sex::FEMALE));
+    }
+  }
+
+  AND_GIVEN("invalid factory arguments") {
+    THEN("an error status must be returned") {
+      REQUIRE(Author::TryCreate("", Author::kMinAuthorAge, Sex::MALE).status == ValidationStatus::EMPTY_FULL_NAME);
+      REQUIRE(Author::TryCreate("S. King", Author::kMinAuthorAge - 1, Sex::MALE).status
+                  == ValidationStatus::AUTHOR_TOO_YOUNG);
+      REQUIRE(Author::TryCreate(AuthorRecord{"", Author::kMinAuthorAge, Sex::MALE}).status
+                  == ValidationStatus::EMPTY_FULL_NAME);
+    }
+  }
+
+  AND_GIVEN("invalid setter arguments") {
+    auto author = Author("S. King", 73, Sex::MALE);
+
+    THEN("an error status must be returned and fields must stay the same") {
+      REQUIRE(author.TrySetAge(Author::kMinAuthorAge - 1) == ValidationStatus::AUTHOR_TOO_YOUNG);
+      REQUIRE(author.TrySetFullName("") == ValidationStatus::EMPTY_FULL_NAME);
+      REQUIRE(author == Author("S. King", 73, Sex::MALE));
+    }
+  }
+}
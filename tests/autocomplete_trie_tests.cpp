@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "autocomplete_trie.hpp"
+#include "book_store.hpp"
+
+using namespace std;
+
+SCENARIO("complete prefixes with the radix trie") {
+
+  GIVEN("a trie with words sharing prefixes") {
+    auto trie = AutocompleteTrie();
+
+    // веса: harry potter - 3, harvest - 2, остальные - 1
+    for (const string word: {"Harry Potter", "harvest", "Hobbit", "harry potter", "harvest", "Harry Potter", "Harp",
+                             "hobbits", "It"}) {
+      trie.Insert(word);
+    }
+
+    THEN("completions must be ranked by weight, then lexicographically") {
+      REQUIRE(trie.GetSize() == 6);
+      REQUIRE(trie.Complete("har", 10) == vector<string>{"Harry Potter", "harvest", "Harp"});
+      REQUIRE(trie.Complete("HOB", 10) == vector<string>{"Hobbit", "hobbits"});
+      REQUIRE(trie.Complete("hobbits", 10) == vector<string>{"hobbits"});
+      REQUIRE(trie.Complete("harry p", 1) == vector<string>{"Harry Potter"});
+      REQUIRE(trie.Complete("", 2) == vector<string>{"Harry Potter", "harvest"});
+    }
+
+    AND_THEN("unknown prefixes must have no completions") {
+      REQUIRE(trie.Complete("hx", 10).empty());
+      REQUIRE(trie.Complete("harry potter 2", 10).empty());
+      REQUIRE(trie.Complete("har", 0).empty());
+    }
+  }
+
+  AND_GIVEN("more words than a node caches") {
+    auto trie = AutocompleteTrie();
+
+    const int num_words = 3 * AutocompleteTrie::kMaxCompletions;
+
+    // вес слова равен его номеру
+    for (int word = 0; word < num_words; word++) {
+      for (int repeat = 0; repeat <= word; repeat++) {
+        trie.Insert("word " + to_string(word));
+      }
+    }
+
+    THEN("only the heaviest words must be suggested") {
+      const vector<string> completions = trie.Complete("wo", AutocompleteTrie::kMaxCompletions);
+
+      REQUIRE(completions.size() == AutocompleteTrie::kMaxCompletions);
+      REQUIRE(completions.front() == "word " + to_string(num_words - 1));
+      REQUIRE(completions.back() == "word " + to_string(num_words - AutocompleteTrie::kMaxCompletions));
+    }
+
+    AND_THEN("words beyond the cache must be suggested by walking the subtree in the same order") {
+      const vector<string> completions = trie.Complete("wo", num_words + 1);
+
+      REQUIRE(completions.size() == num_words);
+      for (int rank = 0; rank < num_words; rank++) {
+        REQUIRE(completions[rank] == "word " + to_string(num_words - 1 - rank));
+      }
+    }
+  }
+}
+
+SCENARIO("suggest titles and authors from the bookstore") {
+  auto book_store = BookStore("Suggested Books");
+
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto kafka = Author("F.Kafka", 40, Sex::MALE);
+
+  book_store.AddBook(Book("It", "Content", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Misery", "Content", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Metamorphosis", "Content", Genre::CLASSIC, Publisher::ENG, {kafka}));
+
+  GIVEN("a bookstore with books") {
+
+    THEN("titles and authors must be suggested by prefix") {
+      REQUIRE(book_store.SuggestTitles("m", 10) == vector<string>{"Metamorphosis", "Misery"});
+      REQUIRE(book_store.SuggestAuthors("", 10) == vector<string>{"S.King", "F.Kafka"});
+    }
+
+    WHEN("removing a book") {
+      book_store.RemoveBook(2);
+
+      THEN("its title and author must not be suggested") {
+        REQUIRE(book_store.SuggestTitles("m", 10) == vector<string>{"Misery"});
+        REQUIRE(book_store.SuggestAuthors("f", 10).empty());
+      }
+    }
+  }
+
+  AND_GIVEN("more titles than a node caches") {
+    const int num_titles = 2 * AutocompleteTrie::kMaxCompletions;
+
+    // кол-во книг с названием равно его номеру
+    for (int title = 1; title <= num_titles; title++) {
+      for (int copy = 0; copy < title; copy++) {
+        book_store.AddBook(Book("Volume " + to_string(title), "Content", Genre::CLASSIC, Publisher::ENG, {kafka}));
+      }
+    }
+
+    WHEN("all books with the cached titles are removed") {
+      const int num_removed = book_store.RemoveIf([](const Book &book) {
+        return book.GetTitle().size() == 9 && book.GetTitle() > "Volume " + to_string(AutocompleteTrie::kMaxCompletions);
+      });
+
+      THEN("the remaining titles must still fill the limit") {
+        REQUIRE(num_removed > 0);
+
+        const vector<string> titles = book_store.SuggestTitles("vol", 5);
+
+        REQUIRE(titles == vector<string>{"Volume 10", "Volume 9", "Volume 8", "Volume 7", "Volume 6"});
+      }
+    }
+  }
+}
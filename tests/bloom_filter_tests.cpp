@@ -0,0 +1,221 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bloom_filter.hpp"
+#include "book_store.hpp"
+
+using namespace std;
+
+SCENARIO("check membership with the blocked bloom filter") {
+
+  GIVEN("invalid filter parameters") {
+
+    THEN("the filter must not be created") {
+      REQUIRE_THROWS_AS(BloomFilter(0, 0.01), invalid_argument);
+      REQUIRE_THROWS_AS(BloomFilter(100, 0.0), invalid_argument);
+      REQUIRE_THROWS_AS(BloomFilter(100, 1.0), invalid_argument);
+    }
+  }
+
+  AND_GIVEN("an empty filter") {
+    const auto filter = BloomFilter();
+
+    THEN("no key must be contained") {
+      REQUIRE_FALSE(filter.MightContain("Harry Potter"));
+      REQUIRE(filter.GetSize() == 0);
+    }
+  }
+
+  AND_GIVEN("a filter filled up to its capacity") {
+    const int capacity = 20'000;
+    const double false_positive_rate = GENERATE(0.1, 0.01, 0.001);
+
+    auto filter = BloomFilter(capacity, false_positive_rate);
+
+    for (int key = 0; key < capacity; key++) {
+      filter.Insert("Title #" + to_string(key));
+    }
+
+    THEN("added keys must always be found") {
+      for (int key = 0; key < capacity; key++) {
+        REQUIRE(filter.MightContain("Title #" + to_string(key)));
+      }
+    }
+
+    AND_THEN("absent keys must be found with about the requested rate") {
+      const int num_probes = 100'000;
+      int num_false_positives = 0;
+
+      for (int key = 0; key < num_probes; key++) {
+        num_false_positives += filter.MightContain("Absent #" + to_string(key)) ? 1 : 0;
+      }
+
+      REQUIRE(num_false_positives < 1.5 * false_positive_rate * num_probes + 10);
+    }
+
+    AND_THEN("repeated insertions must not change the filter size") {
+      const int size = filter.GetSize();
+
+      REQUIRE_FALSE(filter.Insert("Title #0"));
+      REQUIRE(filter.GetSize() == size);
+    }
+  }
+}
+
+SCENARIO("check titles and authors in the bookstore") {
+  auto book_store = BookStore("Filtered Books");
+
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto kafka = Author("F.Kafka", 40, Sex::MALE);
+
+  GIVEN("a bookstore with more books than the initial filter capacity") {
+    const int num_books = 3 * PresenceFilterAggregate::kInitCapacity;
+
+    book_store.EnablePresenceFilters();
+
+    for (int index = 0; index < num_books; index++) {
+      book_store.AddBook(Book("Title #" + to_string(index), "Content", Genre::HORROR, Publisher::USA,
+                              {index % 2 == 0 ? king : kafka}));
+    }
+
+    THEN("existing titles and authors must be found") {
+      for (int index = 0; index < num_books; index++) {
+        REQUIRE(book_store.HasTitle("Title #" + to_string(index)));
+      }
+      REQUIRE(book_store.HasAuthor("S.King"));
+      REQUIRE(book_store.HasAuthor("F.Kafka"));
+
+      REQUIRE(book_store.GetTitleFilterStats().num_queries == num_books);
+      REQUIRE(book_store.GetTitleFilterStats().num_negatives == 0);
+    }
+
+    AND_THEN("most absent titles must be rejected by the filter") {
+      const int num_probes = 10'000;
+
+      for (int index = 0; index < num_probes; index++) {
+        REQUIRE_FALSE(book_store.HasTitle("Absent #" + to_string(index)));
+      }
+      REQUIRE_FALSE(book_store.HasAuthor("L.Tolstoy"));
+
+      const BloomFilterStats stats = book_store.GetTitleFilterStats();
+
+      REQUIRE(stats.num_queries == num_probes);
+      REQUIRE(stats.num_negatives + stats.num_false_positives == num_probes);
+      REQUIRE(stats.GetFalsePositiveRate() < 2 * PresenceFilterAggregate::kFalsePositiveRate);
+      REQUIRE(book_store.GetAuthorFilterStats().num_queries == 1);
+    }
+
+    AND_THEN("concurrent checks must all be counted") {
+      const int num_threads = 4;
+      const int num_probes = 1'000;
+      vector<thread> readers;
+
+      for (int reader = 0; reader < num_threads; reader++) {
+        readers.emplace_back([&book_store, reader] {
+          for (int index = 0; index < num_probes; index++) {
+            book_store.HasTitle("Absent #" + to_string(reader) + "/" + to_string(index));
+          }
+        });
+      }
+      for (auto &reader: readers) {
+        reader.join();
+      }
+
+      const BloomFilterStats stats = book_store.GetTitleFilterStats();
+
+      REQUIRE(stats.num_queries == num_threads * num_probes);
+      REQUIRE(stats.num_negatives + stats.num_false_positives == num_threads * num_probes);
+    }
+
+    WHEN("changing the false positive rate") {
+      const auto &filters = book_store.EnablePresenceFilters(0.001);
+
+      THEN("existing titles must still be found") {
+        REQUIRE(filters.GetFalsePositiveRate() == 0.001);
+        REQUIRE(filters.GetCapacity() >= num_books);
+        REQUIRE(book_store.HasTitle("Title #0"));
+        REQUIRE(book_store.HasTitle("Title #" + to_string(num_books - 1)));
+      }
+
+      AND_THEN("invalid rates must be rejected") {
+        REQUIRE_THROWS_AS(book_store.EnablePresenceFilters(0.0), invalid_argument);
+        REQUIRE_THROWS_AS(book_store.EnablePresenceFilters(2.0), invalid_argument);
+        REQUIRE(book_store.HasTitle("Title #0"));
+      }
+    }
+
+    WHEN("removing books and compacting the storage") {
+      book_store.RemoveIf([](const Book &book) { return book.GetAuthors()[0].GetFullName() == "F.Kafka"; });
+
+      THEN("titles and authors of removed books must not be found") {
+        REQUIRE_FALSE(book_store.HasTitle("Title #1"));
+        REQUIRE_FALSE(book_store.HasAuthor("F.Kafka"));
+        REQUIRE(book_store.GetTitleFilterStats().num_false_positives == 1);
+      }
+
+      AND_WHEN("compacting the storage") {
+        book_store.Compact();
+
+        THEN("the filters must not be rebuilt: removed strings are answered by the indexes") {
+          REQUIRE_FALSE(book_store.HasAuthor("F.Kafka"));
+          REQUIRE(book_store.HasTitle("Title #0"));
+          REQUIRE(book_store.GetAuthorFilterStats().num_false_positives == 1);
+        }
+      }
+
+      AND_WHEN("removed books outnumber live ones") {
+        // удаляется каждая вторая из оставшихся книг
+        int num_visited = 0;
+        book_store.RemoveIf([&num_visited](const Book &) { return num_visited++ % 2 == 0; });
+
+        THEN("removed strings must be rejected by the rebuilt filter") {
+          REQUIRE_FALSE(book_store.HasAuthor("F.Kafka"));
+          REQUIRE(book_store.HasAuthor("S.King"));
+          REQUIRE(book_store.GetAuthorFilterStats().num_negatives == 1);
+        }
+      }
+    }
+  }
+
+  AND_GIVEN("a bookstore with several distinct authors per book") {
+    const int num_books = 8 * PresenceFilterAggregate::kInitCapacity;
+    const int num_authors_per_book = 3;
+
+    const auto &filters = book_store.EnablePresenceFilters();
+
+    for (int index = 0; index < num_books; index++) {
+      vector<Author> authors;
+
+      for (int author = 0; author < num_authors_per_book; author++) {
+        authors.emplace_back("Author #" + to_string(index) + "/" + to_string(author), 40, Sex::FEMALE);
+      }
+      book_store.AddBook(Book("Title #" + to_string(index), "Content", Genre::DRAMA, Publisher::RUS, authors));
+    }
+
+    THEN("the filters must be rebuilt only when their key count doubles") {
+      // имен в num_authors_per_book раз больше, чем книг: фильтр имен удваивается от kInitCapacity
+      // до num_books * num_authors_per_book ключей - логарифмическое кол-во пересчетов
+      REQUIRE(filters.GetNumRebuilds() <= 6);
+      REQUIRE(filters.GetAuthorCapacity() > num_books * num_authors_per_book);
+      REQUIRE(book_store.HasAuthor("Author #0/2"));
+      REQUIRE(book_store.HasAuthor("Author #" + to_string(num_books - 1) + "/0"));
+    }
+  }
+
+  AND_GIVEN("a bookstore without filters") {
+    book_store.AddBook(Book("Title", "Content", Genre::HORROR, Publisher::USA, {king}));
+
+    THEN("checks must be answered by the indexes") {
+      REQUIRE(book_store.HasTitle("Title"));
+      REQUIRE_FALSE(book_store.HasTitle("Absent"));
+      REQUIRE(book_store.HasAuthor("S.King"));
+      REQUIRE_FALSE(book_store.HasAuthor("F.Kafka"));
+      REQUIRE(book_store.GetTitleFilterStats().num_queries == 2);
+      REQUIRE(book_store.GetTitleFilterStats().num_negatives == 0);
+    }
+  }
+}
@@ -0,0 +1,130 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "book_aggregate.hpp"
+#include "book_store.hpp"
+
+using namespace std;
+
+namespace {
+
+// агрегаты, пересчитанные полным проходом по живым книгам
+CatalogAggregate rescan(const BookStore &book_store) {
+  CatalogAggregate aggregate;
+
+  for (int index = 0; index < book_store.GetNumSlots(); index++) {
+    if (!book_store.IsRemoved(index)) {
+      aggregate.Add(book_store.GetBooks()[index]);
+    }
+  }
+
+  return aggregate;
+}
+
+// пользовательский агрегат: суммарная длина названий
+struct TitleLengthAggregate : BookAggregate {
+ public:
+  long long total_length{0};
+
+  void Add(const Book &book) override {
+    total_length += static_cast<long long>(book.GetTitle().size());
+  }
+
+  void Remove(const Book &book) override {
+    total_length -= static_cast<long long>(book.GetTitle().size());
+  }
+};
+
+}  // namespace
+
+SCENARIO("maintain catalog aggregates incrementally") {
+  auto book_store = BookStore("Aggregated Books");
+
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto rowling = Author("J.Rowling", 55, Sex::FEMALE);
+
+  GIVEN("an empty bookstore") {
+
+    THEN("all aggregates must be zero") {
+      REQUIRE(book_store.GetCatalogAggregate() == CatalogAggregate());
+    }
+  }
+
+  AND_GIVEN("a bookstore with books") {
+    const int num_books = 100;
+
+    for (int index = 0; index < num_books; index++) {
+      const auto genre = index % 3 == 0 ? Genre::HORROR : Genre::FANTASY;
+      book_store.AddBook(Book("Title #" + to_string(index), string(index + 1, 'x'), genre, Publisher::USA,
+                              {index % 2 == 0 ? king : rowling}));
+    }
+
+    const CatalogAggregate &aggregate = book_store.GetCatalogAggregate();
+
+    THEN("aggregates must match the full rescan") {
+      REQUIRE(aggregate == rescan(book_store));
+      REQUIRE(aggregate.num_books == num_books);
+      REQUIRE(aggregate.content_bytes == num_books * (num_books + 1) / 2);
+      REQUIRE(aggregate.GetCount(Genre::HORROR) == 34);
+      REQUIRE(aggregate.GetCount(Genre::FANTASY) == 66);
+      REQUIRE(aggregate.GetCount(Publisher::USA) == num_books);
+      REQUIRE(aggregate.GetCount(Sex::MALE) == 50);
+      REQUIRE(aggregate.GetCount(Sex::FEMALE) == 50);
+    }
+
+    WHEN("removing books") {
+      book_store.RemoveBook(0);
+      book_store.RemoveIf([](const Book &book) { return book.GetGenre() == Genre::HORROR; });
+
+      THEN("removed books must not be counted") {
+        REQUIRE(aggregate == rescan(book_store));
+        REQUIRE(aggregate.num_books == 66);
+        REQUIRE(aggregate.num_books == book_store.GetSize());
+        REQUIRE(aggregate.GetCount(Genre::HORROR) == 0);
+      }
+
+      AND_WHEN("compacting the storage") {
+        book_store.Compact();
+
+        THEN("aggregates must not change") {
+          REQUIRE(aggregate == rescan(book_store));
+          REQUIRE(aggregate.num_books == book_store.GetSize());
+        }
+      }
+    }
+
+    WHEN("adding an author to a book") {
+      REQUIRE(book_store.AddBookAuthor(1, king));
+      REQUIRE_FALSE(book_store.AddBookAuthor(1, king));
+
+      THEN("the author must be counted once") {
+        REQUIRE(aggregate == rescan(book_store));
+        REQUIRE(aggregate.GetCount(Sex::MALE) == 51);
+        REQUIRE(aggregate.num_books == num_books);
+      }
+    }
+
+    WHEN("registering a custom aggregate") {
+      const auto &title_length = book_store.RegisterAggregate<TitleLengthAggregate>();
+
+      long long expected_length = 0;
+      for (int index = 0; index < book_store.GetNumSlots(); index++) {
+        expected_length += static_cast<long long>(book_store.GetBooks()[index].GetTitle().size());
+      }
+
+      THEN("existing books must be counted") {
+        REQUIRE(title_length.total_length == expected_length);
+      }
+
+      AND_WHEN("adding and removing books") {
+        book_store.AddBook(Book("New title", "Content", Genre::DRAMA, Publisher::RUS, {rowling}));
+        book_store.RemoveBook(0);
+
+        THEN("the custom aggregate must be updated") {
+          REQUIRE(title_length.total_length == expected_length + 9 - 8);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "book_query.hpp"
+#include "book_store.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("query books using a lazy pipeline") {
+  auto book_store = BookStore("Queried Books");
+
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+  const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  book_store.AddBook(Book("Misery", "A writer and a fan", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("It", "A clown in the sewers", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Hobbit", "There and back again", Genre::FANTASY, Publisher::ENG, {tolkien}));
+  book_store.AddBook(Book("Harry Potter", "A boy who lived", Genre::FANTASY, Publisher::ENG, {rowling}));
+  book_store.AddBook(Book("The Shining", "A hotel and a clown", Genre::HORROR, Publisher::ENG, {king}));
+
+  GIVEN("a bookstore with books") {
+
+    WHEN("combining enum and content predicates") {
+      const vector<int> indices = BookQuery(book_store)
+          .WhereContentContains("clown")
+          .WhereGenre(Genre::HORROR)
+          .WherePublisher(Publisher::USA)
+          .Indices();
+
+      THEN("only books matching all predicates must be found") {
+        REQUIRE_THAT(indices, Equals(vector<int>{1}));
+      }
+    }
+
+    AND_WHEN("filtering by a set of enum values") {
+      const int count = BookQuery(book_store).WherePublisherIn({Publisher::USA, Publisher::ENG}).Count();
+      const int empty_count = BookQuery(book_store).WhereGenre(Genre::HORROR).WhereGenre(Genre::FANTASY).Count();
+
+      THEN("enum filters must combine as a set union within a call and intersection across calls") {
+        REQUIRE(count == 5);
+        REQUIRE(empty_count == 0);
+      }
+    }
+
+    AND_WHEN("limiting the number of results") {
+      int num_evaluated = 0;
+
+      const vector<string> titles = BookQuery(book_store)
+          .Where([&](const Book &) {
+            num_evaluated += 1;
+            return true;
+          })
+          .WhereAuthorOlderThan(50)
+          .Limit(2)
+          .Select([](const Book &book) { return book.GetTitle(); });
+
+      THEN("evaluation must stop after the limit is reached") {
+        REQUIRE_THAT(titles, Equals(vector<string>{"Misery", "It"}));
+        REQUIRE(num_evaluated == 2);
+      }
+    }
+
+    AND_WHEN("filtering by authors") {
+      THEN("books of matching authors must be found") {
+        REQUIRE_THAT(BookQuery(book_store).WhereAuthor("S.King").WhereTitleContains("The").Indices(),
+                     Equals(vector<int>{4}));
+        REQUIRE(BookQuery(book_store).WhereAuthorOlderThan(80).Count() == 1);
+        REQUIRE(BookQuery(book_store).Limit(0).Count() == 0);
+      }
+    }
+  }
+}
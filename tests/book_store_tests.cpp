@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -259,6 +260,37 @@ SCENARIO("add new books to the bookstore") {
         }
       }
     }
+
+    AND_WHEN("adding many books without reserving storage") {
+      const int num_books = 10'000;
+      int num_resizes = 0;
+
+      for (int index = 0; index < num_books; index++) {
+        const int capacity = book_store.GetCapacity();
+        REQUIRE(book_store.AddBook(Book{}) == ResizeStorageStatus::SUCCESS);
+        num_resizes += book_store.GetCapacity() != capacity ? 1 : 0;
+      }
+
+      THEN("storage must grow geometrically") {
+        REQUIRE(book_store.GetSize() == num_books);
+        REQUIRE(num_resizes < 25);
+        REQUIRE(book_store.GetCapacity() < 2 * num_books);
+      }
+    }
+  }
+
+  AND_GIVEN("a bookstore without storage") {
+    auto book_store = BookStore();
+
+    WHEN("adding a book") {
+      const ResizeStorageStatus status = book_store.AddBook(Book{});
+
+      THEN("the resize error must be returned and the book must not be added") {
+        REQUIRE(status == ResizeStorageStatus::NULL_STORAGE);
+        REQUIRE(book_store.GetSize() == 0);
+        REQUIRE(book_store.GetBooks() == nullptr);
+      }
+    }
   }
 }
 
@@ -281,3 +313,141 @@ SCENARIO("destruction of the bookstore instance") {
     }
   }
 }
+
+SCENARIO("bulk add book records to the bookstore") {
+
+  GIVEN("a batch of records with malformed rows") {
+    auto book_store = BookStore("Bulk Books");
+
+    const AuthorRecord author = {"S.King", 73, Sex::MALE};
+
+    const vector<BookRecord> records = {
+        {"It", "Content", Genre::HORROR, Publisher::USA, {author}},
+        {"", "Content", Genre::HORROR, Publisher::USA, {author}},
+        {"Misery", "Content", Genre::HORROR, Publisher::USA, {{"", 73, Sex::MALE}}},
+        {"Carrie", "Content", Genre::HORROR, Publisher::USA, {author}},
+        {"Empty", "Content", Genre::HORROR, Publisher::USA, {}},
+    };
+
+    WHEN("adding records in bulk") {
+      BulkAddReport report;
+      REQUIRE_NOTHROW(report = book_store.AddBooks(records));
+
+      THEN("valid records must be added and malformed ones rejected") {
+        REQUIRE(report.num_added == 2);
+        REQUIRE(book_store.GetSize() == 2);
+        REQUIRE_THAT(book_store.GetBooks()[1].GetTitle(), Equals("Carrie"));
+
+        REQUIRE(report.rejected.size() == 3);
+        REQUIRE(report.rejected[0].row == 1);
+        REQUIRE(report.rejected[0].status == ValidationStatus::EMPTY_TITLE);
+        REQUIRE(report.rejected[1].row == 2);
+        REQUIRE(report.rejected[1].status == ValidationStatus::EMPTY_FULL_NAME);
+        REQUIRE(report.rejected[2].row == 4);
+        REQUIRE(report.rejected[2].status == ValidationStatus::EMPTY_AUTHORS);
+      }
+    }
+  }
+}
+
+SCENARIO("remove books from the bookstore and compact storage") {
+
+  GIVEN("a bookstore with books of several authors") {
+    auto book_store = BookStore("Removed Books");
+
+    const auto king = Author("S.King", 73, Sex::MALE);
+    const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+
+    const int num_books = 100;
+    book_store.Reserve(2 * num_books);
+
+    const auto &genre_publisher_pairs = book_store.RegisterAggregate<GenrePublisherAggregate>();
+
+    for (int index = 0; index < num_books; index++) {
+      const auto &author = index % 2 == 0 ? king : rowling;
+      book_store.AddBook(Book("Title #" + to_string(index), "Content", Genre::HORROR, Publisher::USA, {author}));
+    }
+
+    WHEN("removing every book by S.King") {
+      const int num_removed = book_store.RemoveIf([](const Book &book) {
+        return book.GetAuthors().front().GetFullName() == "S.King";
+      });
+
+      THEN("books must be hidden without moving the rest") {
+        REQUIRE(num_removed == num_books / 2);
+        REQUIRE(book_store.GetSize() == num_books / 2);
+        REQUIRE(book_store.GetNumSlots() == num_books);
+        REQUIRE(book_store.GetSize() == book_store.GetCatalogAggregate().num_books);
+        REQUIRE(book_store.GetNumRemoved() == num_books / 2);
+        REQUIRE(book_store.IsRemoved(0));
+        REQUIRE_FALSE(book_store.IsRemoved(1));
+        REQUIRE_FALSE(book_store.RemoveBook(0));
+
+        REQUIRE(book_store.FindBooksByAuthor("S.King").empty());
+        REQUIRE(book_store.FindBooksByAuthor("J.K.Rowling").size() == num_books / 2);
+        REQUIRE(book_store.FindBooksByAuthorAge(70, 80).empty());
+        REQUIRE(book_store.FindBooksByTitleRange("Title #0", "Title #1").empty());
+        REQUIRE(book_store.TopAuthorsByBookCount(5).size() == 1);
+        REQUIRE(genre_publisher_pairs.Top(1).front().count == num_books / 2);
+      }
+
+      AND_WHEN("compacting storage in bounded steps") {
+        const int capacity = book_store.GetCapacity();
+        int num_steps = 0;
+
+        // шаг без позиций не продвигал бы уплотнение
+        REQUIRE_THROWS_AS(book_store.CompactStep(0), invalid_argument);
+
+        while (book_store.CompactStep(10)) {
+          num_steps += 1;
+
+          // между шагами поиск остается корректным
+          for (int position: book_store.FindBooksByAuthor("J.K.Rowling")) {
+            REQUIRE_FALSE(book_store.IsRemoved(position));
+            REQUIRE(book_store.GetBooks()[position].GetAuthors().front() == rowling);
+          }
+        }
+
+        THEN("slots must be reclaimed and capacity must shrink") {
+          REQUIRE(num_steps > 1);
+          REQUIRE(book_store.GetCompactionPhase() == CompactionPhase::IDLE);
+          REQUIRE(book_store.GetSize() == num_books / 2);
+          REQUIRE(book_store.GetNumSlots() == num_books / 2);
+          REQUIRE(book_store.GetNumRemoved() == 0);
+          REQUIRE(book_store.GetCapacity() < capacity);
+
+          // порядок оставшихся книг сохраняется
+          REQUIRE_THAT(book_store.GetBooks()[0].GetTitle(), Equals("Title #1"));
+          REQUIRE_THAT(book_store.GetBooks()[1].GetTitle(), Equals("Title #3"));
+
+          const vector<int> positions = book_store.FindBooksByAuthor("J.K.Rowling");
+          REQUIRE(positions.size() == num_books / 2);
+          REQUIRE(positions.front() == 0);
+          REQUIRE(positions.back() == num_books / 2 - 1);
+        }
+      }
+
+      AND_WHEN("adding and removing books during compaction") {
+        book_store.CompactStep(10);
+        book_store.RemoveBook(99);
+        book_store.AddBook(Book("Carrie", "Content", Genre::HORROR, Publisher::USA, {king}));
+        book_store.Compact();
+
+        THEN("the store must reflect all changes") {
+          REQUIRE(book_store.GetNumRemoved() == 0);
+          REQUIRE(book_store.GetSize() == num_books / 2);
+          REQUIRE_THAT(book_store.GetBooks()[book_store.GetSize() - 1].GetTitle(), Equals("Carrie"));
+          REQUIRE(book_store.FindBooksByAuthor("S.King") == vector<int>{book_store.GetSize() - 1});
+          REQUIRE(book_store.FindBooksByTitlePrefix("Title #99", 0, 10).empty());
+        }
+      }
+    }
+
+    AND_WHEN("removing a book out of range") {
+      THEN("an exception must be thrown") {
+        REQUIRE_THROWS_AS(book_store.RemoveBook(num_books), invalid_argument);
+        REQUIRE_THROWS_AS(book_store.RemoveBook(-1), invalid_argument);
+      }
+    }
+  }
+}
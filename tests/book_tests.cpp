@@ -42,7 +42,7 @@ SCENARIO("create book using non-default constructor") {
         REQUIRE(book.GetPublisher() == publisher);
         REQUIRE_THAT(book.GetTitle(), Equals(title));
         REQUIRE_THAT(book.GetContent(), Equals(content));
-        REQUIRE_THAT(book.GetAuthors(), Equals(authors));
+        REQUIRE(book.GetAuthors() == AuthorList(authors.begin(), authors.end()));
       }
     }
   }
@@ -119,7 +119,7 @@ SCENARIO("add author to the existing book") {
         REQUIRE(status == true);
 
         const std::vector<Author> expected_authors = {author, author_other};
-        REQUIRE_THAT(expected_authors, Equals(book.GetAuthors()));
+        REQUIRE(book.GetAuthors() == AuthorList(expected_authors.begin(), expected_authors.end()));
       }
     }
 
@@ -130,7 +130,7 @@ SCENARIO("add author to the existing book") {
         REQUIRE_FALSE(status);
 
         const std::vector<Author> expected_authors = {author};
-        REQUIRE_THAT(expected_authors, Equals(book.GetAuthors()));
+        REQUIRE(book.GetAuthors() == AuthorList(expected_authors.begin(), expected_authors.end()));
       }
     }
   }
@@ -233,3 +233,110 @@ SCENARIO("compare books using operator ==") {
     }
   }
 }
+
+SCENARIO("create book without exceptions") {
+  const auto author = Author("J.K. Rowling", Author::kMinAuthorAge, Sex::FEMALE);
+
+  GIVEN("valid factory arguments") {
+    const auto result = Book::TryCreate("Harry Potter", "Contents", Genre::FANTASY, Publisher::USA, {author});
+
+    THEN("the book must be created") {
+      REQUIRE(result.IsOk());
+      REQUIRE(result.value == Book("Harry Potter", "Contents", Genre::FANTASY, Publisher::USA, {author}));
+    }
+  }
+
+  AND_GIVEN("invalid factory arguments") {
+    THEN("an error status must be returned") {
+      REQUIRE(Book::TryCreate("", "Contents", Genre::FANTASY, Publisher::USA, {author}).status
+                  == ValidationStatus::EMPTY_TITLE);
+      REQUIRE(Book::TryCreate("Title", "", Genre::FANTASY, Publisher::USA, {author}).status
+                  == ValidationStatus::EMPTY_CONTENT);
+      REQUIRE(Book::TryCreate("Title", "Contents", Genre::FANTASY, Publisher::USA, {}).status
+                  == ValidationStatus::EMPTY_AUTHORS);
+    }
+  }
+
+  AND_GIVEN("raw book records") {
+    const auto valid = BookRecord{"Title", "Contents", Genre::DRAMA, Publisher::RUS, {{"A. Chekhov", 44, Sex::MALE}}};
+    const auto invalid = BookRecord{"Title", "Contents", Genre::DRAMA, Publisher::RUS, {{"A. Chekhov", 1, Sex::MALE}}};
+
+    THEN("records must be validated including their authors") {
+      const auto result = Book::TryCreate(valid);
+
+      REQUIRE(result.IsOk());
+      REQUIRE(result.value.GetAuthors().size() == 1);
+      REQUIRE(result.value.GetAuthors().front() == Author("A. Chekhov", 44, Sex::MALE));
+      REQUIRE(Book::TryCreate(invalid).status == ValidationStatus::AUTHOR_TOO_YOUNG);
+    }
+  }
+
+  AND_GIVEN("stored fields of a book") {
+    THEN("a valid book must be restored as created") {
+      REQUIRE(Book::Restore("Harry Potter", "Contents", Genre::FANTASY, Publisher::USA, {author})
+                  == Book("Harry Potter", "Contents", Genre::FANTASY, Publisher::USA, {author}));
+    }
+
+    AND_THEN("invalid fields must be left at their defaults") {
+      const auto restored = Book::Restore("", "Contents", Genre::DRAMA, Publisher::RUS, {Author::Restore("", 0, Sex::MALE)});
+
+      REQUIRE(restored.GetTitle().empty());
+      REQUIRE_THAT(restored.GetContent(), Equals("Contents"));
+      REQUIRE(restored.GetGenre() == Genre::DRAMA);
+      REQUIRE(restored.GetAuthors().size() == 1);
+      REQUIRE(restored.GetAuthors().front() == Author::Restore("", 0, Sex::MALE));
+      REQUIRE(Book::Restore("", "", Genre::UNDEFINED, Publisher::UNDEFINED, {}) == Book{});
+    }
+  }
+}
+
+SCENARIO("copy books with shared payloads") {
+  const auto author = Author("J.K. Rowling", Author::kMinAuthorAge, Sex::FEMALE);
+  const auto original = Book("Harry Potter", string(100000, 'x'), Genre::FANTASY, Publisher::USA, {author});
+
+  GIVEN("a copy of a book") {
+    auto copy = original;
+
+    THEN("copies must share their buffers") {
+      REQUIRE(copy == original);
+      REQUIRE(&copy.GetContent() == &original.GetContent());
+      REQUIRE(&copy.GetTitle() == &original.GetTitle());
+      REQUIRE(copy.GetAuthors() == original.GetAuthors());
+      REQUIRE(copy.GetAuthors().IsInline());
+    }
+
+    WHEN("changing the title of the copy") {
+      copy.SetTitle("Harry Potter 2");
+
+      THEN("only the title must be detached") {
+        REQUIRE_THAT(original.GetTitle(), Equals("Harry Potter"));
+        REQUIRE_THAT(copy.GetTitle(), Equals("Harry Potter 2"));
+        REQUIRE(&copy.GetContent() == &original.GetContent());
+        REQUIRE(copy != original);
+      }
+    }
+
+    AND_WHEN("adding an author to the copy") {
+      auto other = author;
+      other.SetFullName("Noname");
+      copy.AddAuthor(other);
+
+      THEN("the original author list must stay the same") {
+        REQUIRE(original.GetAuthors().size() == 1);
+        REQUIRE(copy.GetAuthors().size() == 2);
+        REQUIRE(&copy.GetContent() == &original.GetContent());
+      }
+    }
+
+    AND_WHEN("changing the content of a book that is not shared") {
+      auto unique = Book("Title", "Content", Genre::FANTASY, Publisher::USA, {author});
+      const string *buffer = &unique.GetContent();
+      unique.SetContent("New content");
+
+      THEN("the buffer must be reused") {
+        REQUIRE(&unique.GetContent() == buffer);
+        REQUIRE_THAT(unique.GetContent(), Equals("New content"));
+      }
+    }
+  }
+}
@@ -0,0 +1,54 @@
+#include <catch2/catch.hpp>
+
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.hpp"
+
+using namespace std;
+
+SCENARIO("pass items through a bounded queue") {
+
+  GIVEN("several producers and consumers") {
+    const int num_producers = GENERATE(1, 4);
+    const int num_consumers = GENERATE(1, 3);
+    const int num_items = 1000;
+
+    auto queue = BoundedQueue<int>(8);
+    vector<long long> sums(num_consumers, 0);
+
+    WHEN("producers push items and close the queue") {
+      vector<thread> consumers;
+      for (int consumer = 0; consumer < num_consumers; consumer++) {
+        consumers.emplace_back([&, consumer] {
+          for (int value; queue.Pop(value); /* ... */) {
+            sums[consumer] += value;
+          }
+        });
+      }
+
+      vector<thread> producers;
+      for (int producer = 0; producer < num_producers; producer++) {
+        producers.emplace_back([&] {
+          for (int value = 1; value <= num_items; value++) {
+            queue.Push(value);
+          }
+        });
+      }
+
+      for (auto &producer: producers) producer.join();
+      queue.Close();
+      for (auto &consumer: consumers) consumer.join();
+
+      THEN("every item must be consumed exactly once") {
+        const long long expected = static_cast<long long>(num_producers) * num_items * (num_items + 1) / 2;
+        REQUIRE(accumulate(sums.begin(), sums.end(), 0LL) == expected);
+      }
+
+      AND_THEN("closed queue must reject new items") {
+        REQUIRE_FALSE(queue.Push(42));
+      }
+    }
+  }
+}
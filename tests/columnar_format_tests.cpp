@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "book_store.hpp"
+#include "columnar_format.hpp"
+
+using namespace std;
+
+SCENARIO("export and import the bookstore in the columnar format") {
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto straub = Author("P.Straub", 79, Sex::MALE);
+
+  auto book_store = BookStore("Columnar Books");
+
+  // книга по умолчанию (с пустыми полями) тоже должна переноситься без изменений
+  book_store.AddBook(Book{});
+  for (int index = 0; index < 10; index++) {
+    book_store.AddBook(Book("Title #" + to_string(index), string(index + 1, 'c'), static_cast<Genre>(index % 12),
+                            static_cast<Publisher>(index % 4), {king}));
+  }
+  book_store.AddBook(Book("The Talisman", "Content", Genre::FANTASY, Publisher::USA, {king, straub}));
+
+  GIVEN("a bookstore exported in small batches") {
+    stringstream stream;
+    REQUIRE(export_columnar(book_store, stream, 3) == ColumnarStatus::SUCCESS);
+
+    WHEN("importing it into an empty bookstore") {
+      auto restored = BookStore("Columnar Books");
+      int num_imported = 0;
+
+      REQUIRE(import_columnar(stream, restored, &num_imported) == ColumnarStatus::SUCCESS);
+
+      THEN("the restored bookstore must be equal to the original one") {
+        REQUIRE(num_imported == book_store.GetSize());
+        REQUIRE(restored == book_store);
+        REQUIRE(restored.FindBooksByAuthor("P.Straub") == vector<int>{11});
+      }
+    }
+
+    AND_WHEN("reading the batches directly") {
+      REQUIRE(read_columnar_header(stream) == ColumnarStatus::SUCCESS);
+
+      RecordBatch batch;
+      vector<int> batch_sizes;
+
+      while (read_record_batch(stream, batch) == ColumnarStatus::SUCCESS && batch.num_rows > 0) {
+        batch_sizes.push_back(batch.num_rows);
+      }
+
+      THEN("the columns must be split into batches of the requested size") {
+        REQUIRE(batch_sizes == vector<int>{3, 3, 3, 3});
+        REQUIRE(batch.num_rows == 0);
+      }
+    }
+
+    AND_WHEN("the stream is truncated") {
+      string data = stream.str();
+      data.resize(data.size() - 10);
+
+      istringstream truncated(data);
+      auto restored = BookStore("Columnar Books");
+      int num_imported = 0;
+
+      THEN("complete batches must be imported and the error must be reported") {
+        REQUIRE(import_columnar(truncated, restored, &num_imported) == ColumnarStatus::READ_FAILED);
+        REQUIRE(num_imported == 9);
+      }
+    }
+  }
+
+  AND_GIVEN("a bookstore with removed books") {
+    book_store.RemoveBook(0);
+    book_store.RemoveBook(5);
+
+    stringstream stream;
+    REQUIRE(export_columnar(book_store, stream) == ColumnarStatus::SUCCESS);
+
+    THEN("only live books must be exported") {
+      auto restored = BookStore("Columnar Books");
+      int num_imported = 0;
+
+      REQUIRE(import_columnar(stream, restored, &num_imported) == ColumnarStatus::SUCCESS);
+      REQUIRE(num_imported == book_store.GetSize());
+      REQUIRE(num_imported == book_store.GetNumSlots() - 2);
+      REQUIRE(restored == book_store);
+    }
+  }
+}
+
+SCENARIO("validate record batches") {
+
+  GIVEN("a batch with a single book") {
+    RecordBatch batch;
+    batch.Append(Book("Misery", "Content", Genre::HORROR, Publisher::USA, {Author("S.King", 73, Sex::MALE)}));
+
+    THEN("the batch must be valid and expose its fields") {
+      REQUIRE(batch.Validate());
+      REQUIRE(batch.GetTitle(0) == "Misery");
+      REQUIRE(batch.GetAuthorName(0) == "S.King");
+    }
+
+    WHEN("corrupting the offsets") {
+      batch.title_offsets.back() += 1;
+
+      THEN("the batch must be invalid") {
+        REQUIRE_FALSE(batch.Validate());
+      }
+    }
+
+    AND_WHEN("corrupting an enumeration value") {
+      batch.genres[0] = 200;
+
+      THEN("the batch must be invalid") {
+        REQUIRE_FALSE(batch.Validate());
+      }
+    }
+
+    AND_WHEN("writing a corrupted batch to a stream") {
+      batch.author_sexes[0] = 7;
+
+      stringstream stream;
+      REQUIRE(write_columnar_header(stream) == ColumnarStatus::SUCCESS);
+      REQUIRE(write_record_batch(batch, stream) == ColumnarStatus::SUCCESS);
+
+      THEN("the import must reject it") {
+        auto restored = BookStore("Columnar Books");
+        REQUIRE(import_columnar(stream, restored) == ColumnarStatus::CORRUPTED_BATCH);
+        REQUIRE(restored.GetSize() == 0);
+      }
+    }
+  }
+
+  AND_GIVEN("a stream without the signature") {
+    istringstream stream("not a columnar stream");
+    auto restored = BookStore("Columnar Books");
+
+    THEN("the import must fail") {
+      REQUIRE(import_columnar(stream, restored) == ColumnarStatus::READ_FAILED);
+    }
+  }
+}
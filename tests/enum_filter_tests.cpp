@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "book_query.hpp"
+#include "book_store.hpp"
+#include "enum_filter.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("filter books using compile-time enum kernels") {
+
+  GIVEN("a bookstore with books of every genre and publisher") {
+    auto book_store = BookStore("Filtered Books");
+    const auto author = Author("S.King", 73, Sex::MALE);
+
+    for (int genre = 0; genre <= static_cast<int>(Genre::UNDEFINED); genre++) {
+      for (int publisher = 0; publisher <= static_cast<int>(Publisher::UNDEFINED); publisher++) {
+        book_store.AddBook(Book("Title", "Content", static_cast<Genre>(genre), static_cast<Publisher>(publisher), {author}));
+      }
+    }
+
+    WHEN("filtering by genre and publisher masks") {
+      using Kernel = EnumFilterKernel<enum_mask_v<Genre::HORROR, Genre::THRILLER>, enum_mask_v<Publisher::USA>>;
+
+      const vector<int> expected = BookQuery(book_store)
+          .WhereGenreIn({Genre::HORROR, Genre::THRILLER})
+          .WherePublisher(Publisher::USA)
+          .Indices();
+
+      THEN("results must match the runtime query") {
+        REQUIRE(Kernel::Count(book_store) == 2);
+        REQUIRE_THAT(Kernel::Collect(book_store), Equals(expected));
+      }
+    }
+
+    AND_WHEN("filtering by genre only") {
+      using Kernel = EnumFilterKernel<enum_mask_v<Genre::UNDEFINED>>;
+
+      THEN("any publisher must pass") {
+        REQUIRE(Kernel::Count(book_store) == static_cast<int>(Publisher::UNDEFINED) + 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,70 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "enum_names.hpp"
+
+using namespace std;
+
+SCENARIO("convert enumerations to text and back") {
+
+  GIVEN("every value of the enumerations") {
+
+    THEN("formatted names must be parsed back to the same values") {
+      for (int index = 0; index <= static_cast<int>(Genre::UNDEFINED); index++) {
+        auto genre = Genre::UNDEFINED;
+        REQUIRE(parse_enum(format_enum(static_cast<Genre>(index)), genre));
+        REQUIRE(genre == static_cast<Genre>(index));
+      }
+
+      for (int index = 0; index <= static_cast<int>(Publisher::UNDEFINED); index++) {
+        auto publisher = Publisher::UNDEFINED;
+        REQUIRE(parse_enum(format_enum(static_cast<Publisher>(index)), publisher));
+        REQUIRE(publisher == static_cast<Publisher>(index));
+      }
+
+      for (int index = 0; index <= static_cast<int>(Sex::UNDEFINED); index++) {
+        auto sex = Sex::UNDEFINED;
+        REQUIRE(parse_enum(format_enum(static_cast<Sex>(index)), sex));
+        REQUIRE(sex == static_cast<Sex>(index));
+      }
+    }
+
+    AND_THEN("values out of the enumerations must be formatted as empty names") {
+      REQUIRE(format_enum(static_cast<Genre>(100)).empty());
+      REQUIRE(format_enum(static_cast<Sex>(-1)).empty());
+    }
+  }
+
+  AND_GIVEN("names in different letter cases") {
+    const string name = GENERATE(as<string>{}, "action_and_adventure", "Action_And_Adventure", "ACTION_AND_ADVENTURE");
+
+    THEN("the names must be parsed case-insensitively") {
+      auto genre = Genre::UNDEFINED;
+
+      REQUIRE(parse_enum(name, genre));
+      REQUIRE(genre == Genre::ACTION_AND_ADVENTURE);
+    }
+  }
+
+  AND_GIVEN("unknown names") {
+    const string name = GENERATE(as<string>{}, "", "SCIFI", "SCI_FI_", "HORRO", "thriller ", "romance\n", "ADULT?");
+
+    THEN("the names must be rejected without changing the value") {
+      auto genre = Genre::DRAMA;
+
+      REQUIRE_FALSE(parse_enum(name, genre));
+      REQUIRE(genre == Genre::DRAMA);
+    }
+
+    AND_THEN("names of other enumerations must be rejected as well") {
+      auto publisher = Publisher::USA;
+      auto sex = Sex::MALE;
+
+      REQUIRE_FALSE(parse_enum("HORROR", publisher));
+      REQUIRE_FALSE(parse_enum("RUS", sex));
+      REQUIRE(publisher == Publisher::USA);
+      REQUIRE(sex == Sex::MALE);
+    }
+  }
+}
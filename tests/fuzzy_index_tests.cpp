@@ -0,0 +1,194 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "book_store.hpp"
+#include "fuzzy_index.hpp"
+
+using namespace std;
+
+namespace {
+
+// расстояние Левенштейна полным перебором матрицы (эталон для проверки)
+int reference_distance(const string &lhs, const string &rhs) {
+  vector<vector<int>> matrix(lhs.size() + 1, vector<int>(rhs.size() + 1));
+
+  for (size_t row = 0; row <= lhs.size(); row++) matrix[row][0] = static_cast<int>(row);
+  for (size_t column = 0; column <= rhs.size(); column++) matrix[0][column] = static_cast<int>(column);
+
+  for (size_t row = 1; row <= lhs.size(); row++) {
+    for (size_t column = 1; column <= rhs.size(); column++) {
+      matrix[row][column] = min({matrix[row - 1][column - 1] + (lhs[row - 1] != rhs[column - 1]),
+                                 matrix[row - 1][column] + 1, matrix[row][column - 1] + 1});
+    }
+  }
+
+  return matrix[lhs.size()][rhs.size()];
+}
+
+}  // namespace
+
+SCENARIO("compute edit distance") {
+
+  GIVEN("well-known pairs of strings") {
+    THEN("distance must be computed case-insensitively") {
+      REQUIRE(edit_distance("kitten", "sitting", 10) == 3);
+      REQUIRE(edit_distance("J.Tolkein", "J.Tolkien", 10) == 2);
+      REQUIRE(edit_distance("Misery", "MISERY", 10) == 0);
+      REQUIRE(edit_distance("", "abc", 10) == 3);
+    }
+
+    AND_THEN("distance above the maximum must be cut off") {
+      REQUIRE(edit_distance("kitten", "sitting", 2) == 3);
+      REQUIRE(edit_distance("a", "abcdef", 1) == 2);
+    }
+  }
+
+  AND_GIVEN("pseudo-random strings of different lengths") {
+    const int length = GENERATE(1, 10, 63, 64, 65, 100);
+    CAPTURE(length);
+
+    unsigned state = 12345u + length;
+    const auto next = [&state] {
+      state = state * 1103515245u + 12345u;
+      return static_cast<char>('a' + (state >> 16) % 4);
+    };
+
+    for (int round = 0; round < 20; round++) {
+      string lhs;
+      string rhs;
+      for (int index = 0; index < length; index++) lhs += next();
+      for (int index = 0; index < length + round % 5 - 2; index++) rhs += next();
+
+      const int expected = reference_distance(lhs, rhs);
+
+      THEN("bit-parallel and dynamic distances must match the reference") {
+        REQUIRE(edit_distance(lhs, rhs, 1000) == expected);
+        REQUIRE(edit_distance(lhs, rhs, expected) == expected);
+        REQUIRE(edit_distance(lhs, rhs, expected - 1) == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("fuzzy search over a dictionary") {
+
+  GIVEN("a dictionary with similar words") {
+    auto index = FuzzyIndex();
+
+    for (const string word: {"hobbit", "habit", "rabbit", "orbit", "hobbit"}) {
+      index.Insert(word);
+    }
+
+    WHEN("searching a mistyped word") {
+      const auto matches = index.Search("hobit", 2);
+
+      THEN("words must be ranked by distance, then lexicographically") {
+        REQUIRE(index.GetSize() == 4);
+        REQUIRE(matches.size() == 3);  // rabbit - на расстоянии 3
+        REQUIRE(*matches[0].text == "habit");
+        REQUIRE(*matches[1].text == "hobbit");
+        REQUIRE(matches[1].distance == 1);
+        REQUIRE(*matches[2].text == "orbit");
+        REQUIRE(matches[2].distance == 2);
+      }
+    }
+
+    AND_WHEN("the same query is repeated more times than the counter generations") {
+      // счетчики предыдущих запросов не должны влиять на отбор кандидатов
+      bool is_stable = true;
+
+      for (int query = 0; query < 1000; query++) {
+        is_stable = is_stable && index.Search("hobit", 1).size() == 2 && index.Search("orbit", 0).size() == 1;
+      }
+
+      THEN("the results must not change") {
+        REQUIRE(is_stable);
+      }
+    }
+  }
+
+  AND_GIVEN("a string with more trigrams than a counter can hold") {
+    auto index = FuzzyIndex();
+    string text;
+
+    for (int symbol = 0; symbol < 600; symbol++) {
+      text += static_cast<char>('a' + symbol % 26);
+      text += static_cast<char>('0' + symbol / 26 % 10);
+    }
+    index.Insert(text);
+    index.Insert("unrelated");
+
+    WHEN("searching it with a typo") {
+      string query = text;
+      query[300] = '#';
+      const auto matches = index.Search(query, 1);
+
+      THEN("it must still be found") {
+        REQUIRE(matches.size() == 1);
+        REQUIRE(*matches[0].text == text);
+        REQUIRE(matches[0].distance == 1);
+      }
+    }
+  }
+}
+
+SCENARIO("fuzzy search over the bookstore") {
+  auto book_store = BookStore("Fuzzy Books");
+
+  const auto dick = Author("P.K.Dick", 53, Sex::MALE);
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+  const auto tolstoy = Author("L.Tolstoy", 82, Sex::MALE);
+
+  book_store.AddBook(Book("Do Androids Dream of Electric Sheep?", "Content", Genre::SCI_FI, Publisher::USA, {dick}));
+  book_store.AddBook(Book("Ubik", "Content", Genre::SCI_FI, Publisher::USA, {dick}));
+  book_store.AddBook(Book("Hobbit", "Content", Genre::FANTASY, Publisher::ENG, {tolkien}));
+  book_store.AddBook(Book("Hobbit", "Content", Genre::FANTASY, Publisher::ENG, {tolkien}));
+  book_store.AddBook(Book("War and Peace", "Content", Genre::CLASSIC, Publisher::RUS, {tolstoy}));
+
+  GIVEN("queries with typos") {
+
+    WHEN("searching books by a mistyped title") {
+      const auto matches = book_store.FindBooksByFuzzyTitle("Do Andriods Dream of Electric Sheep?", 2, 10);
+
+      THEN("the book must be found with its distance") {
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].position == 0);
+        REQUIRE(matches[0].distance == 2);
+      }
+    }
+
+    AND_WHEN("searching books by a short mistyped title") {
+      const auto matches = book_store.FindBooksByFuzzyTitle("hobit", 1, 10);
+
+      THEN("all books with the title must be found in storage order") {
+        REQUIRE(matches.size() == 2);
+        REQUIRE(matches[0].position == 2);
+        REQUIRE(matches[1].position == 3);
+        REQUIRE(book_store.FindBooksByFuzzyTitle("hobit", 1, 1).size() == 1);
+        REQUIRE(book_store.FindBooksByFuzzyTitle("hobit", 0, 10).empty());
+      }
+    }
+
+    AND_WHEN("searching authors by a mistyped name") {
+      const auto matches = book_store.FindAuthorsByFuzzyName("J.Tolkein", 2, 10);
+
+      THEN("the author must be found with its distance") {
+        REQUIRE(matches.size() == 1);
+        REQUIRE(matches[0].full_name == "J.Tolkien");
+        REQUIRE(matches[0].distance == 2);
+      }
+    }
+
+    AND_WHEN("all books of an author are removed") {
+      book_store.RemoveBook(4);
+
+      THEN("the author must not be found") {
+        REQUIRE(book_store.FindAuthorsByFuzzyName("L.Tolstoj", 1, 10).empty());
+        REQUIRE(book_store.FindBooksByFuzzyTitle("War and Peace", 0, 10).empty());
+      }
+    }
+  }
+}
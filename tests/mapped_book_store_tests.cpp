@@ -0,0 +1,120 @@
+#include <catch2/catch.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "mapped_book_store.hpp"
+
+using namespace std;
+
+namespace {
+
+Book make_book(int index) {
+  return Book("Title #" + to_string(index), string(1 + index % 300, 'c'), Genre::FANTASY, Publisher::ENG,
+              {Author("Author #" + to_string(index % 7), 20 + index % 50, Sex::FEMALE)});
+}
+
+}  // namespace
+
+SCENARIO("store books in memory-mapped files") {
+  const auto path = (filesystem::temp_directory_path() / "bookstore_mapped_tests.db").string();
+  filesystem::remove(path);
+  filesystem::remove(path + ".heap");
+
+  GIVEN("a closed store") {
+    auto store = MappedBookStore();
+    Book book;
+
+    THEN("operations must fail") {
+      REQUIRE(store.AddBook(make_book(0)) == MappedStatus::NOT_OPEN);
+      REQUIRE(store.GetBook(0, book) == MappedStatus::NOT_OPEN);
+      REQUIRE(store.Sync() == MappedStatus::NOT_OPEN);
+    }
+  }
+
+  AND_GIVEN("a store with more books than its initial capacity") {
+    const int num_books = 3 * MappedBookStore::kInitCapacity;
+
+    auto store = MappedBookStore();
+    REQUIRE(store.Open(path) == MappedStatus::SUCCESS);
+
+    // книга по умолчанию (с пустыми полями) тоже должна храниться без изменений
+    REQUIRE(store.AddBook(Book{}) == MappedStatus::SUCCESS);
+
+    for (int index = 1; index < num_books; index++) {
+      REQUIRE(store.AddBook(make_book(index)) == MappedStatus::SUCCESS);
+    }
+
+    THEN("files must grow geometrically") {
+      REQUIRE(store.GetSize() == num_books);
+      REQUIRE(store.GetCapacity() >= num_books);
+      REQUIRE(store.GetCapacity() < 2 * num_books);
+      REQUIRE(store.GetHeapSize() <= store.GetHeapCapacity());
+    }
+
+    AND_THEN("books must be read back unchanged") {
+      Book book;
+
+      REQUIRE(store.GetBook(0, book) == MappedStatus::SUCCESS);
+      REQUIRE(book == Book{});
+
+      for (int index = 1; index < num_books; index++) {
+        REQUIRE(store.GetBook(index, book) == MappedStatus::SUCCESS);
+        REQUIRE(book == make_book(index));
+        REQUIRE(store.GetTitle(index) == "Title #" + to_string(index));
+      }
+    }
+
+    AND_THEN("out of range indices must be rejected") {
+      Book book;
+
+      REQUIRE_THROWS_AS(store.GetBook(-1, book), invalid_argument);
+      REQUIRE_THROWS_AS(store.GetTitle(num_books), invalid_argument);
+    }
+
+    WHEN("the store is synced, closed and reopened") {
+      REQUIRE(store.Sync() == MappedStatus::SUCCESS);
+      store.Close();
+
+      auto reopened = MappedBookStore();
+      REQUIRE(reopened.Open(path) == MappedStatus::SUCCESS);
+
+      THEN("all books must be restored") {
+        Book book;
+
+        REQUIRE(reopened.GetSize() == num_books);
+        REQUIRE(reopened.GetBook(num_books - 1, book) == MappedStatus::SUCCESS);
+        REQUIRE(book == make_book(num_books - 1));
+      }
+
+      AND_WHEN("adding more books") {
+        REQUIRE(reopened.AddBook(make_book(num_books)) == MappedStatus::SUCCESS);
+
+        THEN("they must be appended after the restored ones") {
+          REQUIRE(reopened.GetSize() == num_books + 1);
+          REQUIRE(reopened.GetTitle(num_books) == "Title #" + to_string(num_books));
+          REQUIRE(reopened.GetTitle(1) == "Title #1");
+        }
+      }
+    }
+  }
+
+  AND_GIVEN("a file that is not a store") {
+    {
+      auto fs = ofstream(path, ios::binary);
+      fs << "definitely not a book store header";
+    }
+
+    auto store = MappedBookStore();
+
+    THEN("it must not be opened") {
+      REQUIRE(store.Open(path) == MappedStatus::CORRUPTED_FILE);
+      REQUIRE_FALSE(store.IsOpen());
+    }
+  }
+
+  filesystem::remove(path);
+  filesystem::remove(path + ".heap");
+}
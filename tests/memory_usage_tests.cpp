@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+
+#include "book_store.hpp"
+#include "memory_usage.hpp"
+
+using namespace std;
+
+SCENARIO("account memory of strings") {
+
+  GIVEN("a short and a long string") {
+    const string short_string = "Misery";
+    const string long_string(1000, 'a');
+
+    WHEN("accounting their memory") {
+      MemoryBreakdown usage;
+      account_string(short_string, usage);
+      account_string(long_string, usage);
+
+      THEN("short string must be inline and long string must be on the heap") {
+        REQUIRE(usage.string_inline_bytes == short_string.size());
+        REQUIRE(usage.string_heap_bytes == long_string.size() + 1);
+        REQUIRE(usage.string_slack_bytes == long_string.capacity() - long_string.size());
+        REQUIRE(usage.GetTotal() == usage.string_heap_bytes + usage.string_slack_bytes);
+      }
+    }
+  }
+}
+
+SCENARIO("account memory of the bookstore") {
+
+  GIVEN("an empty bookstore") {
+    auto book_store = BookStore("Accounted Books");
+
+    THEN("only the slot array must be accounted") {
+      const MemoryBreakdown usage = book_store.MemoryUsage();
+      REQUIRE(usage.slot_bytes == 0);
+      REQUIRE(usage.slot_slack_bytes == BookStore::kInitStorageCapacity * sizeof(Book));
+      REQUIRE(usage.GetTotal() == usage.slot_slack_bytes);
+      REQUIRE(book_store.GetMemoryUsage() == usage);
+    }
+
+    AND_WHEN("adding, changing and removing books") {
+      const auto king = Author("S.King", 73, Sex::MALE);
+      const auto author = Author("A very long author name exceeding inline capacity", 40, Sex::FEMALE);
+
+      for (int index = 0; index < 20; index++) {
+        book_store.AddBook(Book("Title #" + to_string(index), string(100 + index, 'c'), Genre::HORROR, Publisher::USA, {king}));
+      }
+
+      book_store.AddBookAuthor(3, author);
+      book_store.AddBookAuthor(3, author);  // дубликат не добавляется
+      book_store.RemoveBook(5);
+      book_store.RemoveBook(7);
+
+      THEN("incremental accounting must match the single pass") {
+        const MemoryBreakdown usage = book_store.MemoryUsage();
+
+        REQUIRE(book_store.GetMemoryUsage() == usage);
+        REQUIRE(usage.slot_bytes == 18 * sizeof(Book));
+        REQUIRE(usage.slot_slack_bytes == (book_store.GetCapacity() - 18) * sizeof(Book));
+        REQUIRE(usage.string_heap_bytes > 18 * 100);
+        REQUIRE(usage.author_vector_bytes == 0);  // списки авторов умещаются в книгах
+        REQUIRE(usage.string_inline_bytes > 0);
+      }
+
+      AND_WHEN("compacting the storage") {
+        book_store.Compact();
+
+        THEN("incremental accounting must still match the single pass") {
+          REQUIRE(book_store.GetMemoryUsage() == book_store.MemoryUsage());
+          REQUIRE(book_store.MemoryUsage().slot_bytes == 18 * sizeof(Book));
+        }
+      }
+    }
+  }
+}
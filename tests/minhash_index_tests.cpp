@@ -0,0 +1,183 @@
+#include <catch2/catch.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "book_store.hpp"
+#include "minhash_index.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+namespace {
+
+// текст из num_words различных слов (topic разводит тексты разных тем)
+string make_text(int topic, int num_words) {
+  string text;
+  for (int word = 0; word < num_words; word++) {
+    text += "topic" + to_string(topic) + "word" + to_string(word) + ' ';
+  }
+  return text;
+}
+
+// замена одного слова текста (опечатка)
+string with_typo(string text, const string &word) {
+  return text.replace(text.find(word), word.size(), word + "x");
+}
+
+}  // namespace
+
+SCENARIO("estimate text similarity with minhash signatures") {
+
+  GIVEN("invalid signature parameters") {
+
+    THEN("the index must not be created") {
+      REQUIRE_THROWS_AS(MinHashIndex(0, 4, 3), invalid_argument);
+      REQUIRE_THROWS_AS(MinHashIndex(16, 0, 3), invalid_argument);
+      REQUIRE_THROWS_AS(MinHashIndex(16, 4, 0), invalid_argument);
+    }
+  }
+
+  AND_GIVEN("an index of texts") {
+    auto index = MinHashIndex();
+
+    const string text = make_text(0, 200);
+
+    index.Insert(text, 0);
+    index.Insert(with_typo(with_typo(text, "topic0word10 "), "topic0word150 "), 1);
+    index.Insert("  Topic0word0 " + text.substr(12), 2);  // другое оформление и регистр
+    index.Insert(make_text(1, 200), 3);
+    index.Insert(make_text(2, 200), 4);
+    index.Insert(" \n ", 5);  // текст без слов не индексируется
+
+    THEN("near-identical texts must have a high similarity") {
+      REQUIRE(index.EstimateSimilarity(0, 1) > 0.8);
+      REQUIRE(index.EstimateSimilarity(0, 2) == 1.0);
+    }
+
+    AND_THEN("unrelated texts must have a low similarity") {
+      REQUIRE(index.EstimateSimilarity(0, 3) < 0.1);
+      REQUIRE(index.EstimateSimilarity(3, 4) < 0.1);
+      REQUIRE(index.EstimateSimilarity(0, 5) == 0.0);
+    }
+
+    AND_THEN("near-identical texts must form one cluster") {
+      REQUIRE(index.GetSize() == 5);
+      REQUIRE_FALSE(index.Contains(5));
+      REQUIRE(index.FindClusters(0.8) == vector<vector<int>>{{0, 1, 2}});
+      REQUIRE(index.FindClusters(1.0) == vector<vector<int>>{{0, 2}});
+    }
+
+    AND_THEN("filtered texts must be excluded from clusters") {
+      REQUIRE(index.FindClusters(0.8, [](int id) { return id != 0; }) == vector<vector<int>>{{1, 2}});
+    }
+
+    WHEN("copying signatures into another index") {
+      auto copy = MinHashIndex();
+      copy.InsertFrom(index, 2, 10);
+      copy.InsertFrom(index, 0, 20);
+
+      THEN("similarities must be preserved") {
+        REQUIRE(copy.EstimateSimilarity(10, 20) == 1.0);
+        REQUIRE(copy.FindClusters(0.9) == vector<vector<int>>{{10, 20}});
+        REQUIRE_THROWS_AS(copy.InsertFrom(index, 1, 10), invalid_argument);
+      }
+    }
+  }
+
+  AND_GIVEN("default banding parameters") {
+    const auto index = MinHashIndex();
+
+    THEN("the candidate threshold must be around one half") {
+      REQUIRE(index.GetNumHashes() == MinHashIndex::kDefaultBands * MinHashIndex::kDefaultRowsPerBand);
+      REQUIRE(index.GetThreshold() == Catch::Detail::Approx(0.5));
+    }
+  }
+}
+
+SCENARIO("find near-duplicate books in the bookstore") {
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const string content = make_text(0, 300);
+
+  const vector<Book> books = {
+      Book("It", content, Genre::HORROR, Publisher::USA, {king}),
+      Book("Other", make_text(1, 300), Genre::HORROR, Publisher::USA, {king}),
+      Book("It (2nd edition)", "Preface. " + content, Genre::HORROR, Publisher::ENG, {king}),
+      Book("It (fixed)", with_typo(content, "topic0word42 "), Genre::HORROR, Publisher::USA, {king})};
+
+  GIVEN("a bookstore with near-identical books") {
+    auto book_store = BookStore("Duplicated Books");
+    book_store.EnableNearDuplicates();
+
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+
+    THEN("they must be found as one cluster") {
+      REQUIRE(book_store.FindNearDuplicates(0.8) == vector<vector<int>>{{0, 2, 3}});
+      REQUIRE(book_store.EstimateContentSimilarity(0, 3) > 0.8);
+      REQUIRE(book_store.EstimateContentSimilarity(0, 1) < 0.1);
+      REQUIRE_THROWS_AS(book_store.EstimateContentSimilarity(0, 4), invalid_argument);
+    }
+
+    WHEN("removing a book and compacting the storage") {
+      book_store.RemoveBook(0);
+      book_store.RemoveBook(1);
+
+      THEN("removed books must be excluded") {
+        REQUIRE(book_store.FindNearDuplicates(0.8) == vector<vector<int>>{{2, 3}});
+      }
+
+      AND_WHEN("compacting the storage") {
+        book_store.Compact();
+        book_store.AddBook(Book("It (3rd edition)", content + " Afterword.", Genre::HORROR, Publisher::USA, {king}));
+
+        THEN("clusters must refer to new positions") {
+          REQUIRE(book_store.FindNearDuplicates(0.8) == vector<vector<int>>{{0, 1, 2}});
+          REQUIRE(book_store.EstimateContentSimilarity(0, 2) > 0.8);
+        }
+      }
+    }
+  }
+
+  AND_GIVEN("a bookstore without near-duplicate detection") {
+    auto book_store = BookStore("Duplicated Books");
+
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+
+    THEN("near-duplicate queries must be rejected") {
+      REQUIRE_FALSE(book_store.IsNearDuplicatesEnabled());
+      REQUIRE_THROWS_AS(book_store.FindNearDuplicates(0.8), logic_error);
+      REQUIRE_THROWS_AS(book_store.EstimateContentSimilarity(0, 3), logic_error);
+    }
+
+    WHEN("enabling detection after the books were added") {
+      book_store.EnableNearDuplicates();
+      book_store.EnableNearDuplicates();
+
+      THEN("existing books must be signed") {
+        REQUIRE(book_store.IsNearDuplicatesEnabled());
+        REQUIRE(book_store.FindNearDuplicates(0.8) == vector<vector<int>>{{0, 2, 3}});
+      }
+    }
+
+    AND_WHEN("enabling detection while secondary indexes are rebuilt") {
+      book_store.RemoveBook(1);
+
+      // книги до курсора перестроения уже перенесены в новые индексы без подписей
+      while (book_store.GetCompactionPhase() != CompactionPhase::REINDEXING) {
+        book_store.CompactStep(1);
+      }
+      book_store.CompactStep(2);
+      book_store.EnableNearDuplicates();
+      book_store.Compact();
+
+      THEN("signatures must survive the end of compaction") {
+        REQUIRE(book_store.FindNearDuplicates(0.8) == vector<vector<int>>{{0, 1, 2}});
+      }
+    }
+  }
+}
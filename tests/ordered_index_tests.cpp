@@ -0,0 +1,127 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "book_store.hpp"
+#include "ordered_index.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("scan ordered index entries") {
+
+  GIVEN("an index with entries inserted in random order") {
+    auto index = OrderedIndex<int>();
+
+    const int num_entries = GENERATE(1, 63, 64, 65, 1000);
+    CAPTURE(num_entries);
+
+    for (int position = 0; position < num_entries; position++) {
+      // ключи вставляются вперемешку и с повторами
+      index.Insert((position * 7919) % 101, position);
+    }
+
+    WHEN("scanning the whole index") {
+      vector<int> keys;
+      index.Scan(0, [&](int key, int) {
+        keys.push_back(key);
+        return true;
+      });
+
+      THEN("all entries must be visited in ascending key order") {
+        REQUIRE(index.GetSize() == num_entries);
+        REQUIRE(static_cast<int>(keys.size()) == num_entries);
+        REQUIRE(is_sorted(keys.begin(), keys.end()));
+      }
+    }
+
+    AND_WHEN("visiting a key range") {
+      vector<int> positions;
+      index.ForEachInRange(10, 20, [&](int key, int position) {
+        REQUIRE(key >= 10);
+        REQUIRE(key < 20);
+        positions.push_back(position);
+      });
+
+      THEN("exactly the entries within the range must be visited") {
+        int expected = 0;
+        for (int position = 0; position < num_entries; position++) {
+          const int key = (position * 7919) % 101;
+          if (key >= 10 && key < 20) expected += 1;
+        }
+        REQUIRE(static_cast<int>(positions.size()) == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("range queries over the bookstore") {
+  auto book_store = BookStore("Ranged Books");
+
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+  const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  const vector<string> titles = {"Misery", "Hobbit", "Harry Potter", "It", "Harry Potter 2", "Silmarillion"};
+  const vector<vector<Author>> authors = {{king}, {tolkien}, {rowling}, {king}, {rowling, king}, {tolkien}};
+
+  // хранилище должно увеличиться в размере, позиции книг при этом не меняются
+  for (int round = 0; round < 3; round++) {
+    for (size_t index = 0; index < titles.size(); index++) {
+      book_store.AddBook(Book(titles[index], "Content", Genre::FANTASY, Publisher::ENG, authors[index]));
+    }
+  }
+
+  GIVEN("a bookstore with books") {
+
+    WHEN("searching books by title range") {
+      const vector<int> positions = book_store.FindBooksByTitleRange("Harry", "I");
+
+      THEN("books must be returned in lexicographic order") {
+        REQUIRE(positions.size() == 9);
+
+        for (size_t index = 1; index < positions.size(); index++) {
+          const Book &prev = book_store.GetBooks()[positions[index - 1]];
+          const Book &curr = book_store.GetBooks()[positions[index]];
+          REQUIRE(prev.GetTitle() <= curr.GetTitle());
+        }
+
+        REQUIRE_THAT(book_store.GetBooks()[positions.front()].GetTitle(), Equals("Harry Potter"));
+        REQUIRE_THAT(book_store.GetBooks()[positions.back()].GetTitle(), Equals("Hobbit"));
+      }
+    }
+
+    AND_WHEN("paging books by title prefix") {
+      const vector<int> first_page = book_store.FindBooksByTitlePrefix("Harry Potter", 0, 4);
+      const vector<int> second_page = book_store.FindBooksByTitlePrefix("Harry Potter", 4, 4);
+
+      THEN("pages must not overlap and cover all matching books") {
+        REQUIRE(first_page.size() == 4);
+        REQUIRE(second_page.size() == 2);
+
+        for (int position: second_page) {
+          REQUIRE(find(first_page.begin(), first_page.end(), position) == first_page.end());
+          REQUIRE_THAT(book_store.GetBooks()[position].GetTitle(), StartsWith("Harry Potter"));
+        }
+      }
+    }
+
+    AND_WHEN("searching books by author age range") {
+      const vector<int> positions = book_store.FindBooksByAuthorAge(50, 75);
+
+      THEN("each book must be returned once") {
+        // Misery, Harry Potter, It, Harry Potter 2 - в трех экземплярах
+        REQUIRE(positions.size() == 12);
+        REQUIRE(is_sorted(positions.begin(), positions.end()));
+        REQUIRE(adjacent_find(positions.begin(), positions.end()) == positions.end());
+      }
+
+      AND_THEN("an empty age range must return nothing") {
+        REQUIRE(book_store.FindBooksByAuthorAge(75, 50).empty());
+        REQUIRE(book_store.FindBooksByAuthorAge(100, 200).empty());
+      }
+    }
+  }
+}
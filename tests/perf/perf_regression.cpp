@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "author.hpp"
+#include "book.hpp"
+#include "book_store.hpp"
+#include "../utility/dataset_loader.hpp"
+
+// Тест производительности с контролем регрессий:
+//   perf_regression --baseline <path> [--update] [--runs N] [--books N] [--seed N]
+//
+// Набор данных строится из образцов tests/samples с фиксированной затравкой, поэтому каждый запуск
+// измеряет одни и те же книги. Каждый сценарий выполняется --runs раз (плюс один прогрев),
+// медиана и 90-й перцентиль времени сравниваются с эталоном. Превышение допуска - код возврата 1.
+// С флагом --update эталон перезаписывается текущими замерами (после оптимизации или смены машины).
+//
+// Формат эталона: строки "<сценарий> <медиана, мс> <p90, мс>" и строка допусков
+// "tolerance <медиана, доля> <p90, доля> <абсолютный запас, мс>". Строки с '#' - комментарии.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kDefaultRuns = 15;
+constexpr int kDefaultBooks = 20'000;
+constexpr unsigned kDefaultSeed = 20210301;
+
+// допуски по умолчанию (если в эталоне нет строки tolerance)
+constexpr double kMedianTolerance = 0.25;
+constexpr double kPercentileTolerance = 0.5;
+constexpr double kAbsoluteSlackMs = 0.05;
+
+constexpr double kPercentile = 0.9;
+
+// параметры запуска
+struct Options {
+  std::string baseline_path;
+  bool is_update{false};
+  int num_runs{kDefaultRuns};
+  int num_books{kDefaultBooks};
+  unsigned seed{kDefaultSeed};
+};
+
+// воспроизводимый набор данных
+struct Dataset {
+  std::vector<Book> books;
+  std::vector<Author> authors;  // пул авторов (имена уникальны)
+  std::vector<std::string> title_prefixes;
+};
+
+// сценарий: подготовка выполняется внутри, возвращается время только измеряемой части
+struct Scenario {
+  std::string name;
+  std::function<double()> run;
+};
+
+// итог сценария
+struct Measurement {
+  double median_ms{0.0};
+  double percentile_ms{0.0};
+};
+
+// эталонные замеры и допуски
+struct Baseline {
+  double median_tolerance{kMedianTolerance};
+  double percentile_tolerance{kPercentileTolerance};
+  double absolute_slack_ms{kAbsoluteSlackMs};
+  std::map<std::string, Measurement> measurements;
+};
+
+template <typename Func>
+double measure_ms(Func &&func) {
+  const auto start = Clock::now();
+  func();
+  const auto finish = Clock::now();
+  return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+// перцентиль по ближайшему рангу (samples отсортированы)
+double percentile(const std::vector<double> &samples, double rank) {
+  const auto position = static_cast<std::size_t>(std::ceil(rank * static_cast<double>(samples.size())));
+  return samples[std::max<std::size_t>(position, 1) - 1];
+}
+
+Dataset make_dataset(int num_books, unsigned seed) {
+  using namespace test::utils;
+
+  constexpr int kAllSamples = 1'000;  // больше, чем строк в файлах образцов (загрузчик резервирует память под это число)
+  constexpr int kNumAuthorVariants = 500;
+
+  const std::vector<std::string> titles = load_token_samples("book_titles.txt", kAllSamples, '\n', seed);
+  const std::vector<std::string> contents = load_book_contents({"1.txt", "2.txt", "3.txt"}, kAllSamples, seed + 1);
+  const std::vector<Author> authors = load_author_samples("authors.txt", kAllSamples, seed + 2);
+
+  if (titles.empty() || contents.empty() || authors.empty()) {
+    throw std::runtime_error("perf_regression: dataset samples are not found in " + std::string{kDatasetDir});
+  }
+
+  Dataset dataset;
+
+  // образцов мало - имена авторов и названия размножаются номерами
+  for (int variant = 0; variant < kNumAuthorVariants; variant++) {
+    auto author = authors[variant % authors.size()];
+    author.SetFullName(author.GetFullName() + "_" + std::to_string(variant));
+    dataset.authors.push_back(std::move(author));
+  }
+
+  // std::mt19937 выдает одну и ту же последовательность на любой платформе
+  auto engine = std::mt19937{seed};
+
+  dataset.books.reserve(num_books);
+
+  for (int index = 0; index < num_books; index++) {
+    const std::string &title = titles[engine() % titles.size()];
+    const std::string &content = contents[engine() % contents.size()];
+    const auto genre = static_cast<Genre>(engine() % static_cast<unsigned>(Genre::UNDEFINED));
+    const auto publisher = static_cast<Publisher>(engine() % static_cast<unsigned>(Publisher::UNDEFINED));
+
+    std::vector<Author> book_authors = {dataset.authors[engine() % dataset.authors.size()]};
+
+    if (engine() % 4 == 0) {
+      book_authors.push_back(dataset.authors[engine() % dataset.authors.size()]);
+    }
+
+    dataset.books.emplace_back(title + " #" + std::to_string(index), content, genre, publisher, book_authors);
+  }
+
+  for (const auto &title: titles) {
+    dataset.title_prefixes.push_back(title.substr(0, std::min<std::size_t>(title.size(), 4)));
+  }
+
+  return dataset;
+}
+
+void fill_book_store(BookStore &book_store, const Dataset &dataset) {
+  book_store.Reserve(static_cast<int>(dataset.books.size()));
+
+  for (const auto &book: dataset.books) {
+    book_store.AddBook(book);
+  }
+}
+
+std::vector<Scenario> make_scenarios(const Dataset &dataset, const BookStore &book_store) {
+  const auto &books = dataset.books;
+  const auto &authors = dataset.authors;
+
+  // результаты накапливаются в переменную, чтобы компилятор не выбросил измеряемый код
+  static volatile long long sink = 0;
+
+  return {
+      {"author_try_create", [&] {
+        return measure_ms([&] {
+          long long num_created = 0;
+          for (std::size_t index = 0; index < books.size(); index++) {
+            const auto &author = authors[index % authors.size()];
+            num_created += Author::TryCreate(author.GetFullName(), author.GetAge(), author.GetSex()).IsOk() ? 1 : 0;
+          }
+          sink = sink + num_created;
+        });
+      }},
+      {"book_try_create", [&] {
+        return measure_ms([&] {
+          long long num_created = 0;
+          for (const auto &book: books) {
+            const std::vector<Author> book_authors(book.GetAuthors().begin(), book.GetAuthors().end());
+            num_created += Book::TryCreate(book.GetTitle(), book.GetContent(), book.GetGenre(), book.GetPublisher(),
+                                           book_authors).IsOk() ? 1 : 0;
+          }
+          sink = sink + num_created;
+        });
+      }},
+      {"book_add_author", [&] {
+        return measure_ms([&] {
+          long long num_added = 0;
+          for (std::size_t index = 0; index < books.size(); index += authors.size() / 8) {
+            auto book = Book();
+            for (std::size_t author = 0; author < 8; author++) {
+              num_added += book.AddAuthor(authors[(index + author) % authors.size()]) ? 1 : 0;
+            }
+          }
+          sink = sink + num_added;
+        });
+      }},
+      {"store_add_book", [&] {
+        // резерв исключает из замера копирования при геометрическом росте хранилища: замеряется только добавление
+        auto store = BookStore("Perf");
+        store.Reserve(static_cast<int>(books.size()));
+
+        const double time_ms = measure_ms([&] {
+          for (const auto &book: books) {
+            store.AddBook(book);
+          }
+        });
+        sink = sink + store.GetSize();
+        return time_ms;
+      }},
+      {"store_find_by_title_prefix", [&] {
+        return measure_ms([&] {
+          long long num_found = 0;
+          for (std::size_t query = 0; query < books.size(); query++) {
+            const auto &prefix = dataset.title_prefixes[query % dataset.title_prefixes.size()];
+            num_found += static_cast<long long>(book_store.FindBooksByTitlePrefix(prefix, 0, 10).size());
+          }
+          sink = sink + num_found;
+        });
+      }},
+      {"store_find_by_author", [&] {
+        return measure_ms([&] {
+          long long num_found = 0;
+          for (std::size_t query = 0; query < books.size(); query++) {
+            num_found += static_cast<long long>(
+                book_store.FindBooksByAuthor(authors[query % authors.size()].GetFullName()).size());
+          }
+          sink = sink + num_found;
+        });
+      }},
+      {"store_remove_compact", [&] {
+        auto store = BookStore("Perf");
+        fill_book_store(store, dataset);
+        const double time_ms = measure_ms([&] {
+          store.RemoveIf([](const Book &book) { return book.GetTitle().back() % 2 == 1; });
+          store.Compact();
+        });
+        sink = sink + store.GetSize();
+        return time_ms;
+      }},
+  };
+}
+
+Measurement run_scenario(const Scenario &scenario, int num_runs) {
+  scenario.run();  // прогрев (кэши, аллокатор)
+
+  std::vector<double> samples;
+  samples.reserve(num_runs);
+
+  for (int run = 0; run < num_runs; run++) {
+    samples.push_back(scenario.run());
+  }
+
+  std::sort(samples.begin(), samples.end());
+  return {percentile(samples, 0.5), percentile(samples, kPercentile)};
+}
+
+bool read_baseline(const std::string &path, Baseline &baseline) {
+  auto fs = std::ifstream(path);
+
+  if (!fs) {
+    return false;
+  }
+
+  for (std::string line; std::getline(fs, line); /* ... */) {
+    if (line.empty() || line.front() == '#') continue;
+
+    std::stringstream ss(line);
+    std::string name;
+    ss >> name;
+
+    if (name == "tolerance") {
+      ss >> baseline.median_tolerance >> baseline.percentile_tolerance >> baseline.absolute_slack_ms;
+    } else {
+      Measurement measurement;
+      ss >> measurement.median_ms >> measurement.percentile_ms;
+      baseline.measurements[name] = measurement;
+    }
+
+    if (!ss) {
+      std::cerr << "perf_regression: malformed baseline line: " << line << std::endl;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool write_baseline(const std::string &path, const Baseline &baseline, const Options &options) {
+  auto fs = std::ofstream(path);
+
+  fs << "# perf_regression baseline (" << options.num_books << " books, " << options.num_runs
+     << " runs, seed " << options.seed << ")\n";
+  fs << "# tolerance <median, fraction> <p90, fraction> <absolute slack, ms>\n";
+  fs << "tolerance " << baseline.median_tolerance << ' ' << baseline.percentile_tolerance << ' '
+     << baseline.absolute_slack_ms << '\n';
+  fs << "# <scenario> <median, ms> <p90, ms>\n";
+
+  for (const auto &[name, measurement]: baseline.measurements) {
+    fs << name << ' ' << measurement.median_ms << ' ' << measurement.percentile_ms << '\n';
+  }
+
+  return static_cast<bool>(fs);
+}
+
+bool is_regression(double value, double reference, double tolerance, double slack_ms) {
+  return value > reference * (1.0 + tolerance) + slack_ms;
+}
+
+bool parse_options(int argc, char **argv, Options &options) {
+  for (int index = 1; index < argc; index++) {
+    const std::string arg = argv[index];
+    const bool has_value = index + 1 < argc;
+
+    if (arg == "--baseline" && has_value) {
+      options.baseline_path = argv[++index];
+    } else if (arg == "--update") {
+      options.is_update = true;
+    } else if (arg == "--runs" && has_value) {
+      options.num_runs = std::max(std::atoi(argv[++index]), 1);
+    } else if (arg == "--books" && has_value) {
+      options.num_books = std::max(std::atoi(argv[++index]), 1);
+    } else if (arg == "--seed" && has_value) {
+      options.seed = static_cast<unsigned>(std::strtoul(argv[++index], nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+
+  return !options.baseline_path.empty();
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  Options options;
+
+  if (!parse_options(argc, argv, options)) {
+    std::cerr << "usage: perf_regression --baseline <path> [--update] [--runs N] [--books N] [--seed N]" << std::endl;
+    return 2;
+  }
+
+  const Dataset dataset = make_dataset(options.num_books, options.seed);
+
+  // одна и та же затравка обязана давать один и тот же набор данных, иначе замеры несравнимы
+  if (make_dataset(options.num_books, options.seed).books != dataset.books) {
+    std::cerr << "perf_regression: seeded dataset is not reproducible" << std::endl;
+    return 2;
+  }
+
+  Baseline baseline;
+  const bool has_baseline = read_baseline(options.baseline_path, baseline);
+
+  if (!has_baseline && !options.is_update) {
+    std::cerr << "perf_regression: cannot read baseline " << options.baseline_path << std::endl;
+    return 2;
+  }
+
+  auto book_store = BookStore("Perf");
+  fill_book_store(book_store, dataset);
+
+  Baseline current = baseline;
+  int num_regressions = 0;
+
+  std::cout << std::fixed << std::setprecision(3);
+
+  for (const auto &scenario: make_scenarios(dataset, book_store)) {
+    const Measurement measurement = run_scenario(scenario, options.num_runs);
+    current.measurements[scenario.name] = measurement;
+
+    std::cout << std::left << std::setw(28) << scenario.name << " median " << measurement.median_ms
+              << " ms, p90 " << measurement.percentile_ms << " ms";
+
+    const auto it = baseline.measurements.find(scenario.name);
+
+    if (it == baseline.measurements.end()) {
+      std::cout << " (no baseline)" << std::endl;
+      continue;
+    }
+
+    const Measurement &reference = it->second;
+
+    const bool is_slower = is_regression(measurement.median_ms, reference.median_ms,
+                                         baseline.median_tolerance, baseline.absolute_slack_ms) ||
+        is_regression(measurement.percentile_ms, reference.percentile_ms,
+                      baseline.percentile_tolerance, baseline.absolute_slack_ms);
+
+    std::cout << " (baseline " << reference.median_ms << " / " << reference.percentile_ms << " ms)"
+              << (is_slower ? " REGRESSION" : "") << std::endl;
+
+    num_regressions += is_slower ? 1 : 0;
+  }
+
+  if (options.is_update) {
+    if (!write_baseline(options.baseline_path, current, options)) {
+      std::cerr << "perf_regression: cannot write baseline " << options.baseline_path << std::endl;
+      return 2;
+    }
+    std::cout << "baseline updated: " << options.baseline_path << std::endl;
+    return 0;
+  }
+
+  return num_regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "book_query.hpp"
+#include "book_store.hpp"
+#include "query_cache.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("normalize query keys") {
+  auto book_store = BookStore("Keyed Books");
+
+  GIVEN("equivalent queries built in a different order") {
+    const auto lhs = BookQuery(book_store).WhereGenre(Genre::HORROR).WhereAuthor("S.King").WhereTitleContains("It");
+    const auto rhs = BookQuery(book_store).WhereTitleContains("It").WhereAuthor("S.King").WhereGenreIn({Genre::HORROR});
+
+    THEN("their keys must be equal") {
+      REQUIRE_FALSE(lhs.GetKey().empty());
+      REQUIRE(lhs.GetKey() == rhs.GetKey());
+    }
+  }
+
+  AND_GIVEN("queries differing in a value or a limit") {
+    const auto base = BookQuery(book_store).WhereAuthor("S.King");
+
+    THEN("their keys must differ") {
+      REQUIRE(base.GetKey() != BookQuery(book_store).WhereAuthor("S.Kin").GetKey());
+      REQUIRE(base.GetKey() != BookQuery(book_store).WhereAuthor("S.King").Limit(1).GetKey());
+      REQUIRE(base.GetKey() != BookQuery(book_store).WhereTitleContains("S.King").GetKey());
+    }
+  }
+
+  AND_GIVEN("a query with a custom predicate") {
+    const auto query = BookQuery(book_store).Where([](const Book &) { return true; });
+
+    THEN("it must not be cacheable") {
+      REQUIRE(query.GetKey().empty());
+    }
+  }
+}
+
+SCENARIO("cache query results with precise invalidation") {
+  auto book_store = BookStore("Cached Books");
+
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+
+  book_store.AddBook(Book("Misery", "A writer and a fan", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("It", "A clown in the sewers", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Hobbit", "There and back again", Genre::FANTASY, Publisher::ENG, {tolkien}));
+
+  QueryCache &cache = book_store.RegisterAggregate<QueryCache>();
+
+  const auto horror = BookQuery(book_store).WhereGenre(Genre::HORROR).WherePublisher(Publisher::USA);
+  const auto fantasy = BookQuery(book_store).WhereGenre(Genre::FANTASY);
+
+  GIVEN("repeated queries") {
+    REQUIRE_THAT(cache.Indices(horror), Equals(vector<int>{0, 1}));
+    REQUIRE_THAT(cache.Indices(horror), Equals(vector<int>{0, 1}));
+    REQUIRE(cache.Count(fantasy) == 1);
+    REQUIRE(cache.Count(BookQuery(book_store).WherePublisher(Publisher::USA).WhereGenre(Genre::HORROR)) == 2);
+
+    THEN("repeated and equivalent queries must hit the cache") {
+      REQUIRE(cache.GetSize() == 2);
+      REQUIRE(cache.GetStats().num_hits == 2);
+      REQUIRE(cache.GetStats().num_misses == 2);
+      REQUIRE(cache.GetStats().GetHitRate() == 0.5);
+    }
+
+    WHEN("adding a book matching only one cached query") {
+      book_store.AddBook(Book("Carrie", "A prom night", Genre::HORROR, Publisher::USA, {king}));
+
+      THEN("only that query must be invalidated") {
+        REQUIRE(cache.GetSize() == 1);
+        REQUIRE(cache.GetStats().num_invalidations == 1);
+
+        REQUIRE_THAT(cache.Indices(horror), Equals(vector<int>{0, 1, 3}));
+        REQUIRE(cache.Count(fantasy) == 1);
+        REQUIRE(cache.GetStats().num_hits == 3);
+      }
+    }
+
+    AND_WHEN("adding an author to a cached book") {
+      const auto by_tolkien = BookQuery(book_store).WhereAuthor("J.Tolkien");
+      REQUIRE_THAT(cache.Indices(by_tolkien), Equals(vector<int>{2}));
+
+      book_store.AddBookAuthor(0, tolkien);
+
+      THEN("queries matching the updated book must see the change") {
+        REQUIRE_THAT(cache.Indices(by_tolkien), Equals(vector<int>{0, 2}));
+        REQUIRE(cache.Count(fantasy) == 1);
+      }
+    }
+
+    AND_WHEN("removing a book and compacting the storage") {
+      book_store.RemoveBook(0);
+
+      THEN("results must not contain the removed book") {
+        REQUIRE_THAT(cache.Indices(horror), Equals(vector<int>{1}));
+        REQUIRE(cache.Count(fantasy) == 1);
+      }
+
+      AND_WHEN("compacting the storage") {
+        cache.Indices(horror);
+        book_store.Compact();
+
+        THEN("cached positions must be dropped") {
+          REQUIRE(cache.GetSize() == 0);
+          REQUIRE_THAT(cache.Indices(horror), Equals(vector<int>{0}));
+          REQUIRE_THAT(cache.Indices(fantasy), Equals(vector<int>{1}));
+        }
+      }
+    }
+  }
+
+  AND_GIVEN("a query with a custom predicate") {
+    const auto query = BookQuery(book_store).Where([](const Book &book) { return book.GetTitle() == "It"; });
+
+    THEN("it must be evaluated on every call") {
+      REQUIRE_THAT(cache.Indices(query), Equals(vector<int>{1}));
+      REQUIRE_THAT(cache.Indices(query), Equals(vector<int>{1}));
+      REQUIRE(cache.GetSize() == 0);
+      REQUIRE(cache.GetStats().num_misses == 2);
+    }
+  }
+
+  AND_GIVEN("a full cache") {
+    QueryCache &small_cache = book_store.RegisterAggregate<QueryCache>(2);
+
+    small_cache.Count(horror);
+    small_cache.Count(fantasy);
+    small_cache.Count(horror);
+    small_cache.Count(BookQuery(book_store).WhereAuthor("S.King"));
+
+    THEN("the least recently used query must be evicted") {
+      REQUIRE(small_cache.GetSize() == 2);
+      REQUIRE(small_cache.GetStats().num_evictions == 1);
+
+      small_cache.Count(horror);
+      REQUIRE(small_cache.GetStats().num_hits == 2);
+    }
+  }
+}
@@ -0,0 +1,181 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "sharded_book_store.hpp"
+#include "thread_pool.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("run tasks in a thread pool") {
+
+  GIVEN("a thread pool") {
+    auto pool = ThreadPool(3);
+
+    WHEN("submitting tasks") {
+      vector<future<int>> futures;
+      for (int value = 0; value < 100; value++) {
+        futures.push_back(pool.Submit([value] { return value * value; }));
+      }
+
+      THEN("every task result must be available") {
+        for (int value = 0; value < 100; value++) {
+          REQUIRE(futures[value].get() == value * value);
+        }
+      }
+    }
+
+    AND_WHEN("a task throws an exception") {
+      auto future = pool.Submit([]() -> int { throw runtime_error("task failed"); });
+
+      THEN("the exception must be passed through the future") {
+        REQUIRE_THROWS_WITH(future.get(), "task failed");
+      }
+    }
+  }
+}
+
+SCENARIO("add and query books in a sharded bookstore") {
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+
+  GIVEN("invalid constructor arguments") {
+    THEN("an exception must be thrown") {
+      REQUIRE_THROWS(ShardedBookStore("", 4), Contains("ShardedBookStore::name"));
+      REQUIRE_THROWS(ShardedBookStore("Shards", 0), Contains("ShardedBookStore::num_shards"));
+    }
+  }
+
+  AND_GIVEN("books added concurrently from several threads") {
+    const int num_shards = GENERATE(1, 4);
+    auto store = ShardedBookStore("Sharded Books", num_shards);
+
+    const int num_threads = 4;
+    const int num_books_per_thread = 50;
+
+    vector<thread> threads;
+    for (int thread_index = 0; thread_index < num_threads; thread_index++) {
+      threads.emplace_back([&, thread_index] {
+        for (int book = 0; book < num_books_per_thread; book++) {
+          const auto &author = book % 2 == 0 ? king : rowling;
+          const string title = "Title " + to_string(thread_index) + "-" + to_string(book);
+          store.AddBook(Book(title, "Content", Genre::HORROR, Publisher::USA, {author}));
+        }
+      });
+    }
+
+    for (auto &thread: threads) thread.join();
+
+    THEN("all books must be stored and routed by title") {
+      REQUIRE(store.GetSize() == num_threads * num_books_per_thread);
+
+      int num_visited = 0;
+      store.ForEachBook([&](const Book &book, ShardedBookRef ref) {
+        REQUIRE(ref.shard == store.GetShardIndex(book.GetTitle()));
+        num_visited += 1;
+      });
+      REQUIRE(num_visited == store.GetSize());
+    }
+
+    AND_THEN("queries must be fanned out and merged") {
+      const auto king_books = store.FindBooksByAuthor("S.King");
+      REQUIRE(king_books.size() == num_threads * num_books_per_thread / 2);
+
+      for (const auto &ref: king_books) {
+        REQUIRE_THAT(store.GetShard(ref.shard).GetBooks()[ref.index].GetAuthors().front().GetFullName(),
+                     Equals("S.King"));
+      }
+
+      const auto titled = store.FindBooksByTitleRange("Title 1", "Title 2");
+      REQUIRE(titled.size() == num_books_per_thread);
+
+      for (size_t index = 1; index < titled.size(); index++) {
+        const auto &prev = store.GetShard(titled[index - 1].shard).GetBooks()[titled[index - 1].index];
+        const auto &curr = store.GetShard(titled[index].shard).GetBooks()[titled[index].index];
+        REQUIRE(prev.GetTitle() <= curr.GetTitle());
+      }
+    }
+  }
+}
+
+SCENARIO("merge fan-out results deterministically") {
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  GIVEN("shards that finish in reverse order") {
+    const int num_shards = 4;
+    auto store = ShardedBookStore("Sharded Books", num_shards, num_shards);
+
+    WHEN("fanning out a query") {
+      const auto shard_names = store.FanOut([&](const BookStore &shard) {
+        // первый шард завершается последним
+        const int shard_index = shard.GetName().back() - '0';
+        this_thread::sleep_for(chrono::milliseconds(5 * (num_shards - shard_index)));
+        return shard.GetName();
+      });
+
+      THEN("results must be ordered by shard index, not by completion") {
+        REQUIRE(shard_names == vector<string>{"Sharded Books #0", "Sharded Books #1", "Sharded Books #2", "Sharded Books #3"});
+      }
+    }
+  }
+
+  AND_GIVEN("a query that throws on the first shard") {
+    const int num_shards = 4;
+    auto store = ShardedBookStore("Sharded Books", num_shards, num_shards);
+    atomic<int> num_finished{0};
+
+    WHEN("fanning out the query") {
+      const auto fan_out = [&] {
+        store.FanOut([&](const BookStore &shard) {
+          if (shard.GetName().back() == '0') {
+            throw runtime_error("shard failed");
+          }
+          // остальные шарды завершаются позже, чем первый выбрасывает исключение
+          this_thread::sleep_for(chrono::milliseconds(20));
+          num_finished += 1;
+          return 0;
+        });
+      };
+
+      THEN("the exception must be rethrown only after all shard tasks finish") {
+        REQUIRE_THROWS_AS(fan_out(), runtime_error);
+        REQUIRE(num_finished == num_shards - 1);
+      }
+    }
+  }
+
+  AND_GIVEN("two stores filled with the same books") {
+    auto lhs = ShardedBookStore("Sharded Books", 4);
+    auto rhs = ShardedBookStore("Sharded Books", 4);
+
+    for (int book = 0; book < 200; book++) {
+      const auto added = Book("Title " + to_string(book % 50), "Content", Genre::HORROR, Publisher::USA, {king});
+      lhs.AddBook(added);
+      rhs.AddBook(added);
+    }
+
+    THEN("queries must return identical results") {
+      const auto lhs_books = lhs.FindBooksByAuthor("S.King");
+      const auto rhs_books = rhs.FindBooksByAuthor("S.King");
+
+      REQUIRE(lhs_books == rhs_books);
+      REQUIRE(is_sorted(lhs_books.begin(), lhs_books.end(), [](const ShardedBookRef &left, const ShardedBookRef &right) {
+        return left.shard != right.shard ? left.shard < right.shard : left.index < right.index;
+      }));
+
+      REQUIRE(lhs.FindBooksByTitleRange("Title 1", "Title 3") == rhs.FindBooksByTitleRange("Title 1", "Title 3"));
+    }
+
+    AND_THEN("books must be placed by a platform-independent title hash") {
+      REQUIRE(lhs.GetShardIndex("Title 0") == 1);
+      REQUIRE(lhs.GetShardIndex("Title 1") == 2);
+    }
+  }
+}
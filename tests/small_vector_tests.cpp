@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "book.hpp"
+#include "small_vector.hpp"
+
+using namespace std;
+
+SCENARIO("store elements in the small vector") {
+  using Strings = SmallVector<string, 2>;
+
+  GIVEN("a small vector within its inline capacity") {
+    auto strings = Strings();
+    strings.PushBack("first");
+    strings.PushBack("second");
+
+    THEN("elements must be stored inline") {
+      REQUIRE(strings.IsInline());
+      REQUIRE(strings.size() == 2);
+      REQUIRE(strings.GetCapacity() == Strings::kInlineCapacity);
+      REQUIRE(strings.front() == "first");
+      REQUIRE(strings.back() == "second");
+    }
+
+    WHEN("adding an element beyond the inline capacity") {
+      strings.PushBack("third");
+
+      THEN("elements must be moved to the heap in order") {
+        REQUIRE_FALSE(strings.IsInline());
+        REQUIRE(strings.GetCapacity() >= 3);
+        REQUIRE(vector<string>(strings.begin(), strings.end()) == vector<string>{"first", "second", "third"});
+      }
+
+      AND_WHEN("assigning an inline vector to it") {
+        const auto other = Strings(strings.begin(), strings.begin() + 1);
+        strings = other;
+
+        THEN("the vector must become inline") {
+          REQUIRE(strings.IsInline());
+          REQUIRE(strings == other);
+          REQUIRE(strings.size() == 1);
+        }
+      }
+    }
+
+    AND_WHEN("copying and moving the vector") {
+      auto copy = strings;
+      auto moved = std::move(strings);
+
+      THEN("copies must be equal and the moved-from vector must be empty") {
+        REQUIRE(copy == moved);
+        REQUIRE(copy.IsInline());
+        REQUIRE(strings.empty());  // NOLINT(bugprone-use-after-move)
+      }
+    }
+  }
+
+  AND_GIVEN("a small vector created from a long range") {
+    const vector<string> source = {"a", "b", "c", "d", "e"};
+    auto strings = Strings(source.begin(), source.end());
+
+    THEN("elements must be stored on the heap") {
+      REQUIRE_FALSE(strings.IsInline());
+      REQUIRE(vector<string>(strings.begin(), strings.end()) == source);
+    }
+
+    WHEN("clearing the vector") {
+      strings.Clear();
+
+      THEN("the vector must become empty and inline") {
+        REQUIRE(strings.empty());
+        REQUIRE(strings.IsInline());
+      }
+    }
+  }
+}
+
+SCENARIO("keep book authors inline") {
+  const auto king = Author("S.King", 73, Sex::MALE);
+  const auto straub = Author("P.Straub", 79, Sex::MALE);
+
+  GIVEN("a book with a typical number of authors") {
+    auto book = Book("The Talisman", "Content", Genre::FANTASY, Publisher::USA, {king, straub});
+
+    THEN("the author list must be stored inside the book") {
+      REQUIRE(book.GetAuthors().IsInline());
+      REQUIRE(Book(book).GetAuthors().IsInline());
+    }
+
+    WHEN("adding more authors than fit into the book") {
+      for (int index = 0; index < kInlineAuthors; index++) {
+        book.AddAuthor(Author("Author #" + to_string(index), 40, Sex::FEMALE));
+      }
+
+      THEN("the author list must fall back to the heap") {
+        REQUIRE_FALSE(book.GetAuthors().IsInline());
+        REQUIRE(book.GetAuthors().size() == kInlineAuthors + 2);
+        REQUIRE(book.GetAuthors().front() == king);
+
+        MemoryBreakdown usage;
+        book.AccountMemory(usage);
+        REQUIRE(usage.author_vector_bytes == (kInlineAuthors + 2) * sizeof(Author));
+      }
+    }
+  }
+}
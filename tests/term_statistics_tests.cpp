@@ -0,0 +1,105 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "book_store.hpp"
+#include "term_statistics.hpp"
+#include "tokenizer.hpp"
+
+using namespace std;
+
+namespace {
+
+// побайтовое разбиение текста на слова (эталон для проверки)
+vector<string_view> tokenize_bytewise(string_view text) {
+  vector<string_view> tokens;
+  size_t start = 0;
+
+  for (size_t position = 0; position <= text.size(); position++) {
+    if (position < text.size() && is_word_byte(static_cast<unsigned char>(text[position]))) continue;
+
+    if (position > start) {
+      tokens.push_back(text.substr(start, position - start));
+    }
+    start = position + 1;
+  }
+
+  return tokens;
+}
+
+}  // namespace
+
+SCENARIO("tokenize text into words") {
+
+  GIVEN("a short text with punctuation") {
+    const string text = "It's a Dark-and-stormy night, 1984!";
+
+    THEN("words must be split on non-alphanumeric bytes") {
+      const vector<string_view> expected = {"It", "s", "a", "Dark", "and", "stormy", "night", "1984"};
+      REQUIRE(tokenize(text) == expected);
+    }
+  }
+
+  AND_GIVEN("texts crossing SIMD block boundaries") {
+    const int length = GENERATE(0, 1, 15, 16, 17, 31, 32, 33, 100);
+    CAPTURE(length);
+
+    string text;
+    for (int index = 0; index < length; index++) {
+      // слова разной длины, в том числе длиннее блока, и кириллица в UTF-8
+      text += index % 23 == 0 ? "  " : index % 11 == 0 ? "\xD0\x9A" : index % 7 == 0 ? "," : "w";
+    }
+
+    THEN("tokens must match the bytewise tokenizer") {
+      REQUIRE(tokenize(text) == tokenize_bytewise(text));
+    }
+  }
+}
+
+SCENARIO("build term statistics over the bookstore") {
+  auto book_store = BookStore("Worded Books");
+
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  book_store.AddBook(Book("It", "The clown. The CLOWN returns!", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Misery", "A writer and a fan.", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Carrie", "The girl", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Removed", "Unique removed words", Genre::HORROR, Publisher::USA, {king}));
+  book_store.RemoveBook(3);
+
+  GIVEN("statistics built with different numbers of threads") {
+    const int num_threads = GENERATE(1, 2, 3, 8);
+    CAPTURE(num_threads);
+
+    const TermStatistics stats = build_term_statistics(book_store, num_threads);
+
+    THEN("corpus statistics must be case-insensitive and skip removed books") {
+      REQUIRE(stats.num_tokens == 12);
+      REQUIRE(stats.GetVocabularySize() == 8);
+      REQUIRE(stats.FindTerm("removed") == -1);
+
+      const int the = stats.FindTerm("THE");
+      REQUIRE(the == 0);  // идентификаторы в порядке первого вхождения
+      REQUIRE(stats.term_counts[the] == 3);
+      REQUIRE(stats.document_frequencies[the] == 2);
+
+      const vector<TermCount> top = stats.TopTerms(2);
+      REQUIRE(top.size() == 2);
+      REQUIRE(top[0].term == "the");
+      REQUIRE(top[0].count == 3);
+      REQUIRE(top[1].term == "clown");
+    }
+
+    AND_THEN("per-book statistics must list term counts by term id") {
+      REQUIRE(stats.books.size() == 4);
+      REQUIRE(stats.books[0].num_tokens == 5);
+      REQUIRE(stats.books[0].term_counts == vector<pair<int, int>>{{0, 2}, {1, 2}, {2, 1}});
+      REQUIRE(stats.books[1].num_tokens == 5);
+      REQUIRE(stats.books[1].term_counts.size() == 4);
+      REQUIRE(stats.books[3].num_tokens == 0);
+      REQUIRE(stats.books[3].term_counts.empty());
+    }
+  }
+}
@@ -0,0 +1,143 @@
+#include <catch2/catch.hpp>
+
+#include <string>
+#include <vector>
+
+#include "book_store.hpp"
+#include "space_saving.hpp"
+#include "top_k.hpp"
+
+using namespace std;
+using namespace Catch::Matchers;
+
+SCENARIO("select top-k elements of a stream") {
+
+  GIVEN("a stream of integers") {
+    const vector<int> stream = {5, 1, 9, 3, 7, 9, 2, 8};
+
+    WHEN("selecting k largest elements") {
+      auto top = TopK<int>(3);
+      for (int value: stream) top.Push(value);
+
+      THEN("elements must be returned in descending order") {
+        REQUIRE_THAT(top.Extract(), Equals(vector<int>{9, 9, 8}));
+      }
+    }
+
+    AND_WHEN("k exceeds the stream size") {
+      auto top = TopK<int>(100);
+      for (int value: stream) top.Push(value);
+
+      THEN("all elements must be returned") {
+        REQUIRE(top.GetSize() == static_cast<int>(stream.size()));
+        REQUIRE_THAT(top.Extract(), Equals(vector<int>{9, 9, 8, 7, 5, 3, 2, 1}));
+      }
+    }
+
+    AND_WHEN("k is non-positive") {
+      auto top = TopK<int>(0);
+      for (int value: stream) top.Push(value);
+
+      THEN("nothing must be returned") {
+        REQUIRE(top.Extract().empty());
+      }
+    }
+  }
+}
+
+SCENARIO("count heavy hitters using space-saving summary") {
+
+  GIVEN("a skewed stream of keys") {
+    auto summary = SpaceSaving<string>(4);
+
+    // "a" и "b" встречаются чаще N / capacity раз и должны попасть в сводку
+    for (int round = 0; round < 100; round++) {
+      summary.Add("a");
+      if (round % 2 == 0) summary.Add("b");
+      summary.Add("noise #" + to_string(round));
+    }
+
+    THEN("the most frequent keys must be on top") {
+      const auto top = summary.Top(2);
+
+      REQUIRE(top.size() == 2);
+      REQUIRE_THAT(top[0].key, Equals("a"));
+      REQUIRE_THAT(top[1].key, Equals("b"));
+      REQUIRE(top[0].count - top[0].error <= 100);
+      REQUIRE(top[0].count >= 100);
+      REQUIRE(top[1].count >= 50);
+    }
+  }
+}
+
+SCENARIO("top-k queries over the bookstore") {
+  auto book_store = BookStore("Top Books");
+
+  const auto tolkien = Author("J.Tolkien", 81, Sex::MALE);
+  const auto rowling = Author("J.K.Rowling", 55, Sex::FEMALE);
+  const auto king = Author("S.King", 73, Sex::MALE);
+
+  // необязательные статистики подключаются до добавления книг
+  const auto &heavy_hitters = book_store.RegisterAggregate<AuthorHeavyHittersAggregate>();
+  const auto &genre_publisher_pairs = book_store.RegisterAggregate<GenrePublisherAggregate>();
+
+  book_store.AddBook(Book("Misery", "Short", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("It", "A much longer content", Genre::HORROR, Publisher::USA, {king}));
+  book_store.AddBook(Book("Hobbit", "Longer content", Genre::FANTASY, Publisher::ENG, {tolkien}));
+  book_store.AddBook(Book("Carrie", "Medium content", Genre::HORROR, Publisher::USA, {king, rowling}));
+
+  GIVEN("a bookstore with books") {
+
+    THEN("the most prolific authors must be found exactly") {
+      const auto top = book_store.TopAuthorsByBookCount(2);
+
+      REQUIRE(top.size() == 2);
+      REQUIRE_THAT(top[0].full_name, Equals("S.King"));
+      REQUIRE(top[0].count == 3);
+      REQUIRE_THAT(top[1].full_name, Equals("J.K.Rowling"));
+      REQUIRE(top[1].count == 1);
+    }
+
+    AND_THEN("the most prolific authors must be estimated by the summary") {
+      const auto top = heavy_hitters.Top(1);
+
+      REQUIRE(top.size() == 1);
+      REQUIRE_THAT(top[0].full_name, Equals("S.King"));
+      REQUIRE(top[0].count >= 3);
+    }
+
+    AND_THEN("the largest books must be found") {
+      REQUIRE_THAT(book_store.TopBooksByContentSize(2), Equals(vector<int>{1, 2}));
+    }
+
+    AND_THEN("the most common genre-publisher pairs must be found") {
+      const auto top = genre_publisher_pairs.Top(5);
+
+      REQUIRE(top.size() == 2);
+      REQUIRE(top[0].genre == Genre::HORROR);
+      REQUIRE(top[0].publisher == Publisher::USA);
+      REQUIRE(top[0].count == 3);
+      REQUIRE(top[1].genre == Genre::FANTASY);
+      REQUIRE(top[1].publisher == Publisher::ENG);
+      REQUIRE(top[1].count == 1);
+    }
+  }
+
+  AND_GIVEN("books that are edited and removed") {
+    REQUIRE(book_store.AddBookAuthor(2, Author("C.Tolkien", 40, Sex::MALE)));
+    REQUIRE(book_store.RemoveBook(3));
+
+    THEN("the summaries must follow the changes") {
+      const auto authors = heavy_hitters.Top(5);
+
+      REQUIRE(authors.size() == 3);
+      REQUIRE_THAT(authors[0].full_name, Equals("S.King"));
+      REQUIRE(authors[0].count == 2);
+      REQUIRE(authors[1].count == 1);
+      REQUIRE(authors[2].count == 1);
+
+      REQUIRE(genre_publisher_pairs.GetCount(Genre::HORROR, Publisher::USA) == 2);
+      REQUIRE(genre_publisher_pairs.GetCount(Genre::FANTASY, Publisher::ENG) == 1);
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
 #include <fstream>
 #include <iterator>
 #include <cmath>
@@ -14,6 +15,7 @@
 
 #include "author.hpp"
 #include "book.hpp"
+#include "enum_names.hpp"
 
 namespace test::utils {
 
@@ -34,9 +36,11 @@ inline static constexpr auto kDatasetDir = std::string_view{DATASET_DIR};
  * @param path - relative path to the text file
  * @param num_samples - max number of token samples
  * @param delim - tokens delimiter
+ * @param seed - random engine seed (fixed seed gives reproducible samples)
  * @return a vector of sampled text tokens
  */
-inline auto load_token_samples(const Path &path, int num_samples, char delim = '\n') -> std::vector<std::string> {
+inline auto load_token_samples(const Path &path, int num_samples, char delim = '\n',
+                               unsigned seed = std::random_device{}()) -> std::vector<std::string> {
   std::vector<std::string> tokens;
   tokens.reserve(kNumSamplesReserve);
 
@@ -53,7 +57,7 @@ inline auto load_token_samples(const Path &path, int num_samples, char delim = '
   std::vector<std::string> token_samples;
   token_samples.reserve(num_samples);
 
-  auto engine = std::default_random_engine{std::random_device{}()};
+  auto engine = std::default_random_engine{seed};
 
   std::sample(tokens.begin(), tokens.end(), std::back_inserter(token_samples), num_samples, engine);
   std::shuffle(token_samples.begin(), token_samples.end(), engine);
@@ -67,9 +71,11 @@ inline auto load_token_samples(const Path &path, int num_samples, char delim = '
  * then the the amount of data provided will be returned.
  *
  * @param paths - relative paths to the text files
+ * @param seed - random engine seed (fixed seed gives reproducible samples)
  * @return a vector of contents read from files
  */
-inline auto load_book_contents(const Paths &paths, int num_samples) -> std::vector<std::string> {
+inline auto load_book_contents(const Paths &paths, int num_samples,
+                               unsigned seed = std::random_device{}()) -> std::vector<std::string> {
   std::vector<std::string> contents;
   contents.reserve(num_samples);
 
@@ -91,7 +97,7 @@ inline auto load_book_contents(const Paths &paths, int num_samples) -> std::vect
 
   std::sample(std::make_move_iterator(contents.begin()), std::make_move_iterator(contents.end()),
               std::back_inserter(content_samples), num_samples,
-              std::default_random_engine{std::random_device{}()});
+              std::default_random_engine{seed});
 
   return content_samples;
 }
@@ -103,9 +109,11 @@ inline auto load_book_contents(const Paths &paths, int num_samples) -> std::vect
  *
  * @param path - relative path to the file
  * @param num_samples - max number of author samples
+ * @param seed - random engine seed (fixed seed gives reproducible samples)
  * @return a vector of sampled author objects
  */
-inline auto load_author_samples(const Path &path, int num_samples) -> std::vector<Author> {
+inline auto load_author_samples(const Path &path, int num_samples,
+                                unsigned seed = std::random_device{}()) -> std::vector<Author> {
   std::vector<Author> authors;
   authors.reserve(kNumSamplesReserve);
 
@@ -113,22 +121,25 @@ inline auto load_author_samples(const Path &path, int num_samples) -> std::vecto
 
   if (auto fs = std::ifstream(kPrefixPath + path)) {
     int age;
-    int sex_id;
+    std::string sex_name;
     std::string full_name;
 
     for (std::string line; std::getline(fs, line); /* ... */) {
 
       std::stringstream ss(line);
-      ss >> full_name >> age >> sex_id;
+      ss >> full_name >> age >> sex_name;
+
+      auto sex = Sex::UNDEFINED;
+      [[maybe_unused]] const bool is_parsed = parse_enum(sex_name, sex);
 
       assert(!full_name.empty());
       assert(age >= Author::kMinAuthorAge);
-      assert(sex_id >= 0 && sex_id <= static_cast<int>(Sex::UNDEFINED));
+      assert(is_parsed);
 
       auto author = Author();
       author.SetAge(age);
       author.SetFullName(full_name);
-      author.SetSex(static_cast<Sex>(sex_id));
+      author.SetSex(sex);
 
       authors.push_back(author);
     }
@@ -141,22 +152,31 @@ inline auto load_author_samples(const Path &path, int num_samples) -> std::vecto
 
   std::sample(authors.begin(), authors.end(),
               std::back_inserter(author_samples), num_samples,
-              std::default_random_engine{std::random_device{}()});
+              std::default_random_engine{seed});
 
   return author_samples;
 }
 
-inline auto generate_book_samples(int num_samples) -> std::vector<Book> {
+/**
+ * Generates books from the sampled titles, contents and authors.
+ * Every sampling step derives its own seed from the given one,
+ * so the same seed always produces the same books.
+ *
+ * @param num_samples - max number of book samples
+ * @param seed - random engine seed (fixed seed gives reproducible samples)
+ * @return a vector of generated books
+ */
+inline auto generate_book_samples(int num_samples, unsigned seed = std::random_device{}()) -> std::vector<Book> {
   std::vector<Book> book_samples(num_samples);
 
   // pre-load data
-  const std::vector<std::string> contents = load_book_contents({"1.txt", "2.txt", "3.txt"}, num_samples);
-  const std::vector<std::string> titles = load_token_samples("book_titles.txt", num_samples);
+  const std::vector<std::string> contents = load_book_contents({"1.txt", "2.txt", "3.txt"}, num_samples, seed);
+  const std::vector<std::string> titles = load_token_samples("book_titles.txt", num_samples, '\n', seed + 1);
 
   num_samples = std::min(contents.size(), titles.size());
 
   for (int index = 0; index < num_samples; index++) {
-    const std::vector<Author> authors = load_author_samples("authors.txt", 2);
+    const std::vector<Author> authors = load_author_samples("authors.txt", 2, seed + 2 + index);
     book_samples[index].SetContent(contents[index]);
     book_samples[index].SetTitle(titles[index]);
 
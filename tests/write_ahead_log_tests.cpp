@@ -0,0 +1,344 @@
+#include <catch2/catch.hpp>
+
+#include <sys/resource.h>  // setrlimit
+
+#include <chrono>
+#include <csignal>  // signal, SIGXFSZ
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "book_store.hpp"
+#include "utility/dataset_loader.hpp"
+#include "write_ahead_log.hpp"
+
+using namespace std;
+using namespace test::utils;
+
+namespace {
+
+// выбросила ли функция std::runtime_error (проверка вне REQUIRE, пока действует лимит размера файла)
+template <typename Func>
+bool throws_runtime_error(Func &&func) {
+  try {
+    func();
+  } catch (const runtime_error &) {
+    return true;
+  }
+  return false;
+}
+
+}  // namespace
+
+SCENARIO("persist added books in a write-ahead log") {
+  const auto path = (filesystem::temp_directory_path() / "bookstore_wal_tests.log").string();
+  filesystem::remove(path);
+
+  const vector<Book> books = generate_book_samples(3);
+
+  GIVEN("a bookstore with an attached log") {
+    // окно больше времени теста: пакеты подтверждаются только по заполнению
+    auto log = WriteAheadLog();
+    REQUIRE(log.Open(path, 2, chrono::seconds(10)) == WalStatus::SUCCESS);
+
+    auto book_store = BookStore("Durable Books");
+    book_store.AttachLog(&log);
+
+    // книга по умолчанию (с пустыми полями) тоже должна восстанавливаться без изменений
+    book_store.AddBook(Book{});
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+    book_store.AddBook(Book("Joint", "Content", Genre::DRAMA, Publisher::RUS,
+                            {Author("A", 20, Sex::MALE), Author("B", 30, Sex::FEMALE)}));
+
+    WHEN("records are appended") {
+      THEN("they must be committed in batches") {
+        REQUIRE(log.GetNumAppended() == 5);
+        REQUIRE(log.GetNumSyncs() == 2);
+        REQUIRE(log.GetNumPending() == 1);
+      }
+    }
+
+    AND_WHEN("the log is closed and replayed") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      auto restored = BookStore("Durable Books");
+      int num_replayed = 0;
+
+      REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+
+      THEN("the restored bookstore must be equal to the original one") {
+        REQUIRE(num_replayed == 5);
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    AND_WHEN("the last record is torn") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+      filesystem::resize_file(path, filesystem::file_size(path) - 3);
+
+      auto restored = BookStore("Durable Books");
+      int num_replayed = 0;
+
+      THEN("all complete records must be replayed") {
+        REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+        REQUIRE(num_replayed == 4);
+      }
+    }
+
+    AND_WHEN("the log is reopened after a torn write and appended to") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+      const auto committed_size = filesystem::file_size(path);
+      {
+        // начало записи, оборванной сбоем
+        ofstream fs(path, ios::binary | ios::app);
+        fs.write("\x40\x00\x00\x00\x12\x34", 6);
+      }
+
+      REQUIRE(log.Open(path, 1, chrono::milliseconds(0)) == WalStatus::SUCCESS);
+      REQUIRE(filesystem::file_size(path) == committed_size);
+
+      book_store.AddBook(Book("Misery", "Content", Genre::HORROR, Publisher::USA, {Author("S.King", 73, Sex::MALE)}));
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      auto restored = BookStore("Durable Books");
+      int num_replayed = 0;
+
+      THEN("records appended after the restart must be replayed") {
+        REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+        REQUIRE(num_replayed == 6);
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    AND_WHEN("a record is corrupted") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+      {
+        fstream fs(path, ios::in | ios::out | ios::binary);
+        fs.seekp(10);
+        fs.put('\x7F');
+      }
+
+      auto restored = BookStore("Durable Books");
+
+      THEN("replay must report the corruption") {
+        REQUIRE(WriteAheadLog::Replay(path, restored) == WalStatus::CORRUPTED_RECORD);
+      }
+    }
+
+    book_store.AttachLog(nullptr);
+  }
+
+  AND_GIVEN("a bookstore that removes books and edits authors through the log") {
+    auto log = WriteAheadLog();
+    REQUIRE(log.Open(path, 100, chrono::seconds(10)) == WalStatus::SUCCESS);
+
+    auto book_store = BookStore("Durable Books");
+    book_store.AttachLog(&log);
+
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+
+    REQUIRE(book_store.RemoveBook(0));
+    REQUIRE(book_store.AddBookAuthor(2, Author("Co Author", 40, Sex::FEMALE)));
+
+    // дубликат автора отклоняется и не попадает в журнал
+    REQUIRE_FALSE(book_store.AddBookAuthor(2, Author("Co Author", 40, Sex::FEMALE)));
+
+    WHEN("the log is closed and replayed") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      auto restored = BookStore("Durable Books");
+      int num_replayed = 0;
+
+      REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+
+      THEN("the removed book must stay gone and the author must be restored") {
+        REQUIRE(num_replayed == static_cast<int>(books.size()) + 2);
+        REQUIRE(restored.GetSize() == static_cast<int>(books.size()) - 1);
+        REQUIRE(restored.IsRemoved(0));
+        REQUIRE(restored.GetBooks()[2].GetAuthors().size() == books[2].GetAuthors().size() + 1);
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    AND_WHEN("books are removed after compaction") {
+      book_store.Compact();
+
+      // после уплотнения книга с позиции 1 переехала на позицию 0
+      REQUIRE(book_store.RemoveBook(0));
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      auto restored = BookStore("Durable Books");
+
+      THEN("the removal must refer to the same book") {
+        REQUIRE(WriteAheadLog::Replay(path, restored) == WalStatus::SUCCESS);
+        REQUIRE(restored.GetSize() == 1);
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    AND_WHEN("a restored bookstore is attached to the same log") {
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      auto restored = BookStore("Durable Books");
+      REQUIRE(WriteAheadLog::Replay(path, restored) == WalStatus::SUCCESS);
+
+      auto reopened = WriteAheadLog();
+      REQUIRE(reopened.Open(path, 100, chrono::seconds(10)) == WalStatus::SUCCESS);
+      restored.AttachLog(&reopened);
+
+      REQUIRE(restored.RemoveBook(1));
+      REQUIRE(reopened.Close() == WalStatus::SUCCESS);
+      restored.AttachLog(nullptr);
+
+      auto replayed = BookStore("Durable Books");
+
+      THEN("removals of restored books must be journaled too") {
+        REQUIRE(WriteAheadLog::Replay(path, replayed) == WalStatus::SUCCESS);
+        REQUIRE(replayed.GetSize() == 1);
+        REQUIRE(replayed == restored);
+      }
+    }
+
+    book_store.AttachLog(nullptr);
+  }
+
+  AND_GIVEN("a log with a short commit window") {
+    auto log = WriteAheadLog();
+    REQUIRE(log.Open(path, 100, chrono::milliseconds(20)) == WalStatus::SUCCESS);
+
+    WHEN("a single record is appended and no more records follow") {
+      REQUIRE(log.Append(books.front()) == WalStatus::SUCCESS);
+
+      // подтверждение выполняет фоновый поток, а не следующий Append
+      for (int attempt = 0; attempt < 200 && log.GetNumSyncs() == 0; attempt++) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+      }
+
+      THEN("the record must be committed once the window expires") {
+        REQUIRE(log.GetNumSyncs() == 1);
+        REQUIRE(log.GetNumPending() == 0);
+
+        auto restored = BookStore("Durable Books");
+        int num_replayed = 0;
+
+        REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+        REQUIRE(num_replayed == 1);
+      }
+    }
+  }
+
+  AND_GIVEN("a file size limit that interrupts a batch mid-write") {
+    auto log = WriteAheadLog();
+    REQUIRE(log.Open(path, 100, chrono::seconds(10)) == WalStatus::SUCCESS);
+
+    auto book_store = BookStore("Durable Books");
+    book_store.AttachLog(&log);
+
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+
+    // при превышении лимита write записывает часть буфера, а следующий write завершается с EFBIG
+    rlimit limit{};
+    getrlimit(RLIMIT_FSIZE, &limit);
+    const rlimit original = limit;
+    const auto previous_handler = signal(SIGXFSZ, SIG_IGN);
+
+    limit.rlim_cur = 10;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    const WalStatus interrupted = log.Sync();
+    setrlimit(RLIMIT_FSIZE, &original);
+    signal(SIGXFSZ, previous_handler);
+
+    WHEN("the sync is retried after the limit is lifted") {
+      REQUIRE(interrupted == WalStatus::WRITE_FAILED);
+      REQUIRE(filesystem::file_size(path) == 10);
+      REQUIRE(log.Sync() == WalStatus::SUCCESS);
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      THEN("already written bytes must not be duplicated") {
+        auto restored = BookStore("Durable Books");
+        int num_replayed = 0;
+
+        REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+        REQUIRE(num_replayed == static_cast<int>(books.size()));
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    book_store.AttachLog(nullptr);
+  }
+
+  AND_GIVEN("a log that fails to commit a change") {
+    auto log = WriteAheadLog();
+    REQUIRE(log.Open(path, 1, chrono::milliseconds(0)) == WalStatus::SUCCESS);
+
+    auto book_store = BookStore("Durable Books");
+    book_store.AttachLog(&log);
+
+    for (const auto &book: books) {
+      book_store.AddBook(book);
+    }
+
+    // лимит размера файла обрывает запись следующего изменения
+    rlimit limit{};
+    getrlimit(RLIMIT_FSIZE, &limit);
+    const rlimit original = limit;
+    const auto previous_handler = signal(SIGXFSZ, SIG_IGN);
+    const auto committed_size = filesystem::file_size(path);
+
+    // запись книги обрывается на середине, записи удаления и автора не записываются вовсе
+    limit.rlim_cur = committed_size + 10;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    const bool is_add_rejected = throws_runtime_error([&] { book_store.AddBook(books[0]); });
+    limit.rlim_cur = committed_size;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    const bool is_remove_rejected = throws_runtime_error([&] { book_store.RemoveBook(0); });
+    const bool is_author_rejected =
+        throws_runtime_error([&] { book_store.AddBookAuthor(1, Author("Co-Author", 40, Sex::FEMALE)); });
+    setrlimit(RLIMIT_FSIZE, &original);
+    signal(SIGXFSZ, previous_handler);
+
+    WHEN("the log is closed and replayed") {
+      REQUIRE(is_add_rejected);
+      REQUIRE(is_remove_rejected);
+      REQUIRE(is_author_rejected);
+      REQUIRE(filesystem::file_size(path) == committed_size);
+      REQUIRE(book_store.GetSize() == static_cast<int>(books.size()));
+
+      // после снятия лимита изменения снова журналируются
+      book_store.RemoveBook(2);
+      REQUIRE(log.Close() == WalStatus::SUCCESS);
+
+      THEN("rejected changes must not be restored") {
+        auto restored = BookStore("Durable Books");
+        int num_replayed = 0;
+
+        REQUIRE(WriteAheadLog::Replay(path, restored, &num_replayed) == WalStatus::SUCCESS);
+        REQUIRE(num_replayed == static_cast<int>(books.size()) + 1);
+        REQUIRE(restored == book_store);
+      }
+    }
+
+    book_store.AttachLog(nullptr);
+  }
+
+  AND_GIVEN("a closed log") {
+    auto log = WriteAheadLog();
+    auto book_store = BookStore("Volatile Books");
+
+    THEN("appending and replaying must fail") {
+      REQUIRE(log.Append(Book{}) == WalStatus::NOT_OPEN);
+      REQUIRE(WriteAheadLog::Replay(path + ".missing", book_store) == WalStatus::OPEN_FAILED);
+    }
+  }
+
+  filesystem::remove(path);
+}